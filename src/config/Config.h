@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 /**
  * GameConfig: Central configuration for all game parameters
  * This struct holds all tunable values for physics, level generation, and visuals.
@@ -8,24 +10,28 @@
 struct GameConfig
 {
     // ===== Screen & Display =====
-    int screenWidth = 800;          // Initial window width (before fullscreen scaling)
-    int screenHeight = 450;         // Initial window height (used as base for physics scaling)
+    int screenWidth = 800;          // World view width (the window shows it scaled to fit)
+    int screenHeight = 450;         // World view height (the window shows it scaled to fit)
+    int targetFps = 0;              // Render frame cap (0 = uncapped, paced by vsync when enabled)
+    bool vsync = true;              // Sync rendering to the display refresh rate
     
     // ===== Ball/Player Properties =====
     float radius = 20.0f;           // Ball radius in pixels
     float groundY = screenHeight - 80.0f;  // Ground level Y position (bottom boundary)
     
     // ===== Physics =====
-    float gravity = 1000.0f;        // Downward acceleration (pixels/sec²) - scales with screen height
-    float jumpVelocity = -550.0f;   // Initial upward velocity when jumping (negative = up) - scales with screen height
+    float gravity = 1000.0f;        // Downward acceleration (world pixels/sec²)
+    float jumpVelocity = -550.0f;   // Initial upward velocity when jumping (negative = up)
     float maxJumpHold = 0.25f;      // Maximum seconds player can hold jump for extra height
-    float jumpHoldAccel = -1200.0f; // Extra upward acceleration while holding jump - scales with screen height
+    float jumpHoldAccel = -1200.0f; // Extra upward acceleration while holding jump
     
     // ===== Scrolling & Speed =====
     float scrollSpeed = 220.0f;     // Horizontal scroll speed (pixels/sec) - platforms move left at this rate
     
     // ===== Platform Generation =====
-    int totalPlatforms = 200;       // Total number of platforms to score/complete the level
+    int totalPlatforms = 200;       // Total number of platforms to score/complete the level (ignored when endless)
+    bool endless = false;           // Endless mode: platforms never run out and the level can't be completed
+    float generateAhead = 1200.0f;  // Platforms are generated this far past the right screen edge
     float minGap = 260.0f;          // Minimum horizontal gap between platforms (pixels)
     float maxGap = 420.0f;          // Maximum horizontal gap between platforms (pixels)
     float minPlatformWidth = 120.0f;  // Minimum platform width (pixels)
@@ -34,7 +40,16 @@ struct GameConfig
     float minPlatformY = 20.0f;     // Highest Y position platforms can reach (near screen top)
     float stepUpMin = 15.0f;        // Minimum vertical step up between consecutive platforms
     float stepUpMax = 35.0f;        // Maximum vertical step up between consecutive platforms
-    
+    uint64_t seed = 1;              // Level RNG seed - same seed gives the same platforms and clouds
+    bool curveLevels = false;       // Random finite levels follow a difficulty ramp (CurveGenerator) instead of staying flat
+    float curveFrom = 0.5f;         // Ramp difficulty at the first platform (share of random jumps that miss)
+    float curveTo = 0.7f;           // Ramp difficulty at the last platform
+
     // ===== Visual Elements =====
     int cloudCount = 10;            // Number of parallax background clouds
+
+    // ===== Simulation =====
+    float fixedTimestep = 1.0f / 120.0f; // Physics step (seconds) - same for the game and the headless runner
+    float maxFrameTime = 0.25f;          // Longest frame fed to the step accumulator (avoids spiral of death)
+    bool continuousCollision = false;    // Swept landing/collision + exact ball integration: outcomes don't depend on fixedTimestep
 };
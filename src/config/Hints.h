@@ -0,0 +1,27 @@
+#pragma once
+
+/**
+ * Code placement hints for the per-frame loop (GCC / Clang; empty elsewhere)
+ *
+ * - COLD: a function that runs a few times per run at most (restart, run
+ *   end, overlays). It is optimized for size, never inlined into its
+ *   caller and placed in .text.unlikely, so the code that runs every frame
+ *   stays packed together in the instruction cache.
+ * - UNLIKELY(x): a branch that is almost never taken; its body is laid
+ *   out after the hot path instead of in the middle of it
+ * - FORCE_INLINE: a small helper that must be inlined into every caller
+ *   even where -O2's size heuristics say no (the scalar tails of the SIMD
+ *   platform kernels, which run on every call)
+ *
+ * A PGO build (Makefile.simple release-pgo) learns the same from the
+ * training run; the hints give plain -O2 builds the same layout.
+ */
+#if defined(__GNUC__)
+#define COLD __attribute__((cold, noinline))
+#define UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define COLD
+#define UNLIKELY(x) (x)
+#define FORCE_INLINE inline
+#endif
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../sim/Input.h"
+
+class Simulation;
+
+/**
+ * Controller: Whoever plays the game - keyboard, bot, network...
+ *
+ * Game asks its controller for the input of every fixed step, right
+ * before Simulation::step runs, so controllers see exactly the state the
+ * step will advance (bots decide per step, not per rendered frame).
+ *
+ * Contract:
+ * - input() may look ahead by stepping sim, as long as it restores it
+ *   (Simulation::capture / restore) before returning
+ * - beginFrame() runs once per rendered frame before any step (poll
+ *   devices there); reset() runs whenever the run state was replaced
+ *   (new level, checkpoint restore), so cached plans can be dropped
+ */
+class Controller
+{
+public:
+    virtual ~Controller() {}
+
+    /**
+     * beginFrame: Once per rendered frame, before this frame's steps
+     */
+    virtual void beginFrame() {}
+
+    /**
+     * input: The input for sim's next step
+     */
+    virtual FrameInput input(Simulation &sim) = 0;
+
+    /**
+     * reset: The run was restarted or restored - forget any plan
+     */
+    virtual void reset() {}
+
+    /**
+     * name: Short display name ("keyboard", "bot")
+     */
+    virtual const char *name() const = 0;
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Controller.h"
+#include "../sim/Replay.h"
+
+/**
+ * ReplayController: Plays a recorded run's input back through the Game loop
+ *
+ * Every step takes the reader's next input, so a replay renders exactly
+ * as it was played (perfsuite's render pass). reset() rewinds to step 0:
+ * a restart begins the recording again.
+ */
+class ReplayController : public Controller
+{
+public:
+    /**
+     * play: Take the input from reader from now on (nullptr = released)
+     */
+    void play(ReplayReader *next)
+    {
+        reader = next;
+        reset();
+    }
+
+    FrameInput input(Simulation &) override { return reader ? reader->next() : FrameInput(); }
+    void reset() override
+    {
+        if (reader)
+        {
+            reader->rewind();
+        }
+    }
+    const char *name() const override { return "replay"; }
+
+private:
+    ReplayReader *reader = nullptr;
+};
@@ -0,0 +1,609 @@
+#include "SearchBot.h"
+#include "../profile/Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+// Screened values (higher = better; deaths rank by how late they happen)
+static const float kValueWin = 200000.0f;       // Passed the last platform of a finite level
+static const float kValueLanded = 100000.0f;    // Landed on a new platform (+ runway bonus)
+static const float kValueAlive = 50000.0f;      // Still playing at the horizon (+ resting / spare jump bonus)
+static const float kValueDead = -1000000.0f;    // Died (+ steps survived)
+static const float kValueMissed = -1e30f;       // Press already behind (search spread over steps)
+
+/**
+ * landingValue: Value of landing on a new platform with `runway` pixels
+ * left before its right edge (more time to plan the next jump first,
+ * then sooner)
+ */
+static float landingValue(float runway, int step)
+{
+    return kValueLanded + runway * 100.0f - (float)step;
+}
+
+/**
+ * aliveValue: Value of still being in the game at the horizon
+ */
+static float aliveValue(bool grounded, int jumpsRemaining)
+{
+    return kValueAlive + (grounded ? 1000.0f : 0.0f) + 100.0f * (float)jumpsRemaining;
+}
+
+/**
+ * platformUnder: Ring slot of the live platform the ball rests on, or -1
+ * (the one under its world X whose top is nearest the ball's bottom)
+ */
+static int platformUnder(const Level &level, float ballWorldX, float footY)
+{
+    int best = -1;
+    float bestDistance = 4.0f;  // Resting balls sit exactly on the top; allow rounding
+    for (int k = 0; k < level.count; k++)
+    {
+        Platform p = level.platform(k);
+        float distance = std::fabs(p.yTop - footY);
+        if (p.x <= ballWorldX && p.x + p.width >= ballWorldX && distance < bestDistance)
+        {
+            best = level.slot(k);
+            bestDistance = distance;
+        }
+    }
+    return best;
+}
+
+/**
+ * SearchBot constructor: Blank candidates (search() fills them from the
+ * config it is given)
+ */
+SearchBot::SearchBot()
+{
+    for (int i = 0; i < kCandidates; i++)
+    {
+        candidates[i] = {-1, 0, 0.0f};
+    }
+}
+
+/**
+ * reset: Drop the plan and any search under way (the next input() searches)
+ */
+void SearchBot::reset()
+{
+    planned = false;
+    searching = false;
+}
+
+/**
+ * input: Follow the plan, searching for a new one when it runs out
+ * (or when sim isn't at the frame the plan continues from); a search
+ * under way goes on where the previous step's budget ran out
+ */
+FrameInput SearchBot::input(Simulation &sim)
+{
+    int64_t start = Profiler::nowNs();
+    FrameInput in;
+    if (!sim.isFinished())
+    {
+        bool continues = (sim.frame == planFrame + 1);
+        if (!(searching && continues) && (!planned || !continues || sim.frame >= planEnd))
+        {
+            beginSearch(sim);
+        }
+        if (searching)
+        {
+            search(sim, start);
+        }
+        planFrame = sim.frame;
+        in.jumpPressed = (sim.frame == pressFrame);
+        in.jumpHeld = (pressFrame >= 0 && sim.frame >= pressFrame && sim.frame < releaseFrame);
+    }
+
+    lastDecideNs = Profiler::nowNs() - start;
+    maxDecideNs = std::max(maxDecideNs, lastDecideNs);
+    totalDecideNs += lastDecideNs;
+    decisions++;
+    overBudget += (lastDecideNs > kBudgetNs) ? 1 : 0;
+    decideBuckets[std::min((int64_t)kTimeBuckets - 1, lastDecideNs / kBucketNs)]++;
+    return in;
+}
+
+/**
+ * decidePercentileNs: Walk the histogram to the bucket holding the p-th call
+ * (reports the bucket's upper edge)
+ */
+int64_t SearchBot::decidePercentileNs(double p) const
+{
+    long long target = (long long)(p * (double)decisions);
+    long long seen = 0;
+    for (int b = 0; b < kTimeBuckets; b++)
+    {
+        seen += decideBuckets[b];
+        if (seen > target || seen == decisions)
+        {
+            return (int64_t)(b + 1) * kBucketNs;
+        }
+    }
+    return (int64_t)kTimeBuckets * kBucketNs;
+}
+
+/**
+ * beginSearch: Every delay in 0, kDelayStride, ... times hold lengths from
+ * a tap to the full jump hold (one extra step covers rounding), plus
+ * "don't jump"
+ */
+void SearchBot::beginSearch(const Simulation &sim)
+{
+    searches++;
+    const GameConfig &cfg = sim.config;
+    int maxHoldSteps = (int)std::ceil(cfg.maxJumpHold / cfg.fixedTimestep) + 1;
+    int n = 0;
+    for (int d = 0; d < kDelays; d++)
+    {
+        for (int h = 0; h < kHolds; h++)
+        {
+            candidates[n++] = {d * kDelayStride, (h * maxHoldSteps) / (kHolds - 1), 0.0f};
+        }
+    }
+    candidates[n++] = {-1, 0, 0.0f};
+    candidateCount = n;
+
+    searching = true;
+    searchFrame = sim.frame;
+    nextBlock = 0;
+    copiedFrame = -1;
+    verifyCount = 0;
+    nextVerify = 0;
+    bestVerified = -1;
+    planned = false;
+    pressFrame = -1;  // No input until a plan is adopted
+    releaseFrame = -1;
+}
+
+/**
+ * search: Screen, rank, verify, adopt - one unit at a time
+ *
+ * 1. Screen the candidates in blocks of kLanes
+ * 2. Sort the best kVerify to the front and replay them exactly; the
+ *    first that survives wins, else the one that dies last (the screened
+ *    best if sim can't be snapshotted)
+ *
+ * The first unit of a call always runs (the search must progress); each
+ * further one only if the call's time so far plus a full kHorizon unit of
+ * its kind, at the slowest recent time per step, stays within kPlanNs (a
+ * kind not timed yet waits for the next call).
+ */
+void SearchBot::search(Simulation &sim, int64_t startNs)
+{
+    const int elapsed = (int)(sim.frame - searchFrame);
+    if (elapsed == 1)
+    {
+        spreadSearches++;
+    }
+    for (bool first = true; searching; first = false)
+    {
+        bool screening = nextBlock * kLanes < candidateCount;
+        int64_t &stepNs = screening ? blockStepNs : replayStepNs;
+        int64_t unitStart = Profiler::nowNs();
+        if (!first && (stepNs == 0 || unitStart - startNs + stepNs * kHorizon > kPlanNs))
+        {
+            return;  // The rest waits for the next step
+        }
+        int steps = screening ? screenNext(sim, elapsed) : verifyNext(sim, elapsed);
+        if (steps > 0)
+        {
+            int64_t perStep = (Profiler::nowNs() - unitStart) / steps;
+            stepNs = std::max(perStep, stepNs - stepNs / 16);  // Slowest recent unit, decaying
+        }
+    }
+}
+
+/**
+ * shifted: Delays are relative to the search's first step
+ */
+SearchBot::Candidate SearchBot::shifted(Candidate c, int elapsed)
+{
+    c.delay = (c.delay >= 0) ? std::max(0, c.delay - elapsed) : c.delay;
+    return c;
+}
+
+/**
+ * screenNext: Lanes get the block's candidates shifted to this step;
+ * missed ones are screened anyway (branch-free lanes) and ranked last
+ */
+int SearchBot::screenNext(const Simulation &sim, int elapsed)
+{
+    if (copiedFrame != sim.frame)
+    {
+        copyPlatforms(sim);
+        copiedFrame = sim.frame;
+    }
+
+    int first = nextBlock * kLanes;
+    int n = std::min((int)kLanes, candidateCount - first);
+    Candidate lanes[kLanes];
+    for (int l = 0; l < n; l++)
+    {
+        lanes[l] = shifted(candidates[first + l], elapsed);
+    }
+    int steps = screen(sim, lanes, n);
+    for (int l = 0; l < n; l++)
+    {
+        Candidate &c = candidates[first + l];
+        c.value = missed(c, elapsed) ? kValueMissed : lanes[l].value;
+    }
+    nextBlock++;
+
+    if (nextBlock * kLanes >= candidateCount)
+    {
+        verifyCount = std::min((int)kVerify, candidateCount);
+        std::partial_sort(candidates, candidates + verifyCount, candidates + candidateCount,
+                          [](const Candidate &a, const Candidate &b) { return a.value > b.value; });
+    }
+    return steps;
+}
+
+/**
+ * verifyNext: One exact replay from a snapshot of this step
+ * - Candidates are in screened order, so the first survivor is as good as
+ *   it gets and is adopted at once
+ */
+int SearchBot::verifyNext(Simulation &sim, int elapsed)
+{
+    while (nextVerify < verifyCount && missed(candidates[nextVerify], elapsed))
+    {
+        nextVerify++;
+    }
+    if (nextVerify < verifyCount && sim.capture(snapshot))
+    {
+        int i = nextVerify++;
+        Candidate exact = shifted(candidates[i], elapsed);
+        int steps = verify(sim, exact);
+        bool survived = exact.value >= 0.0f;
+        replays++;
+        if (i == 0 && !survived && candidates[0].value >= 0.0f)
+        {
+            verifyFailures++;
+        }
+        if (survived)
+        {
+            adopt(sim, exact);
+            return steps;
+        }
+        if (bestVerified < 0 || exact.value > bestExact)
+        {
+            bestVerified = i;
+            bestExact = exact.value;
+        }
+        if (nextVerify < verifyCount)
+        {
+            return steps;
+        }
+    }
+    adopt(sim, shifted(candidates[bestVerified >= 0 ? bestVerified : 0], elapsed));
+    return 0;
+}
+
+/**
+ * copyPlatforms: Every unpassed live platform (passed ones are behind the
+ * ball and can't be landed on or hit), and the step the level is won at
+ */
+void SearchBot::copyPlatforms(const Simulation &sim)
+{
+    const GameConfig &cfg = sim.config;
+    const Level &level = sim.level;
+    const float ballX = level.worldX(sim.player.x);
+    const float travel = cfg.scrollSpeed * cfg.fixedTimestep * (float)kHorizon;
+
+    // Only platforms the ball can reach before the horizon (in X, ball included)
+    platformCount = 0;
+    for (int k = level.scoreCursor; k < level.count && platformCount < kMaxPlatforms; k++)
+    {
+        Platform p = level.platform(k);
+        if (p.x > ballX + travel + cfg.radius)
+        {
+            break;
+        }
+        platX[platformCount] = p.x;
+        platY[platformCount] = p.yTop;
+        platW[platformCount] = p.width;
+        platformCount++;
+    }
+
+    // Finite levels end when the last platform is passed - the same step for every lane
+    winStep = -1;
+    int last = level.scoreCursor + (cfg.totalPlatforms - sim.score) - 1;
+    if (!cfg.endless && last >= level.scoreCursor && last < level.count)
+    {
+        Platform p = level.platform(last);
+        float rightEdge = p.x + p.width;
+        double camera = level.cameraX;
+        for (int t = 0; t < kHorizon; t++)
+        {
+            camera += (double)(cfg.scrollSpeed * cfg.fixedTimestep);
+            if (camera >= Level::kRebaseX)
+            {
+                camera -= Level::kRebaseX;
+                rightEdge -= (float)Level::kRebaseX;
+            }
+            float passedX = (float)(camera + (double)sim.player.x) - cfg.radius;
+            if (rightEdge < passedX)
+            {
+                winStep = t;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * screen: Step n candidates side by side for up to kHorizon steps
+ *
+ * Same order as Simulation::step / BatchSim::stepBlock, one phase across
+ * all lanes at a time: input + physics, shared camera, landing, ground,
+ * collision, then each lane's end condition. Lanes that have ended keep
+ * stepping (their value is frozen) so every loop stays branch-free and
+ * fixed-width; the block stops early once all lanes have ended.
+ * Returns the steps taken.
+ */
+int SearchBot::screen(const Simulation &sim, Candidate *lanes, int n)
+{
+    const GameConfig &cfg = sim.config;
+    const Player &start = sim.player;
+    const float dt = cfg.fixedTimestep;
+    const float radius = cfg.radius;
+    const float radiusSq = radius * radius;
+    const float rh = cfg.platformHeight;
+    const int np = platformCount;
+
+    // Player::update constants in the physics number type (same values it computes)
+    const PhysicsScalar step = toScalar(dt);
+    const PhysicsScalar jumpVelocity = toScalar(cfg.jumpVelocity);
+    const PhysicsScalar gravityStep = toScalar(cfg.gravity) * step;
+    const PhysicsScalar jumpHoldStep = toScalar(cfg.jumpHoldAccel) * step;
+    const PhysicsScalar maxJumpHold = toScalar(cfg.maxJumpHold);
+    const PhysicsScalar groundY = toScalar(cfg.groundY);
+
+    // Lane copies of the player (padding lanes replay "don't jump" and are discarded)
+    int32_t delay[kLanes], releaseAt[kLanes];
+    PhysicsScalar y[kLanes], vy[kLanes], holdTimer[kLanes];
+    int32_t jumps[kLanes], jumping[kLanes], grounded[kLanes], leftGround[kLanes];
+    int32_t done[kLanes];
+    float value[kLanes];
+    for (int l = 0; l < kLanes; l++)
+    {
+        const Candidate &c = lanes[l < n ? l : 0];
+        delay[l] = (l < n) ? c.delay : -1;
+        releaseAt[l] = (delay[l] >= 0) ? delay[l] + c.hold : -1;
+        y[l] = start.y;
+        vy[l] = start.vy;
+        holdTimer[l] = start.jumpHoldTimer;
+        jumps[l] = start.jumpsRemaining;
+        jumping[l] = start.isJumping;
+        grounded[l] = start.grounded;
+        leftGround[l] = start.hasLeftGround;
+        done[l] = 0;
+        value[l] = kValueAlive;
+    }
+
+    // Platforms in this block's frame (shifted with the camera's rebases)
+    float px[kMaxPlatforms];
+    for (int i = 0; i < np; i++)
+    {
+        px[i] = platX[i];
+    }
+
+    // Platform the ball starts on (landing back on it is not progress)
+    double camera = sim.level.cameraX;
+    int startPlatform = -1;
+    if (start.grounded)
+    {
+        float bx = (float)(camera + (double)start.x);
+        float footY = toFloat(start.y) + radius;
+        float bestDistance = 4.0f;
+        for (int i = 0; i < np; i++)
+        {
+            float distance = std::fabs(platY[i] - footY);
+            if (px[i] <= bx && px[i] + platW[i] >= bx && distance < bestDistance)
+            {
+                startPlatform = i;
+                bestDistance = distance;
+            }
+        }
+    }
+
+    int t = 0;
+    for (; t < kHorizon; t++)
+    {
+        // ----- Input + Player::startJump / Player::update -----
+        float by[kLanes], byPrev[kLanes];
+        int32_t falling[kLanes], wasGrounded[kLanes];
+        for (int l = 0; l < kLanes; l++)
+        {
+            wasGrounded[l] = grounded[l];
+            int32_t jump = (t == delay[l]) & (jumps[l] > 0);
+            vy[l] = jump ? jumpVelocity : vy[l];
+            jumping[l] |= jump;
+            grounded[l] &= !jump;
+            leftGround[l] |= jump;
+            jumps[l] -= jump;
+            holdTimer[l] = jump ? PhysicsScalar() : holdTimer[l];
+
+            PhysicsScalar prevY = y[l];
+            int32_t held = (t >= delay[l]) & (t < releaseAt[l]);
+            int32_t boost = held & jumping[l] & (holdTimer[l] < maxJumpHold);
+            vy[l] += gravityStep;
+            vy[l] += boost ? jumpHoldStep : PhysicsScalar();
+            holdTimer[l] += boost ? step : PhysicsScalar();
+            y[l] += vy[l] * step;
+            by[l] = toFloat(y[l]);
+            byPrev[l] = toFloat(prevY);
+            falling[l] = toFloat(vy[l]) >= 0.0f;
+        }
+
+        // ----- Level::scroll (shared by every lane) -----
+        camera += (double)(cfg.scrollSpeed * dt);
+        if (camera >= Level::kRebaseX)
+        {
+            camera -= Level::kRebaseX;
+            for (int i = 0; i < np; i++)
+            {
+                px[i] -= (float)Level::kRebaseX;
+            }
+        }
+        const float bx = (float)(camera + (double)start.x);
+
+        // ----- Level::resolveLanding: highest platform top crossed -----
+        float targetY[kLanes];
+        int32_t landedOn[kLanes];
+        for (int l = 0; l < kLanes; l++)
+        {
+            targetY[l] = cfg.groundY;
+            landedOn[l] = -1;
+        }
+        for (int i = 0; i < np; i++)
+        {
+            const float top = platY[i];
+            const int32_t under = (px[i] <= bx) & (px[i] + platW[i] >= bx);
+            for (int l = 0; l < kLanes; l++)
+            {
+                int32_t better = under & falling[l] &
+                                 (by[l] + radius >= top) &
+                                 (byPrev[l] + radius <= top) &
+                                 (top < targetY[l]);
+                targetY[l] = better ? top : targetY[l];
+                landedOn[l] = better ? i : landedOn[l];
+            }
+        }
+
+        // ----- Landing / ground, Player::setGrounded, ground death -----
+        int32_t dead[kLanes];
+        for (int l = 0; l < kLanes; l++)
+        {
+            int32_t onPlatform = landedOn[l] >= 0;
+            int32_t onGround = !onPlatform & (by[l] > cfg.groundY);
+            y[l] = onPlatform ? toScalar(targetY[l] - radius) : onGround ? groundY : y[l];
+            vy[l] = (onPlatform | onGround) ? PhysicsScalar() : vy[l];
+            grounded[l] = onPlatform | onGround;
+            jumping[l] = grounded[l] ? 0 : jumping[l];
+            jumps[l] = grounded[l] ? 2 : jumps[l];
+            dead[l] = onGround & leftGround[l];
+            by[l] = toFloat(y[l]);
+        }
+
+        // ----- Level::checkCollision: circle vs platform rectangle -----
+        for (int i = 0; i < np; i++)
+        {
+            const float left = px[i];
+            const float right = px[i] + platW[i];
+            const float closestX = (bx < left) ? left : (bx > right ? right : bx);
+            const float dx = bx - closestX;
+            const float top = platY[i];
+            for (int l = 0; l < kLanes; l++)
+            {
+                float closestY = (by[l] < top) ? top : (by[l] > top + rh ? top + rh : by[l]);
+                float dy = by[l] - closestY;
+                dead[l] |= (dx * dx + dy * dy < radiusSq);
+            }
+        }
+
+        // ----- End conditions (first one a lane meets sets its value) -----
+        int32_t allDone = 1;
+        for (int l = 0; l < kLanes; l++)
+        {
+            int32_t i = landedOn[l];
+            int32_t landedNew = (i >= 0) & !wasGrounded[l] & (i != startPlatform);
+            float runway = (i >= 0) ? px[i] + platW[i] - bx : 0.0f;
+            float now = dead[l] ? kValueDead + (float)t
+                      : (t == winStep) ? kValueWin
+                      : landedNew ? landingValue(runway, t)
+                      : value[l];
+            int32_t ends = dead[l] | (t == winStep) | landedNew;
+            value[l] = done[l] ? value[l] : now;
+            done[l] |= ends;
+            allDone &= done[l];
+        }
+        if (allDone)
+        {
+            break;
+        }
+    }
+
+    // Survivors: resting beats falling, and spare jumps are worth keeping
+    for (int l = 0; l < n; l++)
+    {
+        lanes[l].value = done[l] ? value[l] : aliveValue(grounded[l] != 0, jumps[l]);
+    }
+    return std::min(t + 1, (int)kHorizon);
+}
+
+/**
+ * verify: Replay the candidate on the real simulation with the screen's
+ * end conditions, then put sim back; c.value gets the exact value
+ * Returns the steps replayed.
+ */
+int SearchBot::verify(Simulation &sim, Candidate &c)
+{
+    const GameConfig &cfg = sim.config;
+    int startSlot = sim.player.grounded
+                  ? platformUnder(sim.level, sim.level.worldX(sim.player.x), toFloat(sim.player.y) + cfg.radius)
+                  : -1;
+
+    c.value = kValueAlive;
+    int t = 0;
+    for (; t < kHorizon; t++)
+    {
+        FrameInput in;
+        in.jumpPressed = (t == c.delay);
+        in.jumpHeld = (c.delay >= 0 && t >= c.delay && t < c.delay + c.hold);
+        bool wasGrounded = sim.player.grounded;
+        sim.step(in, cfg.fixedTimestep);
+
+        if (sim.gameOver)
+        {
+            c.value = kValueDead + (float)t;
+            break;
+        }
+        if (sim.levelComplete)
+        {
+            c.value = kValueWin;
+            break;
+        }
+        if (!wasGrounded && sim.player.grounded)
+        {
+            float bx = sim.level.worldX(sim.player.x);
+            int slot = platformUnder(sim.level, bx, toFloat(sim.player.y) + cfg.radius);
+            if (slot >= 0 && slot != startSlot)
+            {
+                float runway = sim.level.platformX[slot] + sim.level.platformWidth[slot] - bx;
+                c.value = landingValue(runway, t);
+                break;
+            }
+        }
+    }
+    if (t == kHorizon)
+    {
+        c.value = aliveValue(sim.player.grounded, sim.player.jumpsRemaining);
+    }
+
+    sim.restore(snapshot);
+    return std::min(t + 1, (int)kHorizon);
+}
+
+/**
+ * adopt: Turn a candidate's relative timings into absolute frames
+ * ("don't jump" is kept for kIdleSteps, a jump until it is released)
+ */
+void SearchBot::adopt(const Simulation &sim, const Candidate &c)
+{
+    planned = true;
+    searching = false;
+    if (c.delay < 0)
+    {
+        pressFrame = -1;
+        releaseFrame = -1;
+        planEnd = sim.frame + kIdleSteps;
+    }
+    else
+    {
+        pressFrame = sim.frame + c.delay;
+        releaseFrame = pressFrame + c.hold;
+        planEnd = std::max(releaseFrame, pressFrame + 1);
+    }
+}
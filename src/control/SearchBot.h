@@ -0,0 +1,191 @@
+#pragma once
+
+#include <cstdint>
+#include "Controller.h"
+#include "../sim/Simulation.h"
+
+/**
+ * SearchBot: Reference bot - picks jump timings by looking ahead
+ *
+ * Plans:
+ * - A plan is "wait `delay` steps, press jump, hold it `hold` steps"
+ *   (or "don't jump"); the bot follows one plan at a time and searches
+ *   for the next only when it runs out, so most steps cost nothing
+ * - The ball gets no input while a search is under way
+ * - Candidates are every delay in 0, kDelayStride, ... (kDelays of them)
+ *   times kHolds hold lengths from 0 to maxJumpHold, plus "don't jump"
+ *
+ * Screening (SIMD lanes):
+ * - Each candidate is a lane; kLanes candidates are stepped together for
+ *   up to kHorizon steps against a copy of the platforms ahead, with the
+ *   same math as Player::update / Level::resolveLanding / checkCollision
+ *   (PhysicsScalar physics like BatchSim), in unit-stride lane loops with
+ *   branch-free platform tests the compiler turns into vector code
+ * - All lanes share one camera timeline (the world scrolls the same
+ *   whatever the ball does), rebased exactly like Level
+ * - A lane ends when it dies, wins, or lands on a new platform; landings
+ *   with more runway left before the platform's right edge score higher
+ *   (more time to line up the next jump), then earlier ones
+ * - Lanes alive at the horizon rank below any landing, resting ones and
+ *   ones with spare jumps first
+ *
+ * Verification (snapshot/restore):
+ * - The best kVerify candidates are replayed in order on the real
+ *   Simulation from a snapshot until one survives to the same end
+ *   condition; the state is restored afterwards, so the game never sees
+ *   the look-ahead
+ *
+ * Budget (kBudgetNs per input() call):
+ * - A search is split into units - one block of kLanes screened, or one
+ *   exact replay - and an input() call starts another unit only while a
+ *   full kHorizon-step unit of that kind, at the slowest recent time per
+ *   step, would still fit in kPlanNs; the rest waits for the next step
+ * - Delays count from the step the search started at, and the ball has
+ *   idled since, so a unit run `k` steps later shifts every delay by k
+ *   and skips candidates whose press is already behind
+ * - An optimized build runs a whole search (about 0.1-0.2 ms) in one step;
+ *   a debug build spreads it over a few. Replays run through
+ *   Simulation::step, so profiled builds count them in the step phases
+ */
+class SearchBot : public Controller
+{
+public:
+    static const int kLanes = 8;          // Candidates stepped together (8 floats = one AVX register)
+    static const int kDelays = 15;        // Press delays tried
+    static const int kDelayStride = 3;    // Steps between tried delays
+    static const int kHolds = 4;          // Hold lengths tried (tap .. maxJumpHold)
+    static const int kCandidates = kDelays * kHolds + 1;  // Plus "don't jump" (8 blocks of lanes)
+    static const int kHorizon = 300;      // Look-ahead steps (2.5 s at the default step: past the widest gap)
+    static const int kVerify = 4;         // Exact replays tried before taking the best screened plan
+    static const int kMaxPlatforms = 32;  // Platforms copied for screening
+    static const int kIdleSteps = 16;     // Steps a "don't jump" plan is kept before searching again
+    static const int kTimeBuckets = 200;  // Decision-time histogram buckets
+    static const int kBucketNs = 10000;   // 10 us per bucket (the last one also holds everything slower)
+    static const int64_t kBudgetNs = 1000000;  // Decision time per input() call (1 ms)
+    static const int64_t kPlanNs = kBudgetNs * 3 / 4;  // What units are fitted into (the rest absorbs timing jitter)
+
+    SearchBot();
+
+    FrameInput input(Simulation &sim) override;
+    void reset() override;
+    const char *name() const override { return "bot"; }
+
+    /**
+     * decidePercentileNs: Decision time that fraction p of input() calls
+     * stayed within (bucket resolution; descheduled calls land in the tail)
+     */
+    int64_t decidePercentileNs(double p) const;
+
+    // ===== Statistics (since construction) =====
+    long long searches = 0;       // Searches run
+    long long verifyFailures = 0; // Screened winners the exact replay rejected
+    long long replays = 0;        // Exact replays run
+    int64_t lastDecideNs = 0;     // Time spent in the latest input() call
+    int64_t maxDecideNs = 0;      // Slowest input() call
+    int64_t totalDecideNs = 0;    // Time spent in input() overall
+    long long decisions = 0;      // input() calls
+    long long overBudget = 0;     // input() calls slower than kBudgetNs
+    long long spreadSearches = 0; // Searches that took more than one step
+    long long decideBuckets[kTimeBuckets] = {};  // input() calls per kBucketNs of decision time
+
+private:
+    /**
+     * Candidate: One plan and its screened value
+     * delay < 0 = don't jump
+     */
+    struct Candidate
+    {
+        int delay;
+        int hold;
+        float value;
+    };
+
+    /**
+     * beginSearch: Fill the candidate list and drop the plan (no input
+     * until search adopts the next one)
+     */
+    void beginSearch(const Simulation &sim);
+
+    /**
+     * search: Run the search's next units until a plan is adopted or the
+     * budget of the input() call that started at startNs is spent
+     */
+    void search(Simulation &sim, int64_t startNs);
+
+    /**
+     * screenNext: Screen the next block of candidates from sim's step;
+     * rank them once the last block is done. Returns the steps screened
+     */
+    int screenNext(const Simulation &sim, int elapsed);
+
+    /**
+     * verifyNext: Replay the next ranked candidate still playable; adopt it
+     * if it survives, or the one that died last when none are left.
+     * Returns the steps replayed (0 if none was)
+     */
+    int verifyNext(Simulation &sim, int elapsed);
+
+    /**
+     * shifted: A candidate as seen `elapsed` idle steps after the search
+     * started (a press already behind is clamped to now)
+     */
+    static Candidate shifted(Candidate c, int elapsed);
+
+    /**
+     * missed: Whether the candidate's press is already behind
+     */
+    static bool missed(const Candidate &c, int elapsed) { return c.delay >= 0 && c.delay < elapsed; }
+
+    /**
+     * copyPlatforms: Unpassed live platforms (world X), and the step at
+     * which a finite level is won
+     */
+    void copyPlatforms(const Simulation &sim);
+
+    /**
+     * screen: Step n <= kLanes candidates in lanes, fill in their values;
+     * returns the steps taken (the block stops once every lane has ended)
+     */
+    int screen(const Simulation &sim, Candidate *lanes, int n);
+
+    /**
+     * verify: Replay a candidate on sim itself and set its exact value
+     * (>= 0: it survives); sim is restored from the snapshot either way.
+     * Returns the steps replayed
+     */
+    int verify(Simulation &sim, Candidate &c);
+
+    /**
+     * adopt: Make a candidate the current plan (absolute frames)
+     */
+    void adopt(const Simulation &sim, const Candidate &c);
+
+    // ===== Current Plan (absolute simulation frames) =====
+    bool planned = false;         // A plan is being followed
+    long long planFrame = -1;     // Last frame the plan gave input for (a gap means sim was replaced)
+    long long pressFrame = -1;    // Frame to press on (-1 = no press)
+    long long releaseFrame = -1;  // First frame the button is no longer held
+    long long planEnd = -1;       // First frame that needs a new search
+
+    // ===== Search In Progress =====
+    bool searching = false;       // A search is under way (no plan yet)
+    long long searchFrame = -1;   // Step the search started at (candidate delays count from it)
+    int candidateCount = 0;       // Candidates filled in
+    int nextBlock = 0;            // Next block of kLanes to screen
+    int verifyCount = 0;          // Ranked candidates to replay
+    int nextVerify = 0;           // Next of them to replay
+    int bestVerified = -1;        // Replayed candidate that died last (-1 = none yet)
+    float bestExact = 0.0f;       // Its exact value
+    int64_t blockStepNs = 0;      // Slowest recent screened block, per step (decays 1/16 per block)
+    int64_t replayStepNs = 0;     // Slowest recent replay, per step (same)
+
+    // ===== Search Scratch =====
+    Candidate candidates[kCandidates];
+    long long copiedFrame = -1;   // Step the platforms were copied at
+    int platformCount = 0;
+    float platX[kMaxPlatforms];   // Copied platforms (world X, left to right)
+    float platY[kMaxPlatforms];
+    float platW[kMaxPlatforms];
+    int winStep = -1;             // Step at which the final platform is passed (-1 = not in reach)
+    SimSnapshot snapshot;         // Verification start state
+};
@@ -1,177 +1,725 @@
 #include "Game.h"
+#include "../profile/ProfilerOverlay.h"
+#include "../memory/AllocationCounter.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
+#include <ctime>
+
+static const char *kReplayPath = "last_run.replay";  // Replay of the latest run (overwritten every run)
+static const float kDemoRestartDelay = 3.0f;         // Seconds a finished demo run stays on screen
+static const float kFrameSpikeTime = 0.05f;          // Frames longer than this are reported (telemetry)
+static const char *kHudFontPath = "hud_font.ttf";    // Baked into the HUD's SDF atlas if present
+
+/**
+ * HudLabelId: Hud label slots (each keeps its own cached glyph run)
+ */
+enum HudLabelId
+{
+    kHudHelp,
+    kHudStage,
+    kHudScore,
+    kHudTitle,   // "Game Over" / "Level Complete!"
+    kHudLine1,   // Overlay lines below the title
+    kHudLine2,
+    kHudLine3
+};
 
 /**
- * Game constructor: Initialize level with configured platform count
- * Player uses default constructor (initialized by reset() later)
+ * Game constructor: Nothing to set up yet
+ * Storage is sized by reserveSessionStorage and run state initialized by
+ * reset() once the window exists
  */
-Game::Game() : level(config.totalPlatforms) {}
+Game::Game() {}
 
 /**
  * run: Main game entry point
  * 
  * Initialization:
+ * 0. Size the level and session storage (the only large allocations of
+ *    the session); a layout too large to checkpoint ends here, before
+ *    any window
  * 1. Enable fullscreen mode before creating window
  * 2. Create window with title (actual size determined by monitor)
- * 3. Scale physics values proportionally to screen height:
- *    - gravity, jumpVelocity, jumpHoldAccel all scale with heightScale
- *    - This keeps gameplay feel consistent across different resolutions
- *    - Base resolution is 450px height, so 1440p ≈ 3.2x multiplier
- * 4. Set target FPS to 60
- * 5. Reset game to starting state
+ * 3. Physics stay in world units (screenWidth x screenHeight) on every
+ *    monitor - draw() scales the world to the window (worldView), so a
+ *    run plays out identically whatever the resolution
+ * 4. Rendering pace: vsync (display refresh) and/or config.targetFps cap,
+ *    uncapped by default - physics runs at its own fixed rate either way
+ * 5. Load level render resources (platform mesh, cloud sprite)
+ * 6. Seed the level seed source from the clock (new levels every launch)
+ * 7. Reset game to starting state
  * 
  * Game Loop:
  * - Runs until user closes window (ESC or window close button)
- * - Each frame: handle input, update state, render
+ * - Each frame: handle input, run 0..n fixed steps, render interpolated
  */
-void Game::run()
+bool Game::run()
 {
-    SetConfigFlags(FLAG_FULLSCREEN_MODE);
+    GameConfig &config = sim.config;
+    if (!reserveSessionStorage())
+    {
+        return false;
+    }
+
+    SetConfigFlags(FLAG_FULLSCREEN_MODE | (config.vsync ? FLAG_VSYNC_HINT : 0));
     InitWindow(config.screenWidth, config.screenHeight, "Side Scroller: Jumping Ball");
     
-    // Scale physics to match fullscreen resolution
-    // Base height is 450px - if screen is taller, physics need stronger forces
-    float heightScale = GetScreenHeight() / 450.0f;
-    config.gravity *= heightScale;
-    config.jumpVelocity *= heightScale;
-    config.jumpHoldAccel *= heightScale;
-    
-    SetTargetFPS(60);
+    SetTargetFPS(config.targetFps);  // 0 = no cap
+    levelRenderer.load(config, worldView().zoom);  // Needs the GL context; sky layer at window resolution
+    ghostRenderer.load(config);
+    hud.load(kHudFontPath);
+    seedSource.seed((uint64_t)std::time(nullptr));
+    nextSeed = (ghostCount > 0) ? ghostReplays[0].seed : seedSource.next64();
+    frameClockNs = telemetry.enabled() ? Profiler::nowNs() : 0;
     reset();
 
     // Main game loop - runs every frame
     while (!WindowShouldClose())
     {
+        if (kProfilerEnabled) profiler().beginFrame();
+        if (telemetry.enabled()) frameClockNs = Profiler::nowNs();  // One clock read for the frame's events
         handleInput();  // Process keyboard input
-        update();       // Update game logic
+        update(GetFrameTime());  // Update game logic
         draw();         // Render everything
+        if (kProfilerEnabled) profiler().endFrame();
     }
 
+    finishReplay();  // Window closed mid-run: keep what was played
+    telemetry.close();  // Write what is still queued
+    if (kProfilerEnabled && profiler().tracing())
+    {
+        profiler().stopTrace("trace.json");  // Keep a capture that was still running
+    }
+    levelRenderer.unload();
+    ghostRenderer.unload();
+    hud.unload();
     CloseWindow();
+    return true;
+}
+
+/**
+ * benchmark: run()'s setup in a hidden window, then every replay to its end
+ * - Each replay's level is the next random run (its seed and mode), so
+ *   reset() builds it exactly as a played run would
+ * - A frame is timed from before update() to after draw()'s EndDrawing
+ *   (buffer swap included); frameMs is grown before each replay, so the
+ *   timed loop doesn't allocate
+ * - The pregenerator keeps building in the background as in play
+ */
+bool Game::benchmark(const std::vector<std::string> &replayPaths, std::vector<float> &frameMs)
+{
+    GameConfig &config = sim.config;
+    if (!reserveSessionStorage())
+    {
+        return false;
+    }
+
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(config.screenWidth, config.screenHeight, "Side Scroller: Jumping Ball (perfsuite)");
+    SetTargetFPS(0);
+    levelRenderer.load(config, worldView().zoom);
+    ghostRenderer.load(config);
+    hud.load(kHudFontPath);
+    recordRuns = false;
+    useController(&replayInput);
+
+    bool reproduced = true;
+    ReplayReader reader;
+    for (const std::string &path : replayPaths)
+    {
+        if (!reader.open(path.c_str()))
+        {
+            reproduced = false;
+            continue;
+        }
+        config.endless = reader.endless;
+        nextSeed = reader.seed;
+        replayInput.play(&reader);
+        reset();
+        if (configHash(config) != reader.hash)
+        {
+            reproduced = false;
+            continue;
+        }
+
+        frameMs.reserve(frameMs.size() + (size_t)reader.result.frames + 1);
+        while (!sim.isFinished() && sim.frame < reader.result.frames && !WindowShouldClose())
+        {
+            int64_t start = Profiler::nowNs();
+            if (kProfilerEnabled) profiler().beginFrame();
+            update(config.fixedTimestep);  // One step per frame
+            draw();
+            if (kProfilerEnabled) profiler().endFrame();
+            frameMs.push_back((float)(Profiler::nowNs() - start) * 1e-6f);
+        }
+        reproduced = reproduced && reader.complete && sim.frame == reader.result.frames &&
+                     sim.score == reader.result.score;
+    }
+    replayInput.play(nullptr);
+
+    levelRenderer.unload();
+    ghostRenderer.unload();
+    hud.unload();
+    CloseWindow();
+    return reproduced;
+}
+
+/**
+ * openLevelPack: Map the pack; reset() picks stages from it from now on
+ * - Every stage's layout is checked here, so a stage that couldn't be
+ *   checkpointed is an error up front, not a missing retry mid-session
+ */
+bool Game::openLevelPack(const char *path)
+{
+    stageIndex = 0;
+    if (!levelPack.open(path) || levelPack.stageCount() == 0)
+    {
+        return false;
+    }
+    LevelStage stage;
+    for (int i = 0; levelPack.stage(i, stage); i++)
+    {
+        if (!Level::snapshotFits(Level::stageLayout(stage, sim.config)))
+        {
+            levelPack.close();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * setDemo: Attract mode - the bot takes over until a player presses Space
+ */
+void Game::setDemo(bool on)
+{
+    demo = on;
+    useController(on ? (Controller *)&bot : (Controller *)&keyboard);
+}
+
+/**
+ * setCurveLevels: The generator itself is set up by reserveSessionStorage
+ */
+void Game::setCurveLevels(bool on)
+{
+    sim.config.curveLevels = on;
+}
+
+/**
+ * openTelemetry: Events of every run from now on go to path
+ */
+bool Game::openTelemetry(const char *path)
+{
+    return telemetry.open(path);
+}
+
+/**
+ * addGhost: Load a replay to race
+ * - It must replay on this build and config (its config hash), and on the
+ *   first ghost's seed and mode
+ * - The first one sets the mode; its seed is used from run() on
+ */
+bool Game::addGhost(const char *path)
+{
+    if (ghostCount >= GhostRace::kMaxGhosts)
+    {
+        return false;
+    }
+    ReplayReader &reader = ghostReplays[ghostCount];
+    if (!reader.open(path))
+    {
+        return false;
+    }
+    GameConfig recorded = sim.config;
+    recorded.seed = reader.seed;
+    recorded.endless = reader.endless;
+    bool sameLevel = ghostCount == 0 ||
+                     (reader.seed == ghostReplays[0].seed && reader.endless == ghostReplays[0].endless);
+    if (!sameLevel || configHash(recorded) != reader.hash)
+    {
+        return false;
+    }
+    if (ghostCount == 0)
+    {
+        sim.config.endless = reader.endless;
+    }
+    ghostCount++;
+    return true;
+}
+
+/**
+ * useController: Switch who plays; the new controller starts with no plan
+ */
+void Game::useController(Controller *next)
+{
+    controller = next;
+    controller->reset();
+}
+
+/**
+ * reserveSessionStorage: Every block the session needs, allocated once
+ * - Level storage for the most demanding layout, in sim and in every
+ *   level the pregenerator swaps into it; a pack's stages are scanned
+ *   once here, so switching stages never grows an arena
+ * - The trace buffer (profiler builds) in the session arena
+ * - Curve levels: the difficulty table is swept here, before the first
+ *   order (~0.2 s), and the stage storage sized for totalPlatforms; the
+ *   table is only read from then on, by the producer and by resetNow
+ * - Both modes must be checkpointable (E switches between them at any
+ *   restart); pack stages were checked by openLevelPack
+ */
+bool Game::reserveSessionStorage()
+{
+    const GameConfig &config = sim.config;
+    GameConfig finite = config;
+    finite.endless = false;
+    GameConfig endless = config;
+    endless.endless = true;
+    if (!Level::snapshotFits(finite) || !Level::snapshotFits(endless))
+    {
+        return false;
+    }
+    size_t runBytes = std::max(Level::storageBytes(finite), Level::storageBytes(endless));
+
+    LevelStage stage;
+    for (int i = 0; levelPack.stage(i, stage); i++)
+    {
+        runBytes = std::max(runBytes, Level::storageBytes(Level::stageLayout(stage, config)));
+    }
+
+    int curvePlatforms = 0;
+    if (config.curveLevels && !curves)
+    {
+        curvePool.reset(new ThreadPool());
+        curves.reset(new CurveGenerator(*curvePool));
+        curves->prepare(finite);
+        pregenerator.useCurves(curves.get());
+    }
+    if (curves)
+    {
+        curvePlatforms = config.totalPlatforms;
+    }
+
+    sim.level.reserveStorage(runBytes, curvePlatforms);
+    pregenerator.reserve(runBytes, curvePlatforms);
+
+    sessionArena.reset();
+    sessionArena.reserve(kProfilerEnabled ? Profiler::traceBytes() : 0);
+    if (kProfilerEnabled)
+    {
+        profiler().reserveTrace(sessionArena);
+    }
+    return true;
 }
 
 /**
  * reset: Initialize/restart game to starting state
  * Called at game start and when player presses space after game over/complete
+ * 
+ * - Random levels get a fresh seed and are recorded to kReplayPath
+ * - Pack stages are not recorded (replays rebuild levels from their seed)
+ * - The run is swapped in from the pregenerator when it was built in the
+ *   background (the usual case); otherwise generated here the same way
+ *   (resetNow), in sim's own reserved storage (no heap traffic)
+ * - The run start is the first checkpoint
+ * - A RunStart telemetry event records the seed and stage
  */
 void Game::reset()
 {
-    player.reset(config);     // Move ball to starting position, reset jumps
-    level.generate(config);   // Create new random platform layout
-    score = 0;                // Clear score
-    gameOver = false;         // Clear death flag
-    levelComplete = false;    // Clear win flag
-    cameraOffsetY = 0.0f;     // Reset camera to starting position
+    LevelStage stage;
+    bool packRun = levelPack.stage(stageIndex, stage);
+    if (!packRun)
+    {
+        stage = LevelStage();
+        sim.config.seed = nextSeed;        // Each run gets its own (reproducible) level
+        nextSeed = (ghostCount > 0) ? ghostReplays[0].seed : seedSource.next64();  // Ghosts: always their level
+    }
+    if (!LevelPregenerator::prebuilt(sim.config, stage) || !pregenerator.take(sim.config, stage, sim))
+    {
+        pregenerator.resetNow(sim.config, stage, sim);  // Same level, built here; player at start, flags cleared
+    }
+    if (!packRun && recordRuns)
+    {
+        replay.begin(kReplayPath, sim.config);  // Record this run
+    }
+    racing = ghostCount > 0 && !packRun && !sim.config.continuousCollision &&
+             sim.config.seed == ghostReplays[0].seed && configHash(sim.config) == ghostReplays[0].hash;
+    ghosts.reset(sim, racing ? ghostCount : 0);
+    for (int g = 0; g < ghosts.count; g++)
+    {
+        ghostReplays[g].rewind();
+    }
+    finishJumpEvent();  // Normally pushed when the last run ended
+    runNumber++;
+    if (telemetry.enabled())
+    {
+        TelemetryEvent event;
+        event.timeNs = frameClockNs;
+        event.seed = sim.config.seed;
+        event.run = runNumber - 1;
+        event.value = packRun ? stageIndex : -1;
+        event.type = TelemetryEventType::RunStart;
+        event.cause = sim.config.endless ? 1 : 0;
+        telemetry.push(event);
+    }
+    orderNextRuns();
+    hasCheckpoint = sim.capture(checkpoint);
+    controller->reset();      // Drop any input or plan from before the restart
+    demoRestartTimer = 0.0f;
+    accumulator = 0.0f;       // Restart fixed-step timing
+    savePreviousState();      // Nothing to interpolate from yet
+}
+
+/**
+ * orderNextRuns: Both slots of the pregenerator's double buffer are used
+ * - Pack: this stage again (after a game over) and the next one
+ * - Random levels: the next seed, in this mode and in the other one (E)
+ * Orders for a run that doesn't happen are dropped at the next reset
+ */
+void Game::orderNextRuns()
+{
+    LevelStage stage;
+    if (levelPack.stage(stageIndex, stage))
+    {
+        pregenerator.order(sim.config, stage);
+        LevelStage next;
+        if (levelPack.stageCount() > 1 && levelPack.stage((stageIndex + 1) % levelPack.stageCount(), next))
+        {
+            pregenerator.order(sim.config, next);
+        }
+        return;
+    }
+    GameConfig next = sim.config;
+    next.seed = nextSeed;
+    for (int mode = 0; mode < 2; mode++, next.endless = !next.endless)
+    {
+        if (LevelPregenerator::prebuilt(next))
+        {
+            pregenerator.order(next);  // Flat random levels reset faster than they swap in
+        }
+    }
+}
+
+/**
+ * retryFromCheckpoint: Restore the snapshot instead of rebuilding the level
+ * - The replay of the original run was closed when it ended; the retry
+ *   isn't a run from frame 0, so it isn't recorded
+ * - The checkpoint is kept, so the same jump can be retried again and again
+ */
+void Game::retryFromCheckpoint()
+{
+    if (!hasCheckpoint || !sim.restore(checkpoint))
+    {
+        return;
+    }
+    finishJumpEvent();
+    pushEvent(TelemetryEventType::Retry, (int)sim.frame, sim.score);
+    racing = false;  // The ghosts' inputs are for the run from step 0
+    ghosts.count = 0;
+    controller->reset();
+    accumulator = 0.0f;
+    savePreviousState();
+}
+
+/**
+ * pushEvent: Fill in the run and frame clock and queue the event
+ */
+void Game::pushEvent(TelemetryEventType type, int frame, int value, float amount, uint8_t cause)
+{
+    if (!telemetry.enabled())
+    {
+        return;
+    }
+    TelemetryEvent event;
+    event.timeNs = frameClockNs;
+    event.run = runNumber - 1;
+    event.frame = frame;
+    event.value = value;
+    event.amount = amount;
+    event.type = type;
+    event.cause = cause;
+    telemetry.push(event);
+}
+
+/**
+ * recordStepEvents: Events of the step that just ran (telemetry on only)
+ * - A jump is pushed once its hold is over (button released, jump motion
+ *   ended, run ended or a new jump started), carrying the seconds held
+ * - One PlatformScored per platform Level::awardScore passed this step
+ * - Death (with its cause) or LevelComplete on the step that ended the run
+ * Taken from committed steps only: the search bot's lookahead steps the
+ * same Simulation and restores it, and those steps must not be reported.
+ */
+void Game::recordStepEvents(const FrameInput &input, bool jumped, int scoreBefore, bool wasFinished)
+{
+    int frame = (int)sim.frame - 1;
+    if (jumped)
+    {
+        jumpFrame = frame;
+    }
+    if (jumpFrame >= 0 && (!input.jumpHeld || !sim.player.isJumping || sim.isFinished()))
+    {
+        finishJumpEvent();
+    }
+    for (int s = scoreBefore + 1; s <= sim.score; s++)
+    {
+        pushEvent(TelemetryEventType::PlatformScored, frame, s);
+    }
+    if (!wasFinished && sim.gameOver)
+    {
+        pushEvent(TelemetryEventType::Death, frame, sim.score, 0.0f, (uint8_t)sim.deathCause);
+    }
+    else if (!wasFinished && sim.levelComplete)
+    {
+        pushEvent(TelemetryEventType::LevelComplete, frame, sim.score);
+    }
+}
+
+/**
+ * finishJumpEvent: Push the jump being held with its hold time
+ */
+void Game::finishJumpEvent()
+{
+    if (jumpFrame < 0)
+    {
+        return;
+    }
+    pushEvent(TelemetryEventType::Jump, jumpFrame, 0, toFloat(sim.player.jumpHoldTimer));
+    jumpFrame = -1;
+}
+
+/**
+ * savePreviousState: Remember the render state before the next step
+ * draw() blends between this and the state after the step
+ */
+void Game::savePreviousState()
+{
+    prevPlayerY = toFloat(sim.player.y);
+    prevRotation = sim.player.rotation;
+    prevCameraOffsetY = sim.cameraOffsetY;
+    for (int g = 0; g < ghosts.count; g++)
+    {
+        prevGhostY[g] = toFloat(ghosts.players[g].y);
+        prevGhostRotation[g] = ghosts.players[g].rotation;
+    }
+}
+
+/**
+ * finishReplay: Close the current recording with the run's outcome
+ * (no-op if nothing is being recorded)
+ */
+void Game::finishReplay()
+{
+    if (!replay.recording())
+    {
+        return;
+    }
+    ReplayResult result;
+    result.frames = sim.frame;
+    result.score = sim.score;
+    result.gameOver = sim.gameOver;
+    result.levelComplete = sim.levelComplete;
+    result.finished = sim.isFinished();
+    replay.finish(result);
 }
 
 /**
  * handleInput: Process keyboard input each frame
  * 
  * During Gameplay:
- * - Space: Jump (if jumps available - double jump system)
+ * - The controller polls its device (keyboard: Space press / hold; the
+ *   bot decides per step in update instead)
+ * - B: Swap between keyboard and bot
+ * 
+ * Demo Mode:
+ * - Space: Leave the demo and start a run on the keyboard
+ * - Finished runs restart after kDemoRestartDelay (next pack stage once completed)
  * 
  * During Game Over / Level Complete:
- * - Space: Restart game (calls reset())
+ * - Space: Restart game (calls reset()) - the next pack stage after a completed one
+ * - R (game over only): Retry from the last platform landed on
+ * - E: Toggle endless mode and restart (random levels only)
+ * 
+ * Profiler (only when built with ENABLE_PROFILER):
+ * - F3: Toggle the timing overlay
+ * - F4: Start / stop a Chrome trace capture (written to trace.json)
  */
 void Game::handleInput()
 {
-    // Game over/complete state: wait for restart
-    if (gameOver || levelComplete)
+    PROFILE_SCOPE(Input);
+    NO_ALLOCATION_SCOPE("Game::handleInput");
+
+    if (kProfilerEnabled)
+    {
+        if (IsKeyPressed(KEY_F3))
+        {
+            showProfiler = !showProfiler;
+        }
+        if (IsKeyPressed(KEY_F4))
+        {
+            if (profiler().tracing())
+            {
+                profiler().stopTrace("trace.json");
+            }
+            else
+            {
+                profiler().startTrace();
+            }
+        }
+    }
+
+    // Attract mode: the bot plays until someone presses Space
+    if (demo)
     {
         if (IsKeyPressed(KEY_SPACE))
         {
-            reset();  // Start new game
+            setDemo(false);
+            reset();  // The player's own run
+            return;
+        }
+        if (UNLIKELY(sim.isFinished()))
+        {
+            demoRestartTimer += GetFrameTime();
+            if (demoRestartTimer >= kDemoRestartDelay)
+            {
+                if (sim.levelComplete && levelPack.stageCount() > 0)
+                {
+                    stageIndex = (stageIndex + 1) % levelPack.stageCount();
+                }
+                reset();
+            }
         }
+        return;
+    }
+
+    if (IsKeyPressed(KEY_B))
+    {
+        useController(controller == &bot ? (Controller *)&keyboard : (Controller *)&bot);
+    }
+
+    // Game over/complete state: wait for restart
+    if (UNLIKELY(sim.isFinished()))
+    {
+        handleRunEndInput();
         return;  // Don't process jump input
     }
 
-    // Gameplay state: handle jumping
-    if (player.canJump() && IsKeyPressed(KEY_SPACE))
+    // Gameplay state: sample the controller's device for this frame's steps
+    controller->beginFrame();
+}
+
+/**
+ * handleRunEndInput: Space restarts (the next pack stage after a completed
+ * one), R retries from the checkpoint after a game over, E switches
+ * between the finite and endless modes (random levels only)
+ */
+void Game::handleRunEndInput()
+{
+    if (IsKeyPressed(KEY_SPACE))
     {
-        player.startJump(config);
+        if (sim.levelComplete && levelPack.stageCount() > 0)
+        {
+            stageIndex = (stageIndex + 1) % levelPack.stageCount();  // On to the next stage
+        }
+        reset();  // Start new game
+    }
+    else if (IsKeyPressed(KEY_R) && sim.gameOver)
+    {
+        retryFromCheckpoint();  // Practice: back to the last platform
+    }
+    else if (IsKeyPressed(KEY_E) && levelPack.stageCount() == 0)
+    {
+        sim.config.endless = !sim.config.endless;
+        reset();  // Start new game in the other mode
     }
 }
 
 /**
- * update: Update all game logic each frame
- * 
- * Physics & Movement:
- * 1. Get delta time (time since last frame)
- * 2. Store previous Y position (needed for landing detection)
- * 3. Update player physics (gravity, jump hold, position, rotation)
- * 4. Scroll level (move platforms/clouds left)
+ * update: Advance the simulation at a fixed rate, independent of frame rate
  * 
- * Collision & Landing:
- * 5. Resolve landing on platforms or ground
- *    - Sets player Y to surface level if landing
- *    - Returns whether grounded and whether it was ground (not platform)
- * 6. Update player grounded state (refills jumps if landed)
+ * Accumulator:
+ * - Add this frame's time (clamped to maxFrameTime after stalls; run()
+ *   passes GetFrameTime, benchmark() exactly one fixedTimestep)
+ * - Run as many fixedTimestep steps as fit, keeping the remainder
+ * - Same step size as the headless runner, so jump heights don't depend
+ *   on display refresh rate
  * 
- * Camera System:
- * 7. Calculate camera offset to follow ball upward
- *    - Keeps ball at 40% screen height when climbing
- *    - Offset is negative (shifts world down as ball climbs)
- *    - Clamped to 0 minimum (doesn't scroll down past start)
+ * Input:
+ * - The controller is asked right before each step (the bot searches
+ *   with the state that step starts from, restoring it afterwards)
+ * - Keyboard: a latched press is consumed by the first step that runs,
+ *   held state applies to every step this frame
  * 
- * Game Over Conditions:
- * 8. Check if touched ground after first jump (death rule)
- * 9. Check if hit platform sides (death from collision)
+ * Replay:
+ * - Each step's input goes to the replay recorder before the step runs
+ * - The replay is closed with the outcome once the run ends
+ *
+ * Checkpoint:
+ * - A step that lands the ball on a platform (grounded again after being
+ *   airborne, run still going) snapshots the simulation (~20 ns)
+ *
+ * Ghosts (when racing):
+ * - After each step the host simulated, ghosts take their replays' input
+ *   for it and step on the same level (GhostRace::step)
+ *
+ * Telemetry (when opened):
+ * - Each committed step's jumps, scored platforms and run end are queued
+ *   (recordStepEvents), plus a FrameSpike for frames over kFrameSpikeTime
  * 
- * Scoring & Win:
- * 10. Award points for platforms passed
- * 11. Check if all platforms passed (win condition)
+ * All gameplay rules live in Simulation::step.
+ * Debug builds assert that a frame's update makes no heap allocation.
  */
-void Game::update()
+void Game::update(float frameTime)
 {
-    float dt = GetFrameTime();  // Time since last frame (typically ~0.016s at 60 FPS)
-    
-    // Pause updates if game ended
-    if (gameOver || levelComplete)
-    {
-        return;
-    }
-
-    // Store previous Y for landing detection
-    float prevY = player.y;
-    
-    // Update physics and movement
-    player.update(dt, config);  // Apply gravity, jump, update position and rotation
-    level.scroll(dt, config);   // Move platforms and clouds left
-    
-    // Handle landing on platforms or ground
-    bool landedOnGround = false;  // Will be set true if landed on ground (not platform)
-    bool groundedNow = level.resolveLanding(
-        player.x, prevY, player.y, player.vy, 
-        config.radius, config, landedOnGround
-    );
-    player.setGrounded(groundedNow);  // Update player state, refill jumps if landed
-
-    // Camera follows ball upward
-    // desiredScreenY = where we want ball on screen (40% from top)
-    // cameraOffsetY = how much to shift world down (negative value)
-    float desiredScreenY = config.screenHeight * 0.4f;
-    cameraOffsetY = std::min(0.0f, player.y - desiredScreenY);
-
-    // Death condition: touched ground after leaving it at least once
-    if (landedOnGround && player.hasJumpedOnce())
+    NO_ALLOCATION_SCOPE("Game::update");
+    const float dt = sim.config.fixedTimestep;
+    accumulator += std::min(frameTime, sim.config.maxFrameTime);
+    if (frameTime > kFrameSpikeTime)
     {
-        gameOver = true;
+        pushEvent(TelemetryEventType::FrameSpike, (int)sim.frame, 0, frameTime * 1000.0f);
     }
 
-    // Award score for passing platforms
-    score += level.awardScore(player.x, config.radius);
-
-    // Win condition: passed all platforms
-    if (score >= config.totalPlatforms)
+    while (accumulator >= dt)
     {
-        levelComplete = true;
+        savePreviousState();
+        FrameInput input = controller->input(sim);
+        if (!sim.isFinished())
+        {
+            replay.record(sim.frame, input);  // Exactly the input this step consumes
+        }
+        bool wasGrounded = sim.player.grounded;
+        bool wasFinished = sim.isFinished();
+        int scoreBefore = sim.score;
+        bool jumped = input.jumpPressed && sim.player.canJump() && !wasFinished;
+        if (jumped)
+        {
+            finishJumpEvent();  // A new jump ends the previous one's hold (before startJump clears it)
+        }
+        sim.step(input, dt);
+        if (racing && !wasFinished)
+        {
+            FrameInput ghostInputs[GhostRace::kMaxGhosts];
+            for (int g = 0; g < ghosts.count; g++)
+            {
+                ghostInputs[g] = ghostReplays[g].next();  // Recorded input of the same step
+            }
+            ghosts.step(ghostInputs, dt, sim);  // Same level, right after the host's step
+        }
+        if (telemetry.enabled())
+        {
+            recordStepEvents(input, jumped, scoreBefore, wasFinished);
+        }
+        if (!wasGrounded && sim.player.grounded && !sim.isFinished())
+        {
+            hasCheckpoint = sim.capture(checkpoint);  // Landed on a platform: new retry point
+        }
+        accumulator -= dt;
     }
 
-    // Death condition: hit platform side/bottom
-    if (level.checkCollision(player.x, player.y, config.radius, config))
+    if (UNLIKELY(sim.isFinished()))
     {
-        gameOver = true;
+        finishReplay();
     }
 }
 
@@ -179,65 +727,197 @@ void Game::update()
  * draw: Render all game visuals
  * 
  * Rendering Order (back to front):
- * 1. Clear to teal background color
- * 2. Sky elements (sun, clouds) - with camera offset for vertical scroll
- * 3. Ground rectangle - with camera offset
- * 4. Platforms (gold rectangles) - with camera offset
+ * 1. Clear to teal background color (what shows in letterbox bars)
+ * 2. Sky layer - background, sun and ground, one cached texture redrawn
+ *    only when the camera leaves its range (LevelRenderer) - then the
+ *    clouds - with camera offset for vertical scroll
+ * 3. Platforms (gold rectangles, one mesh draw) - with camera offset
+ * 4. Ghost balls when racing (translucent sprites, one batch) - with camera offset
  * 5. Player ball (red with white dot) - with camera offset
  *    - Ball rotation creates rolling effect
  *    - White dot at 75% radius rotates to show rolling motion
- * 6. UI text (instructions, score) - no camera offset (fixed on screen)
- * 7. Game over / level complete overlays - no camera offset
+ * 6. UI text (instructions, score; cached glyph runs, one batch) - no camera offset (fixed on screen)
+ * 7. Game over / level complete overlays - no camera offset (drawHud)
+ * 8. Profiler overlay when toggled (profiler builds only, window pixels)
+ * 
+ * Render Transform:
+ * - Steps 2-7 are drawn in world units inside BeginMode2D(worldView())
+ * - The only place the window size matters (the simulation never sees it)
  * 
  * Camera Offset:
  * - All world elements (sky, ground, platforms, player) use cameraOffsetY
+ * - Platforms and clouds are placed relative to the scrolling camera X
+ *   (the ball stays at a fixed screen X)
  * - UI elements don't use offset (stay fixed on screen)
  * - Negative offset shifts Y coordinates down (ball climbs, camera follows)
+ * 
+ * Interpolation:
+ * - alpha = fraction of a step left in the accumulator
+ * - Player Y, rotation and camera blend between the last two steps
+ * - The camera X is drawn lagTime behind the latest step along its
+ *   constant scroll motion (same as blending it between the two steps,
+ *   and unaffected by the level rebasing its origin in between)
+ * - Once the run has ended nothing moves, so the latest state is drawn
  */
 void Game::draw()
 {
+    NO_ALLOCATION_SCOPE("Game::draw");
+    const GameConfig &config = sim.config;
+    const Player &player = sim.player;
+    const Level &level = sim.level;
+
+    float alpha = sim.isFinished() ? 1.0f : accumulator / config.fixedTimestep;
+    float lagTime = (1.0f - alpha) * config.fixedTimestep;
+
+    float playerY = prevPlayerY + (toFloat(player.y) - prevPlayerY) * alpha;
+    float cameraOffsetY = prevCameraOffsetY + (sim.cameraOffsetY - prevCameraOffsetY) * alpha;
+    double cameraX = level.cameraX - (double)(config.scrollSpeed * lagTime);
+    float rotationDelta = player.rotation - prevRotation;
+    if (rotationDelta < 0.0f) rotationDelta += 360.0f;  // Rotation wrapped past 360 this step
+    float rotation = prevRotation + rotationDelta * alpha;
+
+    levelRenderer.updateSkyLayer(config, cameraOffsetY, background);  // Redrawn only when the camera left its range
+
     BeginDrawing();
-    ClearBackground(background);  // Teal background
+    ClearBackground(background);  // Teal background (also fills any letterbox bars)
+    BeginMode2D(worldView());      // World units -> window pixels
 
-    // Background elements (sun and clouds) with camera
-    level.drawSky(config, cameraOffsetY);
+    // Background elements (sky layer with sun and ground, then clouds) with camera
+    levelRenderer.drawSky(level, config, cameraX, cameraOffsetY);
 
-    // Ground rectangle (dark green) with camera
-    DrawRectangle(0, (int)(config.groundY + config.radius - cameraOffsetY), config.screenWidth, config.screenHeight, DARKGREEN);
-    
     // Platforms (gold) with camera
-    level.drawPlatforms(config, cameraOffsetY);
+    levelRenderer.drawPlatforms(level, config, cameraX, cameraOffsetY);
     
+    // Ghost balls (one sprite batch, behind the player)
+    if (racing)
+    {
+        ghostRenderer.draw(ghosts, prevGhostY, prevGhostRotation, alpha, cameraOffsetY);
+    }
+
     // Player ball (red with rotating white dot)
-    float screenY = player.y - cameraOffsetY;  // Apply camera offset to Y
+    float screenY = playerY - cameraOffsetY;  // Apply camera offset to Y
     DrawCircle((int)player.x, (int)screenY, config.radius, RED);
     
     // White dot shows rolling motion (rotates with ball)
     // Positioned at 75% of radius (inside edge but not touching)
     // Rotation matches scroll speed (630 deg/sec = one rotation per circumference at 220 px/sec)
-    float spotX = player.x + config.radius * 0.75f * cosf(player.rotation * PI / 180.0f);
-    float spotY = screenY + config.radius * 0.75f * sinf(player.rotation * PI / 180.0f);
+    float spotX = player.x + config.radius * 0.75f * cosf(rotation * PI / 180.0f);
+    float spotY = screenY + config.radius * 0.75f * sinf(rotation * PI / 180.0f);
     DrawCircle((int)spotX, (int)spotY, 4.0f, WHITE);
 
+    // UI text and end-of-run overlays (fixed on screen - no camera offset)
+    drawHud();
+    EndMode2D();
+
+    if (kProfilerEnabled && showProfiler)
+    {
+        drawProfilerOverlay(profiler(), 20, 50);
+    }
+
+    EndDrawing();
+}
+
+/**
+ * worldView: Scale the screenWidth x screenHeight world to fit the window
+ * - Uniform zoom (no stretching); the spare axis is centered (letterboxed)
+ * - 16:9 monitors fit exactly with the default 800x450 world
+ */
+Camera2D Game::worldView() const
+{
+    const GameConfig &config = sim.config;
+    float windowW = (float)GetScreenWidth();
+    float windowH = (float)GetScreenHeight();
+    float zoom = std::min(windowW / config.screenWidth, windowH / config.screenHeight);
+
+    Camera2D view = {};
+    view.offset = {(windowW - config.screenWidth * zoom) * 0.5f, (windowH - config.screenHeight * zoom) * 0.5f};
+    view.target = {0.0f, 0.0f};
+    view.rotation = 0.0f;
+    view.zoom = zoom;
+    return view;
+}
+
+/**
+ * drawHud: Screen-space UI drawn on top of the world
+ * - Instructions and score (top corners); score and stage strings are
+ *   only formatted when their values change (HudText), and every label is
+ *   only laid out again when its string changes (Hud)
+ * - Game over / level complete overlays: the text under the dimming is
+ *   flushed first, then the overlay's own text on top
+ * - One batched text draw per flush: one in play, two with an overlay
+ */
+void Game::drawHud()
+{
+    PROFILE_SCOPE(Hud);
+
+    const GameConfig &config = sim.config;
+    float centerX = config.screenWidth / 2.0f;
+    float centerY = config.screenHeight / 2.0f;
+
     // UI text (fixed on screen - no camera offset)
-    DrawText("Space to jump", 20, 20, 20, BLACK);
-    DrawText(TextFormat("Score: %d / %d", score, config.totalPlatforms), config.screenWidth - 220, 20, 20, BLACK);
+    const char *help = demo ? "Demo - press Space to play"
+                     : (controller == &bot) ? "Bot playing - B to take over"
+                     : "Space to jump, B for the bot";
+    hud.text(kHudHelp, help, 20.0f, 20.0f, 20.0f, BLACK);
+    bool packMode = levelPack.stageCount() > 0;
+    if (packMode)
+    {
+        hud.text(kHudStage, stageText.format("Stage %d / %d", stageIndex + 1, levelPack.stageCount()), centerX - 60.0f, 20.0f, 20.0f, BLACK);
+    }
+    if (config.endless)
+    {
+        hud.text(kHudScore, scoreText.format("Score: %d", sim.score), config.screenWidth - 220.0f, 20.0f, 20.0f, BLACK);
+    }
+    else
+    {
+        hud.text(kHudScore, scoreText.format("Score: %d / %d", sim.score, config.totalPlatforms), config.screenWidth - 220.0f, 20.0f, 20.0f, BLACK);
+    }
+
+    // Game over / level complete overlay
+    if (UNLIKELY(sim.isFinished()))
+    {
+        hud.flush();  // Dimmed with the world
+        drawRunEndOverlay(centerX, centerY, packMode);
+    }
+
+    hud.flush();
+}
+
+/**
+ * drawRunEndOverlay: Dim the world and show the end screen's title and
+ * keys (its labels are flushed by drawHud's last flush)
+ */
+void Game::drawRunEndOverlay(float centerX, float centerY, bool packMode)
+{
+    const GameConfig &config = sim.config;
 
     // Game over overlay
-    if (gameOver)
+    if (sim.gameOver)
     {
         DrawRectangle(0, 0, config.screenWidth, config.screenHeight, Fade(BLACK, 0.45f));
-        DrawText("Game Over", config.screenWidth / 2 - 90, config.screenHeight / 2 - 40, 32, WHITE);
-        DrawText("Space to restart", config.screenWidth / 2 - 115, config.screenHeight / 2 + 4, 20, WHITE);
+        hud.text(kHudTitle, "Game Over", centerX - 90.0f, centerY - 40.0f, 32.0f, WHITE);
+        hud.text(kHudLine1, "Space to restart", centerX - 115.0f, centerY + 4.0f, 20.0f, WHITE);
+        float row = centerY + 30.0f;
+        if (hasCheckpoint)
+        {
+            hud.text(kHudLine2, "R to retry from the last platform", centerX - 115.0f, row, 20.0f, WHITE);
+            row += 26.0f;
+        }
+        if (!packMode)
+        {
+            hud.text(kHudLine3, config.endless ? "E for normal mode" : "E for endless mode", centerX - 115.0f, row, 20.0f, WHITE);
+        }
     }
 
     // Level complete overlay
-    if (levelComplete)
+    if (sim.levelComplete)
     {
         DrawRectangle(0, 0, config.screenWidth, config.screenHeight, Fade(DARKGREEN, 0.35f));
-        DrawText("Level Complete!", config.screenWidth / 2 - 120, config.screenHeight / 2 - 40, 32, WHITE);
-        DrawText("Space to play again", config.screenWidth / 2 - 130, config.screenHeight / 2 + 4, 20, WHITE);
+        hud.text(kHudTitle, "Level Complete!", centerX - 120.0f, centerY - 40.0f, 32.0f, WHITE);
+        hud.text(kHudLine1, packMode ? "Space for the next stage" : "Space to play again", centerX - 130.0f, centerY + 4.0f, 20.0f, WHITE);
+        if (!packMode)
+        {
+            hud.text(kHudLine2, "E for endless mode", centerX - 130.0f, centerY + 30.0f, 20.0f, WHITE);
+        }
     }
-
-    EndDrawing();
 }
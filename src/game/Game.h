@@ -2,8 +2,25 @@
 
 #include "raylib.h"
 #include "../config/Config.h"
-#include "../player/Player.h"
-#include "../level/Level.h"
+#include "../config/Hints.h"
+#include "../sim/Simulation.h"
+#include "../sim/Replay.h"
+#include "../sim/LevelPregenerator.h"
+#include "../sim/CurveGenerator.h"
+#include "../sim/GhostRace.h"
+#include "../level/LevelPack.h"
+#include "../level/LevelRenderer.h"
+#include "../memory/Arena.h"
+#include "../parallel/ThreadPool.h"
+#include "../control/SearchBot.h"
+#include "../control/ReplayController.h"
+#include "../telemetry/Telemetry.h"
+#include "GhostRenderer.h"
+#include "Hud.h"
+#include "KeyboardController.h"
+#include <memory>
+#include <string>
+#include <vector>
 
 /**
  * Game: Main game controller - orchestrates all gameplay systems
@@ -11,65 +28,215 @@
  * Responsibilities:
  * - Initialize raylib window and configure fullscreen
  * - Run main game loop (input, update, render)
- * - Coordinate Player, Level, and physics interactions
- * - Manage game state (playing, game over, level complete)
- * - Handle camera system for vertical scrolling
+ * - Ask the active Controller (keyboard or SearchBot) for every step's
+ *   input and feed it to the Simulation
  * - Display UI (score, instructions, end screens)
  * 
+ * Gameplay itself (Player, Level, scoring, camera) lives in Simulation,
+ * which the headless runner drives with the same step function.
+ * 
  * Game Flow:
- * 1. Constructor: Create level with configured platform count
+ * 1. Constructor: Create simulation with default config
  * 2. run(): Initialize window, enter game loop until closed
  * 3. Game loop: handleInput -> update -> draw (repeat each frame)
- * 4. On game over/complete: wait for restart input
+ *    update runs fixed-size simulation steps; draw interpolates between them
+ * 4. On game over/complete: wait for restart input (or retry from the
+ *    last platform landed on - a snapshot, restored without resimulating)
+ *
+ * Demo (attract mode):
+ * - The bot plays and finished runs restart by themselves after a pause;
+ *   Space hands the game to the player (a new run on the keyboard)
+ * - B switches between keyboard and bot at any time outside demo mode
+ *
+ * Ghosts (--ghost, up to 8 replays):
+ * - Every random run is played on the ghosts' level and they race it,
+ *   replaying their recorded input on sim's own Level (GhostRace - no
+ *   level per ghost); a retry from a checkpoint isn't raced
+ *
+ * Benchmark (perfsuite):
+ * - benchmark() plays recorded runs through the real update / draw path
+ *   in a hidden window, one fixed step per frame, and times every frame
+ *
+ * Telemetry (--telemetry):
+ * - Run starts, jumps, scored platforms, deaths, completions, retries and
+ *   frame spikes are pushed as fixed-size events and written off-thread
+ *   (Telemetry); the game thread never waits on the file
+ *
+ * Hot / cold:
+ * - Everything that runs a few times per run at most (restart, run end,
+ *   retry, end-of-run input and overlays) is a COLD function, out of line
+ *   in .text.unlikely; the loop's per-frame path (input polling, steps,
+ *   world and HUD drawing) stays packed together (see config/Hints.h)
+ *
+ * Memory:
+ * - Everything a run needs (level ring, clouds, grid) is carved from the
+ *   level's arena, which run() sizes once for every layout the session can
+ *   play; a restart resets its cursor in O(1)
+ * - Curve and pack runs are built in the background while this one is
+ *   played (LevelPregenerator), in levels reserved the same way; reset()
+ *   swaps one into sim, so restarting does no level generation, carving
+ *   or copying on the render thread. Flat random levels are reset in
+ *   place, which is cheaper than the swap
+ * - Curve levels (--curve): the difficulty table is swept once when the
+ *   session starts; each level is then generated by the pregenerator
+ *   into its level's own stage storage
+ * - The session arena holds session-lifetime storage (the profiler's trace
+ *   buffer); the replay writer buffers in place and the profiler's frame
+ *   history is allocated once at startup
+ * - Debug builds assert that handleInput, update and draw make no heap
+ *   allocation (NO_ALLOCATION_SCOPE, see AllocationCounter.h)
  */
 class Game
 {
 public:
     /**
      * Constructor: Initialize game components
-     * - Creates level with totalPlatforms from config
-     * - Player and config use default initialization
+     * - Simulation creates level with totalPlatforms from config
      */
     Game();
     
     /**
      * run: Main entry point - set up window and run game loop
      * - Configures fullscreen mode
-     * - Scales physics to match actual screen height
+     * - Physics run in world units; only drawing scales to the screen
      * - Runs game loop until window closed
+     * Returns false without opening a window if the config's level layout
+     * is too large to checkpoint (see Level::snapshotFits)
+     */
+    bool run();
+
+    /**
+     * openLevelPack: Play the stages of a level pack instead of random levels
+     * - Stages are played in order; completing one moves on to the next
+     * - Call before run(); returns false if the pack can't be opened, is
+     *   empty or has a stage too large to checkpoint (Level::snapshotFits)
+     */
+    bool openLevelPack(const char *path);
+
+    /**
+     * setDemo: Attract mode on or off (the bot plays until Space is pressed)
+     * Call before run()
+     */
+    void setDemo(bool on);
+
+    /**
+     * setCurveLevels: Random levels follow the config's difficulty ramp
+     * (GameConfig::curveLevels, CurveGenerator) instead of staying flat
+     * Call before run(); the difficulty table is built when it starts
+     */
+    void setCurveLevels(bool on);
+
+    /**
+     * openTelemetry: Export run events to path as NDJSON ("-" = stdout)
+     * Call before run(); returns false if the file can't be opened
+     */
+    bool openTelemetry(const char *path);
+
+    /**
+     * addGhost: Race the ghost of a recorded run (up to GhostRace::kMaxGhosts)
+     * The first ghost picks the level: every random run is played on its
+     * seed and mode. Later ghosts must be recorded on the same level.
+     * Call before run(); returns false if the replay can't be raced
      */
-    void run();
+    bool addGhost(const char *path);
+
+    /**
+     * benchmark: Render recorded runs offscreen and time every frame
+     * - Opens a hidden window instead of run()'s fullscreen one (call
+     *   instead of run(), on a fresh Game)
+     * - Each replay's input is played through update() and draw(), one
+     *   fixed step per frame and no frame cap; nothing is recorded
+     * - frameMs gets each frame's update + draw + present time in ms
+     * Returns false if a replay is unreadable, recorded with another
+     * config, or didn't end with its recorded score and step count
+     */
+    bool benchmark(const std::vector<std::string> &replayPaths, std::vector<float> &frameMs);
 
 private:
+    /**
+     * reserveSessionStorage: Size sim's and the pregenerator's level
+     * storage for the largest run layout (finite, endless and every pack
+     * stage), and the session arena for the profiler's trace buffer;
+     * with curve levels also sweeps the difficulty table (once per session)
+     * Returns false (nothing reserved) if the finite or endless layout
+     * can't be checkpointed - retry would never be available
+     */
+    COLD bool reserveSessionStorage();
+
     /**
      * reset: Start/restart the game
      * - Resets player to starting position
-     * - Generates new random level
+     * - Generates new random level (or loads the current pack stage)
      * - Clears score and game state flags
      * - Resets camera offset
      */
-    void reset();
+    COLD void reset();
+
+    /**
+     * orderNextRuns: Have the runs that can follow the current one built in
+     * the background, where that beats a reset (LevelPregenerator::prebuilt)
+     */
+    COLD void orderNextRuns();
     
+    /**
+     * savePreviousState: Store player Y, rotation and camera before a step
+     * (interpolation source for draw)
+     */
+    void savePreviousState();
+
+    /**
+     * finishReplay: Write the replay footer (score, outcome) and close it
+     */
+    COLD void finishReplay();
+
+    /**
+     * retryFromCheckpoint: Put the run back to the last checkpoint
+     * (practice - the continued run is not recorded)
+     */
+    COLD void retryFromCheckpoint();
+
+    /**
+     * pushEvent: Queue a telemetry event of the current run (no-op when
+     * telemetry is off)
+     */
+    void pushEvent(TelemetryEventType type, int frame, int value = 0, float amount = 0.0f, uint8_t cause = 0);
+
+    /**
+     * recordStepEvents: Telemetry for the step that just ran - jumps (once
+     * their hold ends), platforms scored, and how the run ended
+     */
+    void recordStepEvents(const FrameInput &input, bool jumped, int scoreBefore, bool wasFinished);
+
+    /**
+     * finishJumpEvent: Push the pending jump with its hold time, if any
+     */
+    void finishJumpEvent();
+
     /**
      * handleInput: Process player input
-     * - Space to jump (double jump system)
-     * - Space to restart after game over/complete
+     * - Lets the controller poll its device for this frame's steps
+     * - Space to restart after game over/complete, R to retry from the checkpoint
+     * - B to swap keyboard / bot; demo mode restarts runs on its own
      */
     void handleInput();
+
+    /**
+     * handleRunEndInput: The game over / level complete screen's keys
+     * (restart, retry, mode switch)
+     */
+    COLD void handleRunEndInput();
     
+    /**
+     * useController: Hand the game to another controller (drops its old plan)
+     */
+    void useController(Controller *next);
+
     /**
      * update: Update game state each frame
-     * - Apply physics to player
-     * - Scroll level (platforms and clouds)
-     * - Resolve landing/collision
-     * - Update camera to follow ball
-     * - Check game over conditions:
-     *   - Touching ground after first jump = death
-     *   - Hitting platform sides = death
-     * - Award score for passed platforms
-     * - Check win condition (score >= totalPlatforms)
-     */
-    void update();
+     * - Accumulates frameTime (seconds) and runs whole fixedTimestep steps
+     * - See Simulation::step for physics, collision, camera and scoring
+     */
+    void update(float frameTime);
     
     /**
      * draw: Render all visuals
@@ -78,18 +245,77 @@ private:
      * - Ground rectangle with camera offset
      * - Platforms with camera offset
      * - Player (red ball with white dot) with camera offset
+     * - World state interpolated between the last two fixed steps
      * - UI text (instructions, score)
      * - Game over / level complete overlays
      */
     void draw();
 
+    /**
+     * drawHud: Render screen-space UI
+     * - Instructions and score
+     * - Game over / level complete overlays
+     */
+    void drawHud();
+
+    /**
+     * drawRunEndOverlay: Dimming and text of the game over / level
+     * complete screen (after the HUD under it was flushed)
+     */
+    COLD void drawRunEndOverlay(float centerX, float centerY, bool packMode);
+
+    /**
+     * worldView: Render transform from world units to window pixels
+     */
+    Camera2D worldView() const;
+
     // ===== Game State =====
-    GameConfig config;           // Configuration values
-    Player player;               // The ball character
-    Level level;                 // Platform world and background
+    Arena sessionArena;          // Session-lifetime storage (profiler trace buffer)
+    Simulation sim;              // Player, level, score and run state
+    KeyboardController keyboard; // Human player
+    SearchBot bot;               // Reference bot (demo mode, B)
+    Controller *controller = &keyboard;  // Who supplies each step's input
+    bool demo = false;           // Attract mode: the bot plays, runs restart by themselves
+    float demoRestartTimer = 0.0f;  // Time since the demo run ended
+    Rng seedSource;              // Picks a fresh level seed for every run
+    uint64_t nextSeed = 0;       // Seed of the next random run (drawn a run ahead so it can be prebuilt)
+    LevelPregenerator pregenerator;  // Builds the next run's level on a background thread
+    std::unique_ptr<ThreadPool> curvePool;        // Difficulty table sweep (curve levels only)
+    std::unique_ptr<CurveGenerator> curves;       // Prepared once per session (curve levels only)
+    LevelRenderer levelRenderer; // Batched platform/cloud drawing (GPU resources)
+    ReplayWriter replay;         // Records the current run's input
+    bool recordRuns = true;      // Random runs are recorded (off while benchmarking)
+    ReplayController replayInput;  // Recorded input (benchmark)
+    LevelPack levelPack;         // Curated stages (tournament mode, empty otherwise)
+    int stageIndex = 0;          // Pack stage being played
+    SimSnapshot checkpoint;      // State at the last platform landing (or the run start)
+    bool hasCheckpoint = false;  // checkpoint holds a state of the current level
+
+    // ===== Fixed-Step Timing / Interpolation =====
+    float accumulator = 0.0f;        // Unsimulated time carried to the next frame
+    float prevPlayerY = 0.0f;        // Player Y before the latest step
+    float prevRotation = 0.0f;       // Player rotation before the latest step
+    float prevCameraOffsetY = 0.0f;  // Camera offset before the latest step
+    float prevGhostY[GhostRace::kMaxGhosts] = {};         // Ghost Y before the latest step
+    float prevGhostRotation[GhostRace::kMaxGhosts] = {};  // Ghost rotation before the latest step
     Color background{20, 160, 133, 255};  // Teal background color
-    int score = 0;               // Platforms passed (0 to totalPlatforms)
-    bool gameOver = false;       // Death state (hit ground or platform side)
-    bool levelComplete = false;  // Win state (passed all platforms)
-    float cameraOffsetY = 0.0f;  // Vertical camera offset (follows player upward)
+    bool showProfiler = false;       // Profiler overlay visible (F3, profiler builds only)
+
+    // ===== Ghost Race =====
+    GhostRace ghosts;                                  // Ghosts racing this run on sim.level
+    ReplayReader ghostReplays[GhostRace::kMaxGhosts];  // Their recorded input (read once by addGhost)
+    int ghostCount = 0;                                // Replays added
+    bool racing = false;                               // This run is on the ghosts' level and config
+    GhostRenderer ghostRenderer;                       // One sprite batch for all ghosts (GPU resource)
+
+    // ===== Telemetry =====
+    Telemetry telemetry;             // Event export (off unless openTelemetry succeeded)
+    uint32_t runNumber = 0;          // Runs started this session (the current one is runNumber - 1)
+    int64_t frameClockNs = 0;        // Session clock read once per frame, shared by its events
+    int jumpFrame = -1;              // Step the jump still being held was pressed on (-1 = none)
+
+    // ===== HUD =====
+    Hud hud;                         // Cached glyph runs, one batch per flush (GPU resources)
+    HudText scoreText;               // "Score: ..." (re-formatted when the score changes)
+    HudText stageText;               // "Stage ..." (pack mode)
 };
@@ -0,0 +1,81 @@
+#include "GhostRenderer.h"
+#include <cmath>
+
+static const float kGhostPad = 1.0f;  // Transparent border (soft filtered edge)
+
+/**
+ * Ghost tints: translucent, and none of them the player's red or the platforms' gold
+ */
+static const Color kGhostColors[GhostRace::kMaxGhosts] = {
+    {102, 191, 255, 150}, {135, 60, 190, 150}, {0, 228, 48, 150}, {255, 161, 0, 150},
+    {255, 109, 194, 150}, {211, 176, 131, 150}, {255, 0, 255, 150}, {245, 245, 245, 150},
+};
+
+/**
+ * load: Draw the ball once - body white (takes the tint), the rolling
+ * spot grey (a darker shade of it), spot at angle 0 (+X) like the
+ * player's at rotation 0
+ */
+void GhostRenderer::load(const GameConfig &cfg)
+{
+    unload();
+
+    half = cfg.radius + kGhostPad;
+    int size = (int)std::ceil(half * 2.0f);
+    sprite = LoadRenderTexture(size, size);
+    SetTextureFilter(sprite.texture, TEXTURE_FILTER_BILINEAR);
+
+    BeginTextureMode(sprite);
+    ClearBackground(Color{255, 255, 255, 0});
+    DrawCircle((int)half, (int)half, cfg.radius, WHITE);
+    DrawCircle((int)(half + cfg.radius * 0.75f), (int)half, 4.0f, Color{90, 90, 90, 255});
+    EndTextureMode();
+
+    loaded = true;
+}
+
+/**
+ * unload: Release the sprite
+ */
+void GhostRenderer::unload()
+{
+    if (!loaded)
+    {
+        return;
+    }
+    UnloadRenderTexture(sprite);
+    sprite = RenderTexture2D{};
+    loaded = false;
+}
+
+/**
+ * draw: One textured quad per ghost, all from the same texture
+ * - Y and rotation blend between the last two steps like the player's
+ * - Render textures are stored upside down (negative source height); the
+ *   spot sits on the horizontal axis, so the flip doesn't move it
+ */
+void GhostRenderer::draw(const GhostRace &race, const float *prevY, const float *prevRotation, float alpha,
+                         float cameraOffsetY) const
+{
+    if (!loaded)
+    {
+        return;
+    }
+    float size = half * 2.0f;
+    Rectangle source = {0.0f, 0.0f, size, -size};
+    for (int g = 0; g < race.count; g++)
+    {
+        if (race.gameOver[g])
+        {
+            continue;  // Out of the race
+        }
+        const Player &ghost = race.players[g];
+        float y = prevY[g] + (toFloat(ghost.y) - prevY[g]) * alpha;
+        float rotationDelta = ghost.rotation - prevRotation[g];
+        if (rotationDelta < 0.0f) rotationDelta += 360.0f;  // Rotation wrapped past 360 this step
+        float rotation = prevRotation[g] + rotationDelta * alpha;
+
+        Rectangle dest = {ghost.x, y - cameraOffsetY, size, size};
+        DrawTexturePro(sprite.texture, source, dest, Vector2{half, half}, rotation, kGhostColors[g]);
+    }
+}
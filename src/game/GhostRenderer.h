@@ -0,0 +1,45 @@
+#pragma once
+
+#include "raylib.h"
+#include "../config/Config.h"
+#include "../sim/GhostRace.h"
+
+/**
+ * GhostRenderer: Draws every ghost of a GhostRace in one sprite batch
+ *
+ * - The ball (with its rolling spot) is drawn once into a cached render
+ *   texture; each ghost is that sprite, tinted with its own translucent
+ *   color and rotated by its roll
+ * - All ghosts share the texture and are drawn back to back, so they land
+ *   in one raylib batch: one draw call for any number of ghosts
+ * - Ghosts that died are not drawn (the ones still running, and any that
+ *   completed the level, are)
+ *
+ * Owns a GPU resource: call load() after InitWindow and unload() before
+ * CloseWindow (like LevelRenderer).
+ */
+class GhostRenderer
+{
+public:
+    /**
+     * load: Render the ball sprite at the config's radius
+     */
+    void load(const GameConfig &cfg);
+
+    /**
+     * unload: Free the sprite (safe to call when not loaded)
+     */
+    void unload();
+
+    /**
+     * draw: Render the race's ghosts between their previous and current
+     * step (prevY / prevRotation, blended by alpha) under the camera offset
+     */
+    void draw(const GhostRace &race, const float *prevY, const float *prevRotation, float alpha,
+              float cameraOffsetY) const;
+
+private:
+    RenderTexture2D sprite{};  // Ball with its spot, white on transparent
+    float half = 0.0f;         // Sprite center (radius plus padding)
+    bool loaded = false;
+};
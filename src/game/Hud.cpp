@@ -0,0 +1,268 @@
+#include "Hud.h"
+#include "rlgl.h"
+#include <cstdio>
+#include <cstring>
+
+static const int kSdfGlyphCount = 95;  // Printable ASCII (' ' to '~'), LoadFontData's default set
+
+/**
+ * SDF fragment shader (raylib's distance field example): the atlas alpha
+ * is the distance to the glyph outline, 0.5 on it; smoothstep over one
+ * fragment's change of it gives a one-pixel antialiased edge at any scale
+ */
+static const char *kSdfShader330 =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "out vec4 finalColor;\n"
+    "void main()\n"
+    "{\n"
+    "    float d = texture(texture0, fragTexCoord).a - 0.5;\n"
+    "    float w = length(vec2(dFdx(d), dFdy(d)));\n"
+    "    finalColor = vec4(fragColor.rgb, fragColor.a * smoothstep(-w, w, d));\n"
+    "}\n";
+
+static const char *kSdfShaderLegacyBody =
+    "varying vec2 fragTexCoord;\n"
+    "varying vec4 fragColor;\n"
+    "uniform sampler2D texture0;\n"
+    "void main()\n"
+    "{\n"
+    "    float d = texture2D(texture0, fragTexCoord).a - 0.5;\n"
+    "    float w = length(vec2(dFdx(d), dFdy(d)));\n"
+    "    gl_FragColor = vec4(fragColor.rgb, fragColor.a * smoothstep(-w, w, d));\n"
+    "}\n";
+
+/**
+ * HudText::format: Compare, then snprintf into the fixed buffer if needed
+ * (patterns are string literals, so comparing pointers is enough)
+ */
+const char *HudText::format(const char *pattern, int first, int second)
+{
+    if (pattern != lastPattern || first != lastFirst || second != lastSecond)
+    {
+        std::snprintf(text, sizeof(text), pattern, first, second);
+        lastPattern = pattern;
+        lastFirst = first;
+        lastSecond = second;
+    }
+    return text;
+}
+
+/**
+ * load: Pick the font and build the ASCII lookup
+ *
+ * SDF Atlas (fontPath readable and the GL version has shaders):
+ * - Glyph distance fields at kSdfBaseSize px, packed into one bilinear
+ *   filtered texture (filtering a distance field keeps the edge exact)
+ * - Fragment shader for the context: GLSL 330 on desktop GL 3.3+, 120 on
+ *   GL 2.1, 100 with derivatives on OpenGL ES
+ *
+ * Otherwise raylib's default font (owned by raylib, not freed here).
+ */
+void Hud::load(const char *fontPath)
+{
+    unload();
+
+    int version = rlGetVersion();
+    if (fontPath != nullptr && version != RL_OPENGL_11 && FileExists(fontPath))
+    {
+        int dataSize = 0;
+        unsigned char *data = LoadFileData(fontPath, &dataSize);
+        if (data != nullptr)
+        {
+            font = Font{};
+            font.baseSize = kSdfBaseSize;
+            font.glyphCount = kSdfGlyphCount;
+            font.glyphPadding = 0;
+            font.glyphs = LoadFontData(data, dataSize, kSdfBaseSize, nullptr, kSdfGlyphCount, FONT_SDF);
+            UnloadFileData(data);
+        }
+        if (font.glyphs != nullptr)
+        {
+            Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, kSdfGlyphCount, kSdfBaseSize, 0, 1);
+            font.texture = LoadTextureFromImage(atlas);
+            UnloadImage(atlas);
+            SetTextureFilter(font.texture, TEXTURE_FILTER_BILINEAR);
+
+            char legacy[512];
+            const char *fragment = kSdfShader330;
+            if (version == RL_OPENGL_21 || version >= RL_OPENGL_ES_20)
+            {
+                const char *header = (version == RL_OPENGL_21)
+                    ? "#version 120\n"
+                    : "#version 100\n#extension GL_OES_standard_derivatives : enable\nprecision mediump float;\n";
+                std::snprintf(legacy, sizeof(legacy), "%s%s", header, kSdfShaderLegacyBody);
+                fragment = legacy;
+            }
+            sdfShader = LoadShaderFromMemory(nullptr, fragment);
+            sdfFont = sdfShader.id != 0 && sdfShader.id != rlGetShaderIdDefault();  // Failed builds fall back to the default shader
+            if (!sdfFont)
+            {
+                UnloadFont(font);
+            }
+        }
+    }
+    if (!sdfFont)
+    {
+        font = GetFontDefault();
+        sdfShader = Shader{};
+    }
+
+    for (int c = 0; c < 128; c++)
+    {
+        glyphLookup[c] = -1;
+    }
+    for (int i = 0; i < font.glyphCount; i++)
+    {
+        int value = font.glyphs[i].value;
+        if (value >= 0 && value < 128)
+        {
+            glyphLookup[value] = i;
+        }
+    }
+
+    for (HudLabel &label : labels)
+    {
+        label.size = 0.0f;  // Laid out against the previous font
+    }
+    queued = 0;
+    loaded = true;
+}
+
+/**
+ * unload: Free what load() baked (the default font belongs to raylib)
+ */
+void Hud::unload()
+{
+    if (!loaded)
+    {
+        return;
+    }
+    if (sdfFont)
+    {
+        UnloadShader(sdfShader);
+        UnloadFont(font);
+    }
+    font = Font{};
+    sdfShader = Shader{};
+    sdfFont = false;
+    queued = 0;
+    loaded = false;
+}
+
+/**
+ * text: Refresh the label's glyph run if needed, then queue it
+ * A full queue is flushed first (only if more labels than slots are shown)
+ */
+void Hud::text(int label, const char *str, float x, float y, float size, Color color)
+{
+    if (!loaded || label < 0 || label >= kMaxLabels)
+    {
+        return;
+    }
+
+    HudLabel &cached = labels[label];
+    if (cached.size != size || std::strncmp(cached.text, str, kLabelChars) != 0)
+    {
+        layout(cached, str, size);
+        layouts++;
+    }
+
+    if (queued == kMaxLabels)
+    {
+        flush();
+    }
+    queue[queued++] = HudDraw{label, x, y, color};
+}
+
+/**
+ * flush: One DrawTexturePro per glyph, all from the atlas texture
+ * - raylib batches consecutive quads of one texture into one draw call
+ * - BeginShaderMode / EndShaderMode bracket the batch in SDF mode
+ */
+void Hud::flush()
+{
+    if (queued == 0)
+    {
+        return;
+    }
+
+    if (sdfFont)
+    {
+        BeginShaderMode(sdfShader);
+    }
+    for (int i = 0; i < queued; i++)
+    {
+        const HudDraw &draw = queue[i];
+        const HudLabel &label = labels[draw.label];
+        for (int g = 0; g < label.glyphCount; g++)
+        {
+            const HudGlyph &glyph = label.glyphs[g];
+            Rectangle dest = {draw.x + glyph.dest.x, draw.y + glyph.dest.y, glyph.dest.width, glyph.dest.height};
+            DrawTexturePro(font.texture, glyph.source, dest, Vector2{0.0f, 0.0f}, 0.0f, draw.color);
+        }
+    }
+    if (sdfFont)
+    {
+        EndShaderMode();
+    }
+    queued = 0;
+}
+
+/**
+ * layout: DrawText / DrawTextEx placement, computed once per string
+ * - scale = size / atlas size; spacing = size / 10 (DrawText's default
+ *   font rule, used for the SDF font too)
+ * - Each glyph is its atlas rectangle grown by the font's padding, placed
+ *   at its bearing (offsetX/offsetY) from the pen
+ * - The pen advances by advanceX (or the glyph width) plus spacing;
+ *   spaces only advance it
+ * - Truncated to kLabelChars - 1 characters
+ */
+void Hud::layout(HudLabel &label, const char *str, float size)
+{
+    std::strncpy(label.text, str, kLabelChars - 1);
+    label.text[kLabelChars - 1] = '\0';
+    label.size = size;
+    label.glyphCount = 0;
+
+    if (!sdfFont && size < 10.0f)
+    {
+        size = 10.0f;  // DrawText's smallest size
+    }
+    float scale = size / (float)font.baseSize;
+    float spacing = sdfFont ? size / 10.0f : (float)((int)size / 10);
+    float pad = (float)font.glyphPadding;
+    float penX = 0.0f;
+
+    for (const char *c = label.text; *c != '\0'; c++)
+    {
+        int index = glyphIndex((unsigned char)*c);
+        if (index < 0)
+        {
+            continue;
+        }
+        const GlyphInfo &info = font.glyphs[index];
+        const Rectangle &rec = font.recs[index];
+
+        if (*c != ' ' && *c != '\t')
+        {
+            HudGlyph &glyph = label.glyphs[label.glyphCount++];
+            glyph.source = {rec.x - pad, rec.y - pad, rec.width + 2.0f * pad, rec.height + 2.0f * pad};
+            glyph.dest = {penX + (info.offsetX - pad) * scale, (info.offsetY - pad) * scale,
+                          (rec.width + 2.0f * pad) * scale, (rec.height + 2.0f * pad) * scale};
+        }
+        penX += (info.advanceX == 0 ? rec.width : (float)info.advanceX) * scale + spacing;
+    }
+}
+
+/**
+ * glyphIndex: ASCII lookup, '?' for anything the atlas lacks
+ */
+int Hud::glyphIndex(int c) const
+{
+    int index = (c < 128) ? glyphLookup[c] : -1;
+    return (index >= 0) ? index : glyphLookup['?'];
+}
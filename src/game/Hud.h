@@ -0,0 +1,137 @@
+#pragma once
+
+#include "raylib.h"
+
+/**
+ * HudText: A HUD string that is only re-formatted when its values change
+ * (the score changes a few times a second; the HUD is drawn every frame)
+ */
+struct HudText
+{
+    /**
+     * format: The text for pattern with the values first and second
+     * (snprintf only when they differ from the last call)
+     */
+    const char *format(const char *pattern, int first, int second = 0);
+
+    char text[48] = "";                 // Formatted string
+    const char *lastPattern = nullptr;  // Pattern text was formatted with
+    int lastFirst = 0;                  // Values text was formatted with
+    int lastSecond = 0;
+};
+
+/**
+ * Hud: Cached glyph runs for every HUD string, drawn from one font atlas
+ *
+ * Labels:
+ * - Each label slot keeps its string laid out as glyph quads (atlas
+ *   source rectangle + offset from the label's origin)
+ * - text() only lays a label out again when its string or size changed
+ *   (a strcmp per label per frame): static strings are laid out once, the
+ *   score whenever it changes
+ * - Position and color are per frame and cost nothing to change
+ *
+ * Drawing:
+ * - text() only queues; flush() emits the queued labels as textured quads
+ *   of the one atlas texture, so they land in a single raylib batch (one
+ *   draw call), in SDF shader mode when the atlas is a distance field
+ * - Shapes drawn between two flushes (the end-of-run dimming) stay between
+ *   the text drawn before and after them
+ *
+ * Font:
+ * - load() bakes a signed-distance-field atlas from a TTF once (printable
+ *   ASCII, kSdfBaseSize px glyphs): edges stay sharp at any scale, so the
+ *   HUD is crisp at every fullscreen resolution the world view scales to
+ * - No TTF (or no shader): raylib's default bitmap font, laid out exactly
+ *   like DrawText (same glyph placement and spacing)
+ *
+ * Fixed-size label and glyph storage: laying out and drawing never
+ * allocate. Call load() after InitWindow and unload() before CloseWindow.
+ */
+class Hud
+{
+public:
+    static constexpr int kMaxLabels = 8;     // Label slots
+    static constexpr int kLabelChars = 48;   // Longest label (HudText::text's size)
+    static constexpr int kSdfBaseSize = 48;  // Glyph size the SDF atlas is baked at (px)
+
+    /**
+     * load: Bake the SDF atlas from fontPath if it is readable, else use
+     * the default font (fontPath may be nullptr)
+     */
+    void load(const char *fontPath);
+
+    /**
+     * unload: Free the atlas and shader (safe to call when not loaded)
+     */
+    void unload();
+
+    /**
+     * text: Queue label `label` showing str at (x, y), size px tall
+     * Re-lays the label out only if str or size changed since its last use
+     */
+    void text(int label, const char *str, float x, float y, float size, Color color);
+
+    /**
+     * flush: Draw every queued label (one batch) and empty the queue
+     */
+    void flush();
+
+    /**
+     * sdf: The atlas is a distance field (a TTF was baked)
+     */
+    bool sdf() const { return sdfFont; }
+
+    // ===== Statistics =====
+    long long layouts = 0;  // Labels laid out (string or size changed)
+
+private:
+    /**
+     * HudGlyph: One laid-out character (dest relative to the label origin)
+     */
+    struct HudGlyph
+    {
+        Rectangle source;   // Atlas texels
+        Rectangle dest;     // Offset and size at the label's size
+    };
+
+    /**
+     * HudLabel: A cached glyph run
+     */
+    struct HudLabel
+    {
+        char text[kLabelChars] = "";  // String it was laid out for
+        float size = 0.0f;            // Size it was laid out at (0 = never)
+        int glyphCount = 0;
+        HudGlyph glyphs[kLabelChars];
+    };
+
+    /**
+     * HudDraw: A label queued for the next flush
+     */
+    struct HudDraw
+    {
+        int label;
+        float x, y;
+        Color color;
+    };
+
+    /**
+     * layout: Build label's glyph run for str at size (DrawTextEx's rules)
+     */
+    void layout(HudLabel &label, const char *str, float size);
+
+    /**
+     * glyphIndex: Atlas glyph for a character ('?' if the atlas has none)
+     */
+    int glyphIndex(int c) const;
+
+    Font font{};                    // Atlas (owned when sdfFont)
+    Shader sdfShader{};             // Distance field -> alpha (SDF atlas only)
+    bool sdfFont = false;
+    bool loaded = false;
+    int glyphLookup[128] = {};      // ASCII -> font.glyphs index (-1 = missing)
+    HudLabel labels[kMaxLabels];
+    HudDraw queue[kMaxLabels];
+    int queued = 0;
+};
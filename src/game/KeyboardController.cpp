@@ -0,0 +1,32 @@
+#include "KeyboardController.h"
+#include "raylib.h"
+
+/**
+ * beginFrame: Latch a press, sample the hold
+ */
+void KeyboardController::beginFrame()
+{
+    pressed = pressed || IsKeyPressed(KEY_SPACE);
+    held = IsKeyDown(KEY_SPACE);
+}
+
+/**
+ * input: Hand the latched press to this step (and clear it)
+ */
+FrameInput KeyboardController::input(Simulation &)
+{
+    FrameInput in;
+    in.jumpPressed = pressed;
+    in.jumpHeld = held;
+    pressed = false;  // Press consumed by this step
+    return in;
+}
+
+/**
+ * reset: Drop a press sampled before the restart
+ */
+void KeyboardController::reset()
+{
+    pressed = false;
+    held = false;
+}
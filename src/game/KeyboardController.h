@@ -0,0 +1,24 @@
+#pragma once
+
+#include "../control/Controller.h"
+
+/**
+ * KeyboardController: The human player - Space to jump, hold for height
+ *
+ * Keys are polled once per rendered frame (beginFrame); a press is
+ * latched until a step consumes it, because a frame can run zero steps
+ * (fast displays) or several (slow ones). Held state applies to every
+ * step of the frame.
+ */
+class KeyboardController : public Controller
+{
+public:
+    void beginFrame() override;
+    FrameInput input(Simulation &sim) override;
+    void reset() override;
+    const char *name() const override { return "keyboard"; }
+
+private:
+    bool pressed = false;  // Space went down since the last step
+    bool held = false;     // Space is down this frame
+};
@@ -0,0 +1,92 @@
+#include "JumpEnvelope.h"
+#include <algorithm>
+
+/**
+ * build: Closed-form trajectories of Player::update's discrete step
+ *
+ * After a press, step k (1-based) ends with velocity
+ *   v_k = jumpVelocity + k * gravity * dt + min(k, H) * jumpHoldAccel * dt
+ * where H is the number of steps the hold timer allows (counted with the
+ * same float accumulation as the player), and the ball has moved
+ *   y_n = dt * (v_1 + ... + v_n)
+ * which sums to the two arithmetic series below.
+ *
+ * The double-jump envelope takes the best press step for the second jump
+ * at every n (O(kSteps^2) adds, once per tuning).
+ */
+void JumpEnvelope::build(const GameConfig &cfg)
+{
+    const double dt = cfg.fixedTimestep;
+    stepDistance = cfg.scrollSpeed * cfg.fixedTimestep;
+    radius = cfg.radius;
+
+    // Steps the hold acceleration applies for (Player: boost while timer < maxJumpHold)
+    int held = 0;
+    for (float timer = 0.0f; timer < cfg.maxJumpHold && held < kSteps; timer += cfg.fixedTimestep)
+    {
+        held++;
+    }
+
+    for (int n = 0; n < kSteps; n++)
+    {
+        double steps = n;
+        double holdSum = (n <= held) ? steps * (steps + 1.0) * 0.5
+                                     : held * (held + 1.0) * 0.5 + (steps - held) * held;
+        double y = dt * (steps * cfg.jumpVelocity +
+                         cfg.gravity * dt * steps * (steps + 1.0) * 0.5 +
+                         cfg.jumpHoldAccel * dt * holdSum);
+        single[n] = (float)-y;
+    }
+
+    maxRise = 0.0f;
+    for (int n = 0; n < kSteps; n++)
+    {
+        float best = single[n];
+        for (int s = 0; s < n; s++)
+        {
+            best = std::max(best, single[s] + single[n - s]);
+        }
+        rise[n] = best;
+        maxRise = std::max(maxRise, best);
+    }
+}
+
+/**
+ * bestRise: Pressing e steps before the edge shifts the whole trajectory
+ * e steps earlier, so the rise at the edge-relative step n is rise[n + e]
+ * Past the table the ball has long fallen back down
+ */
+float JumpEnvelope::bestRise(int n, int early) const
+{
+    float best = -1e30f;
+    for (int k = std::max(0, n); k <= n + early && k < kSteps; k++)
+    {
+        best = std::max(best, rise[k]);
+    }
+    return best;
+}
+
+/**
+ * reachable: Envelope test at the two steps that decide the corner
+ * - Takeoff is at the first platform's right edge at the latest; the jump
+ *   can be pressed up to its whole width earlier
+ * - When the ball's center is a radius short of the next left edge it
+ *   must already be level with the top, and above it at the edge itself
+ *   (lower than that it hits the corner or the side)
+ * - The next platform is at least a few steps wide at any tuning, so a
+ *   ball that clears the corner has room to come down on it
+ */
+bool JumpEnvelope::reachable(float prevWidth, float gap, float rise, float width) const
+{
+    if (rise > maxRise || stepDistance <= 0.0f)
+    {
+        return false;
+    }
+    float edgeToEdge = gap - prevWidth;
+    int early = (int)(prevWidth / stepDistance);
+    int cornerStep = (int)((edgeToEdge - radius) / stepDistance);
+    int edgeStep = (int)(edgeToEdge / stepDistance) + 1;
+    return width > 0.0f &&
+           bestRise(cornerStep, early) >= rise &&
+           bestRise(edgeStep, early) > rise;
+}
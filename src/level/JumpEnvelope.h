@@ -0,0 +1,55 @@
+#pragma once
+
+#include "../config/Config.h"
+
+/**
+ * JumpEnvelope: How high the ball can possibly be, step by step after a jump
+ *
+ * Built in closed form from Player::update's discrete step (velocity,
+ * then position, hold acceleration for the first maxJumpHold seconds):
+ * - single[n]: rise of the ball center n steps after a fully held jump
+ *   (sum of an arithmetic velocity sequence, one piece while held and
+ *   one after)
+ * - rise[n]: highest rise any input reaches at step n - the first jump
+ *   fully held, then the second pressed at whichever step s maximizes
+ *   single[s] + single[n - s] (s = n: no second jump yet)
+ * Rises are in pixels, positive = up (screen Y is the other way round).
+ *
+ * reachable() is a necessary condition for a transition between two
+ * consecutive platforms: if the envelope can't clear the next platform's
+ * corner, no input can land on it. Platforms that pass can still be hard;
+ * DifficultyModel scores how hard.
+ */
+struct JumpEnvelope
+{
+    static const int kSteps = 512;  // Longest flight considered (4.3 s at the default step)
+
+    /**
+     * build: Tabulate the envelope for cfg's physics and fixedTimestep
+     */
+    void build(const GameConfig &cfg);
+
+    /**
+     * reachable: Can any input get from a platform onto the next one?
+     * - prevWidth: width of the platform the ball takes off from
+     * - gap: left edge to left edge (PlatformGenerator's gap)
+     * - rise: how much higher the next top is (prevTop - top)
+     * - width: width of the next platform
+     * The jump may be pressed anywhere on the first platform; the ball's
+     * center must be above the next top by the time it reaches the
+     * corner (radius before the left edge) and still at the left edge
+     */
+    bool reachable(float prevWidth, float gap, float rise, float width) const;
+
+    /**
+     * bestRise: Highest rise at step n for a jump pressed up to `early`
+     * steps before the takeoff edge (max of rise[n .. n + early])
+     */
+    float bestRise(int n, int early) const;
+
+    float single[kSteps];      // Rise n steps after one fully held jump
+    float rise[kSteps];        // Highest rise n steps after the first press
+    float maxRise = 0.0f;      // Highest rise ever reached (double jump at the first apex)
+    float stepDistance = 0.0f; // Pixels scrolled per step
+    float radius = 0.0f;       // Ball radius
+};
@@ -1,21 +1,25 @@
 #include "Level.h"
+#include "PlatformKernels.h"
+#include "../profile/Profiler.h"
 #include <algorithm>
-
-/**
- * Level constructor: Reserve space for platforms
- */
-Level::Level(int total) : totalPlatforms(total) {}
+#include <cmath>
+#include <cstring>
 
 /**
  * generate: Create the initial level layout
  * 
  * Platform Generation:
- * - Starts platforms off-screen to the right (at screenWidth + 200)
- * - Each platform is placed with random horizontal gap (minGap to maxGap)
- * - Each platform steps up by random amount (stepUpMin to stepUpMax)
- * - Platform width varies randomly (minPlatformWidth to maxPlatformWidth)
- * - Platforms never go above minPlatformY (stay below screen top)
- * - All platforms start uncounted (counted = false)
+ * - Ring is sized from the screen and spacing settings, not the level length
+ * - Platform stream restarts from cfg.seed (see PlatformGenerator for layout rules)
+ * - Camera starts at world X 0, so world and screen X coincide at the start
+ * - Platforms are generated from off-screen right up to generateAhead past
+ *   the screen edge; the rest arrive while scrolling
+ * - No platform has been scored yet (score cursor at the leftmost)
+ * - Slots are filled in increasing X order, so the ring starts at slot 0
+ * 
+ * Randomness:
+ * - Comes from the level's own seeded streams (cfg.seed), not a global generator
+ * - Same seed always gives the same platform sequence
  * 
  * Cloud Generation:
  * - Creates cloudCount decorative clouds at random positions
@@ -24,130 +28,377 @@ Level::Level(int total) : totalPlatforms(total) {}
  */
 void Level::generate(const GameConfig &cfg)
 {
-    platforms.resize(totalPlatforms);
-    clouds.resize(cfg.cloudCount);
-
-    // Platform generation starting point
-    float startX = (float)cfg.screenWidth + 200.0f;  // Start off-screen right
-    float cursor = startX;                            // Horizontal position tracker
-    float yTop = cfg.groundY - 20.0f;                // Start slightly above ground
-
-    // Generate each platform with random spacing and height
-    for (int i = 0; i < totalPlatforms; i++)
-    {
-        // Random horizontal gap from previous platform
-        float gap = (float)GetRandomValue((int)cfg.minGap, (int)cfg.maxGap);
-        cursor += gap;
-        
-        // Random platform width
-        float width = (float)GetRandomValue((int)cfg.minPlatformWidth, (int)cfg.maxPlatformWidth);
-        
-        // Random vertical step up (platforms get progressively higher)
-        float step = (float)GetRandomValue((int)cfg.stepUpMin, (int)cfg.stepUpMax);
-        yTop = std::max(cfg.minPlatformY, yTop - step);  // Don't go above screen top
-        
-        // Create platform
-        platforms[i] = {cursor, yTop, width, false};
-    }
+    resetRing(cfg);
+
+    // Restart both random streams from the level seed
+    // Clouds get their own stream so decoration never shifts the platform sequence
+    generator.reset(cfg);
+    cloudRng.seed(cfg.seed ^ 0xC10D5EEDC10D5EEDULL);
+
+    // Platforms up to generateAhead
+    fillAhead(cfg);
 
     // Generate background clouds for parallax effect
-    for (int i = 0; i < cfg.cloudCount; i++)
+    generateClouds(cfg);
+}
+
+/**
+ * load: Start a fixed stage
+ * 
+ * - Ring is sized for the stage's own spacing (it may be denser than cfg's)
+ * - The generator reads the stage instead of drawing random platforms
+ * - Clouds are drawn from where the cloud stream left off (the previous
+ *   level's storage is gone once the arena is rewound, so nothing carries over)
+ */
+void Level::load(const LevelStage &stage, const GameConfig &cfg)
+{
+    resetRing(stageLayout(stage, cfg));
+
+    generator.reset(stage, cfg);
+    fillAhead(cfg);
+    generateClouds(cfg);
+}
+
+/**
+ * stageLayout: cfg with the stage's spacing and length
+ */
+GameConfig Level::stageLayout(const LevelStage &stage, const GameConfig &cfg)
+{
+    GameConfig layout = cfg;
+    layout.minGap = stage.minGap;
+    layout.maxGap = stage.maxGap;
+    layout.maxPlatformWidth = stage.maxWidth;
+    layout.totalPlatforms = stage.count;
+    layout.endless = false;
+    return layout;
+}
+
+/**
+ * gridCellWidth: maxGap + maxPlatformWidth - a platform spans at most two
+ * cells and the ball's X range usually falls in one
+ */
+float Level::gridCellWidth(const GameConfig &layout)
+{
+    return layout.maxGap + layout.maxPlatformWidth;
+}
+
+/**
+ * gridCellSlots: Platforms touching one cell start within a cell width plus
+ * the widest platform of each other, at least minGap apart
+ */
+int Level::gridCellSlots(const GameConfig &layout)
+{
+    float reach = gridCellWidth(layout) + layout.maxPlatformWidth;
+    return (int)std::ceil(reach / std::max(1.0f, layout.minGap)) + 1;
+}
+
+/**
+ * storageBytes: Three float arrays per ring slot, the clouds and the grid
+ */
+size_t Level::storageBytes(const GameConfig &layout)
+{
+    size_t slots = (size_t)ringCapacity(layout);
+    return 3 * Arena::footprintOf<float>(slots)
+         + Arena::footprintOf<Cloud>((size_t)std::max(0, layout.cloudCount))
+         + SpatialGrid::storageBytes(gridCellWidth(layout), liveSpan(layout), (int)slots, gridCellSlots(layout));
+}
+
+/**
+ * reserveStorage: Empty the arena first - its block can only grow while
+ * nothing is carved from it
+ */
+void Level::reserveStorage(size_t bytes, int stagePlatforms)
+{
+    ownArena.reset();
+    ownArena.reserve(bytes);
+    storageBegin = nullptr;  // The old span is gone (capture refuses until the next resetRing)
+    storageSize = 0;
+    count = 0;
+    stageArena.reset();
+    stageArena.reserve(stageBytes(stagePlatforms));
+}
+
+/**
+ * stageBytes: Gap, height and width of each platform, 16 bits apiece
+ */
+size_t Level::stageBytes(int n)
+{
+    size_t platforms = (size_t)std::max(0, n);
+    return 2 * Arena::footprintOf<uint16_t>(platforms) + Arena::footprintOf<int16_t>(platforms);
+}
+
+/**
+ * packStage: The level pack's encoding (whole-pixel gaps from the previous
+ * left edge, tops and widths), plus the spacing load() sizes the ring from
+ */
+LevelStage Level::packStage(const Platform *platforms, int n)
+{
+    n = std::max(0, n);
+    stageArena.reset();
+    stageArena.reserve(stageBytes(n));
+    uint16_t *gap = stageArena.allocateArray<uint16_t>((size_t)n);
+    int16_t *top = stageArena.allocateArray<int16_t>((size_t)n);
+    uint16_t *width = stageArena.allocateArray<uint16_t>((size_t)n);
+
+    LevelStage stage;
+    stage.minGap = 65535.0f;
+    float previousX = 0.0f;
+    for (int i = 0; i < n; i++)
+    {
+        float g = platforms[i].x - previousX;
+        gap[i] = (uint16_t)g;
+        top[i] = (int16_t)platforms[i].yTop;
+        width[i] = (uint16_t)platforms[i].width;
+        previousX = platforms[i].x;
+        if (i > 0)
+        {
+            stage.minGap = std::min(stage.minGap, g);
+            stage.maxGap = std::max(stage.maxGap, g);
+        }
+        stage.maxWidth = std::max(stage.maxWidth, platforms[i].width);
+    }
+    stage.gap = gap;
+    stage.top = top;
+    stage.width = width;
+    stage.count = n;
+    return stage;
+}
+
+/**
+ * resetRing: Carve the parallel arrays, clouds and grid, mark every slot
+ * free and put the camera at 0
+ * - The arena is reset here (and only grows when a layout needs more than
+ *   any before it, or than reserveStorage sized it for)
+ * - Clouds come first: generateClouds fills them in afterwards
+ * - The carved range is remembered as the storage span capture() copies
+ */
+void Level::resetRing(const GameConfig &layout)
+{
+    ownArena.reset();
+    ownArena.reserve(storageBytes(layout));
+    Arena &arena = ownArena;
+    int overflows = arena.overflowCount();
+    unsigned char *begin = arena.top();
+
+    cameraX = 0.0;    // Camera back to the world origin
+    capacity = ringCapacity(layout);
+    clouds.allocate(arena, std::max(0, layout.cloudCount));
+    platformX.allocate(arena, capacity);
+    platformTop.allocate(arena, capacity);
+    platformWidth.allocate(arena, capacity);
+    grid.reset(gridCellWidth(layout), liveSpan(layout), capacity, gridCellSlots(layout), arena);
+
+    // Everything above is one byte range unless the arena overflowed (snapshots copy it whole)
+    unsigned char *end = arena.top();
+    bool contiguous = begin != nullptr && end != nullptr && arena.overflowCount() == overflows;
+    storageBegin = contiguous ? begin : nullptr;
+    storageSize = contiguous ? (size_t)(end - begin) : 0;
+    head = 0;         // Leftmost platform is in slot 0
+    count = 0;        // Ring starts empty
+    scoreCursor = 0;  // Nothing passed yet
+}
+
+/**
+ * capture: Scalars by assignment, then the storage span in one memcpy
+ * (~1 KB for the default settings)
+ */
+bool Level::capture(LevelSnapshot &out) const
+{
+    if (storageBegin == nullptr || storageSize > sizeof(out.storage))
     {
-        float cx = (float)GetRandomValue(0, cfg.screenWidth + 600);
-        float cy = (float)GetRandomValue(40, cfg.screenHeight / 2);  // Upper half only
-        float cw = (float)GetRandomValue(70, 130);
+        return false;
+    }
+    out.cameraX = cameraX;
+    out.count = count;
+    out.head = head;
+    out.scoreCursor = scoreCursor;
+    out.generator = generator;
+    out.cloudRng = cloudRng;
+    out.grid = grid;
+    out.storageBegin = storageBegin;
+    out.storageSize = (uint32_t)storageSize;
+    std::memcpy(out.storage, storageBegin, storageSize);
+    return true;
+}
+
+/**
+ * restore: The reverse of capture, if the storage span is the same one
+ * (the grid's arrays point into that span, so copying it back restores them)
+ */
+bool Level::restore(const LevelSnapshot &in)
+{
+    if (storageBegin == nullptr || in.storageBegin != storageBegin || in.storageSize != storageSize)
+    {
+        return false;
+    }
+    cameraX = in.cameraX;
+    count = in.count;
+    head = in.head;
+    scoreCursor = in.scoreCursor;
+    generator = in.generator;
+    cloudRng = in.cloudRng;
+    grid = in.grid;
+    std::memcpy(storageBegin, in.storage, storageSize);
+    return true;
+}
+
+/**
+ * rebase: Shift every stored X by -distance
+ * Platform X are whole pixels and distance is kRebaseX while playing, so
+ * the platforms land on exactly the same screen positions
+ */
+void Level::rebase(double distance)
+{
+    if (distance == 0.0)
+    {
+        return;
+    }
+    float shift = (float)distance;
+    for (int i = 0; i < capacity; i++)
+    {
+        platformX[i] -= shift;
+    }
+    grid.shift(-shift);
+    for (auto &c : clouds)
+    {
+        c.x -= (float)(distance * (double)c.parallax);
+    }
+    cameraX -= distance;
+}
+
+/**
+ * generateClouds: Random positions across the screen width (plus 600px
+ * to the right) in the upper half, random sizes and parallax speeds
+ * (15-35 px/s against the platforms' scrollSpeed)
+ */
+void Level::generateClouds(const GameConfig &cfg)
+{
+    for (int i = 0; i < clouds.size(); i++)
+    {
+        float cx = (float)cloudRng.range(0, cfg.screenWidth + 600);
+        float cy = (float)cloudRng.range(40, cfg.screenHeight / 2);  // Upper half only
+        float cw = (float)cloudRng.range(70, 130);
         float ch = cw * 0.6f;  // Height proportional to width
-        float speed = (float)GetRandomValue(15, 35);  // Slower than platform scroll
-        clouds[i] = {cx, cy, cw, ch, speed};
+        float parallax = (float)cloudRng.range(15, 35) / std::max(1.0f, cfg.scrollSpeed);  // Slower than platform scroll
+        clouds[i] = {cx + (float)(cameraX * (double)parallax), cy, cw, ch, parallax};
     }
 }
 
 /**
- * scroll: Move all platforms and clouds leftward to create scrolling world
+ * scroll: Move the camera right to create the scrolling world
+ * 
+ * Camera:
+ * - cameraX advances by scrollSpeed * dt; no platform is touched
+ * - Past kRebaseX the world origin follows it (rebase - every ~75 s of play)
  * 
- * Platform Scrolling:
- * - All platforms move left at scrollSpeed
- * - Track rightmost platform position for recycling
- * - When platform leaves screen (goes past left edge), recycle it:
- *   - Move it to the right of the rightmost platform
- *   - Give it new random properties (gap, width, height)
- *   - Reset counted flag so it can be scored again
+ * Platform Streaming:
+ * - Only the head (leftmost) platform can leave the screen. While it has
+ *   (right edge 60px left of the camera), drop it: unregister it from the
+ *   grid, advance head, one fewer live platform
+ * - Then stream new platforms in at the right end until the rightmost is
+ *   generateAhead past the screen edge (fillAhead)
  * 
  * Cloud Parallax:
- * - Clouds move at their individual speeds (slower than platforms)
+ * - Clouds follow the camera through their own slower layers
  * - When cloud leaves left edge, respawn on right with new properties
  * - Creates depth illusion (slower = farther away)
  */
 void Level::scroll(float dt, const GameConfig &cfg)
 {
-    // Find rightmost platform position (for recycling)
-    float rightMost = 0.0f;
-    for (int i = 0; i < totalPlatforms; i++)
+    PROFILE_SCOPE(Scroll);
+
+    // Move the camera
+    cameraX += (double)(cfg.scrollSpeed * dt);
+    if (cameraX >= kRebaseX)
     {
-        platforms[i].x -= cfg.scrollSpeed * dt;  // Move left
-        if (platforms[i].x > rightMost)
-        {
-            rightMost = platforms[i].x;
-        }
+        rebase(kRebaseX);
     }
 
-    // Recycle platforms that leave the screen
-    for (int i = 0; i < totalPlatforms; i++)
+    // Drop platforms that left the screen
+    float dropX = worldX(-60.0f);
+    while (count > 0 && platformX[head] + platformWidth[head] < dropX)
     {
-        // Platform is off-screen left (plus margin)
-        if (platforms[i].x + platforms[i].width < -60.0f)
-        {
-            // Generate new random properties
-            float gap = (float)GetRandomValue((int)cfg.minGap, (int)cfg.maxGap);
-            float width = (float)GetRandomValue((int)cfg.minPlatformWidth, (int)cfg.maxPlatformWidth);
-            float step = (float)GetRandomValue((int)cfg.stepUpMin, (int)cfg.stepUpMax);
-            float newY = std::max(cfg.minPlatformY, platforms[i].yTop - step);
-            
-            // Respawn to right of rightmost platform
-            platforms[i] = {rightMost + gap, newY, width, false};
-            rightMost = platforms[i].x;  // Update rightmost tracker
-        }
+        // Advance head; score cursor is relative to head, so it shifts with it
+        grid.remove(head);
+        head = (head + 1 == capacity) ? 0 : head + 1;
+        count--;
+        scoreCursor = std::max(0, scoreCursor - 1);
     }
 
+    // New platforms ahead of the viewport
+    fillAhead(cfg);
+
     // Parallax clouds (slower scrolling for depth)
     for (auto &c : clouds)
     {
-        c.x -= c.speed * dt;  // Each cloud has individual speed
-        
         // Respawn cloud when it leaves left edge
-        if (c.x + c.w < -40.0f)
+        if (cloudScreenX(c, cameraX) + c.w < -40.0f)
         {
-            c.x = (float)cfg.screenWidth + (float)GetRandomValue(80, 280);
-            c.y = (float)GetRandomValue(40, cfg.screenHeight / 2);
-            c.w = (float)GetRandomValue(70, 130);
+            float cx = (float)cfg.screenWidth + (float)cloudRng.range(80, 280);
+            c.y = (float)cloudRng.range(40, cfg.screenHeight / 2);
+            c.w = (float)cloudRng.range(70, 130);
             c.h = c.w * 0.6f;
-            c.speed = (float)GetRandomValue(15, 35);
+            c.parallax = (float)cloudRng.range(15, 35) / std::max(1.0f, cfg.scrollSpeed);
+            c.x = cx + (float)(cameraX * (double)c.parallax);
         }
     }
 }
 
+/**
+ * fillAhead: Pull platforms from the generator while the stream is behind
+ * 
+ * - The rightmost live platform is at ring offset count - 1 (an empty ring
+ *   measures from the generator's start position)
+ * - Each new platform is registered with the grid under its slot
+ * - Stops once the rightmost left edge is generateAhead past the screen's right edge,
+ *   the ring is full, or a finite level has produced all of its platforms
+ * - Scrolling moves at most a few pixels per step, so this appends at most
+ *   one platform per call after generate()
+ */
+void Level::fillAhead(const GameConfig &cfg)
+{
+    float limitX = worldX((float)cfg.screenWidth + cfg.generateAhead);
+    float lastX = (count > 0) ? platformX[slot(count - 1)] : PlatformGenerator::startX(cfg);
+    while (count < capacity && lastX < limitX && !generator.exhausted(cfg))
+    {
+        int i = slot(count);
+        generator.next(lastX, cfg, platformX[i], platformTop[i], platformWidth[i]);
+        grid.insert(i, platformX[i], platformWidth[i]);
+        lastX = platformX[i];
+        count++;
+    }
+}
+
 /**
  * awardScore: Check which platforms the ball has fully passed
  * 
  * Scoring Logic:
  * - Platform counts as "passed" when its right edge is left of ball's left edge
- * - Each platform can only be counted once (prevents double-scoring)
+ *   (ball X converted to world X once)
+ * - Platforms are X-ordered and all scroll at the same speed, so passed
+ *   platforms are always a prefix of the ring - the score cursor marks its end
+ * - Advance the cursor while the platform under it has been passed
+ *   (O(1) amortized; each platform is visited once, so no double-scoring)
  * - Returns number of newly passed platforms this frame
  * 
  * Win Condition:
- * - When score reaches totalPlatforms, level is complete
+ * - When score reaches totalPlatforms, level is complete (never in endless mode)
  */
 int Level::awardScore(float ballX, float radius)
 {
+    PROFILE_SCOPE(AwardScore);
+
     int gained = 0;
-    for (int i = 0; i < totalPlatforms; i++)
+    float passedX = worldX(ballX) - radius;
+    while (scoreCursor < count)
     {
-        // Check if platform is fully behind the ball and not yet counted
-        if (!platforms[i].counted && platforms[i].x + platforms[i].width < ballX - radius)
+        int i = slot(scoreCursor);
+        if (platformX[i] + platformWidth[i] >= passedX)
         {
-            platforms[i].counted = true;  // Mark as scored
-            gained += 1;
+            break;  // Next platform is still ahead of the ball
         }
+        scoreCursor++;
+        gained += 1;
     }
     return gained;
 }
@@ -159,6 +410,9 @@ int Level::awardScore(float ballX, float radius)
  * - Uses circle-rectangle collision (closest point method)
  * - Finds closest point on platform rectangle to ball center
  * - If distance from ball center to closest point < radius, collision occurred
+ * - Tests run in world X (ball X converted once, platforms as stored)
+ * - Only the active window (platforms under the ball) is tested, using the
+ *   SIMD kernel for this CPU (same result as the scalar loop)
  * 
  * Game Rule:
  * - Hitting platform sides/bottom = instant death (game over)
@@ -166,25 +420,20 @@ int Level::awardScore(float ballX, float radius)
  */
 bool Level::checkCollision(float ballX, float ballY, float radius, const GameConfig &cfg) const
 {
-    for (int i = 0; i < totalPlatforms; i++)
-    {
-        // Platform rectangle bounds
-        float rx = platforms[i].x;
-        float ry = platforms[i].yTop;
-        float rw = platforms[i].width;
-        float rh = cfg.platformHeight;
-
-        // Find closest point on rectangle to ball center
-        float closestX = (ballX < rx) ? rx : (ballX > rx + rw ? rx + rw : ballX);
-        float closestY = (ballY < ry) ? ry : (ballY > ry + rh ? ry + rh : ballY);
-        
-        // Calculate distance from ball center to closest point
-        float dx = ballX - closestX;
-        float dy = ballY - closestY;
-        float distSq = dx * dx + dy * dy;
-        
-        // Collision if distance < radius
-        if (distSq < radius * radius)
+    PROFILE_SCOPE(CheckCollision);
+
+    // Only platforms overlapping the ball's X extent (1px margin keeps it conservative)
+    float wx = worldX(ballX);
+    PlatformWindow window = activeWindow(wx - radius - 1.0f, wx + radius + 1.0f);
+
+    int start[2], length[2];
+    int spans = splitWindow(window, start, length);
+    for (int s = 0; s < spans; s++)
+    {
+        int i = start[s];
+        if (platformKernels().anyCollision(
+                &platformX[i], &platformTop[i], &platformWidth[i], length[s],
+                wx, ballY, radius, cfg.platformHeight))
         {
             return true;
         }
@@ -196,7 +445,7 @@ bool Level::checkCollision(float ballX, float ballY, float radius, const GameCon
  * resolveLanding: Handle ball landing on platform tops or ground
  * 
  * Landing Detection (only when falling - vy >= 0):
- * 1. Check each platform top surface
+ * 1. Check each platform top surface in the active window under the ball
  * 2. Ball must be:
  *    - Horizontally aligned (ballX between platform left and right edges)
  *    - Just crossing platform top (current Y below, previous Y above)
@@ -216,6 +465,8 @@ bool Level::checkCollision(float ballX, float ballY, float radius, const GameCon
  */
 bool Level::resolveLanding(float ballX, float prevY, float &y, float &vy, float radius, const GameConfig &cfg, bool &landedOnGround)
 {
+    PROFILE_SCOPE(ResolveLanding);
+
     float targetY = cfg.groundY;  // Default to ground level
     bool landed = false;
     landedOnGround = false;
@@ -223,27 +474,228 @@ bool Level::resolveLanding(float ballX, float prevY, float &y, float &vy, float
     // Only check landing when falling (moving downward)
     if (vy >= 0.0f)
     {
-        // Check all platform tops
-        for (int i = 0; i < totalPlatforms; i++)
+        // Highest platform top crossed this frame, among platforms under the ball (world X)
+        float wx = worldX(ballX);
+        PlatformWindow window = activeWindow(wx - 1.0f, wx + 1.0f);
+
+        int start[2], length[2];
+        int spans = splitWindow(window, start, length);
+        for (int s = 0; s < spans; s++)
         {
-            float top = platforms[i].yTop;
-            float left = platforms[i].x;
-            float right = platforms[i].x + platforms[i].width;
-            
-            // Check if ball just crossed this platform's top surface
-            if (y + radius >= top &&           // Current frame: below or touching top
-                prevY + radius <= top &&       // Previous frame: above top
-                left <= ballX &&               // Horizontally within platform
-                right >= ballX)
+            int i = start[s];
+            targetY = platformKernels().highestLanding(
+                &platformX[i], &platformTop[i], &platformWidth[i], length[s],
+                wx, prevY, y, radius, targetY
+            );
+        }
+        landed = targetY < cfg.groundY;
+    }
+
+    // Apply landing or ground collision
+    if (landed)
+    {
+        // Landed on a platform - snap to top surface
+        y = targetY - radius;
+        vy = 0.0f;
+    }
+    else if (y > cfg.groundY)
+    {
+        // Fell past ground level - snap to ground
+        y = cfg.groundY;
+        vy = 0.0f;
+        landed = true;
+        landedOnGround = true;  // Flag for death condition
+    }
+
+    return landed;
+}
+
+// ===== Swept Circle vs Rectangle =====
+
+/**
+ * slabTimes: When a point moving p0 + d*t is strictly between lo and hi
+ * on one axis - the open interval (enter, exit) of t
+ * Returns false if it never is (standing still outside the slab)
+ */
+static bool slabTimes(float p0, float d, float lo, float hi, float &enter, float &exit)
+{
+    if (d == 0.0f)
+    {
+        enter = -INFINITY;
+        exit = INFINITY;
+        return p0 > lo && p0 < hi;
+    }
+    float t1 = (lo - p0) / d;
+    float t2 = (hi - p0) / d;
+    enter = std::min(t1, t2);
+    exit = std::max(t1, t2);
+    return true;
+}
+
+/**
+ * sweepBox: First t >= 0 at which the moving point is inside an open box
+ * Time of impact in both axes: inside once inside both slabs, so the entry
+ * is the later of the two axis entries
+ */
+static bool sweepBox(float x0, float y0, float dx, float dy,
+                     float minX, float minY, float maxX, float maxY, float &t)
+{
+    float enterX, exitX, enterY, exitY;
+    if (!slabTimes(x0, dx, minX, maxX, enterX, exitX) || !slabTimes(y0, dy, minY, maxY, enterY, exitY))
+    {
+        return false;
+    }
+    float enter = std::max(0.0f, std::max(enterX, enterY));
+    float exit = std::min(exitX, exitY);
+    t = enter;
+    return enter < exit;
+}
+
+/**
+ * sweepCorner: First t >= 0 at which the moving point is closer than r
+ * to a corner (smaller root of |p0 + d*t - c|^2 = r^2)
+ */
+static bool sweepCorner(float x0, float y0, float dx, float dy, float cx, float cy, float r, float &t)
+{
+    float mx = x0 - cx, my = y0 - cy;
+    float c = mx * mx + my * my - r * r;
+    if (c < 0.0f)
+    {
+        t = 0.0f;  // Already touching
+        return true;
+    }
+    float a = dx * dx + dy * dy;
+    float b = mx * dx + my * dy;
+    if (a == 0.0f || b >= 0.0f)
+    {
+        return false;  // Not moving, or moving away
+    }
+    float disc = b * b - a * c;
+    if (disc <= 0.0f)
+    {
+        return false;  // Passes it at r or farther
+    }
+    t = (-b - std::sqrt(disc)) / a;
+    return true;
+}
+
+/**
+ * sweepCircleRect: Does a circle of radius r moving from (x0, y0) by
+ * (dx, dy) come closer than r to the rectangle [left, right] x [top, bottom]
+ * at some t in [0, 1)?
+ * - Points closer than r to the rectangle form its Minkowski sum with the
+ *   circle: the rectangle grown by r in X, grown by r in Y, and a circle
+ *   around each corner. The segment is inside the sum from the first time
+ *   it is inside any of those six pieces
+ * - t = 1 is excluded: the end position is checkCollision's test
+ */
+static bool sweepCircleRect(float x0, float y0, float dx, float dy, float r,
+                            float left, float top, float right, float bottom)
+{
+    // Segment's bounding box grown by r misses the rectangle: nothing to solve
+    if (std::max(y0, y0 + dy) + r <= top || std::min(y0, y0 + dy) - r >= bottom ||
+        std::max(x0, x0 + dx) + r <= left || std::min(x0, x0 + dx) - r >= right)
+    {
+        return false;
+    }
+
+    float t;
+    if (sweepBox(x0, y0, dx, dy, left - r, top, right + r, bottom, t) && t < 1.0f) return true;
+    if (sweepBox(x0, y0, dx, dy, left, top - r, right, bottom + r, t) && t < 1.0f) return true;
+    if (sweepCorner(x0, y0, dx, dy, left, top, r, t) && t < 1.0f) return true;
+    if (sweepCorner(x0, y0, dx, dy, right, top, r, t) && t < 1.0f) return true;
+    if (sweepCorner(x0, y0, dx, dy, left, bottom, r, t) && t < 1.0f) return true;
+    if (sweepCorner(x0, y0, dx, dy, right, bottom, r, t) && t < 1.0f) return true;
+    return false;
+}
+
+/**
+ * crossingTime: When the path y(t) = y0 + b*t + c*t^2 (ending at y1)
+ * reaches target, given y0 <= target <= y1
+ * - Exactly one root lies in [0, 1] then (the path is a parabola piece);
+ *   the other root, if any, is outside
+ * - Numerically stable form (no cancellation between -b and the root)
+ */
+static float crossingTime(float y0, float b, float y1, float target)
+{
+    float c = y1 - y0 - b;
+    float k = y0 - target;  // <= 0
+    float t;
+    if (std::fabs(c) < 1e-6f)
+    {
+        float slope = y1 - y0;
+        t = (slope > 0.0f) ? -k / slope : 0.0f;
+    }
+    else
+    {
+        float disc = std::max(0.0f, b * b - 4.0f * c * k);
+        float q = -0.5f * (b + std::copysign(std::sqrt(disc), b));
+        float t1 = q / c;
+        float t2 = (q != 0.0f) ? k / q : t1;
+        bool in1 = t1 >= 0.0f && t1 <= 1.0f;
+        bool in2 = t2 >= 0.0f && t2 <= 1.0f;
+        t = (in1 && in2) ? std::min(t1, t2) : (in1 ? t1 : t2);
+    }
+    return std::min(1.0f, std::max(0.0f, t));
+}
+
+/**
+ * resolveLandingSwept: resolveLanding with the X test at crossing time
+ *
+ * - Same candidates as resolveLanding (falling, top between the start and
+ *   end of the step), but under the whole X range the step covered
+ * - Each top's crossing time comes from the step's vertical path; the
+ *   ball lands on it if its centre is over the top at that moment
+ *   (x0 + sweepX * t)
+ * - Y only grows while crossing tops, so the highest qualifying top is
+ *   also the first one hit
+ * - If the centre passes the top's right edge later in the step, the ball
+ *   rolled off it then (leaveTime); Simulation lets it fall from there
+ * - Ground: snapped as before, landTime = when the ball reached it
+ */
+bool Level::resolveLandingSwept(float ballX, float sweepX, float prevY, float prevDrop, float &y, float &vy,
+                                float radius, const GameConfig &cfg, bool &landedOnGround,
+                                float &landTime, float &leaveTime)
+{
+    PROFILE_SCOPE(ResolveLanding);
+
+    float targetY = cfg.groundY;  // Default to ground level
+    bool landed = false;
+    landedOnGround = false;
+    landTime = 1.0f;
+    leaveTime = 1.0f;
+
+    // Only check landing when falling (moving downward)
+    if (vy >= 0.0f)
+    {
+        // Platforms under any point of the step's X range (world X)
+        float wx = worldX(ballX);
+        float x0 = wx - sweepX;
+        PlatformWindow window = activeWindow(x0 - 1.0f, wx + 1.0f);
+
+        int start[2], length[2];
+        int spans = splitWindow(window, start, length);
+        for (int s = 0; s < spans; s++)
+        {
+            for (int i = start[s]; i < start[s] + length[s]; i++)
             {
-                // Land on highest qualifying platform
-                if (top < targetY)
+                float top = platformTop[i];
+                if (top >= targetY || prevY + radius > top || y + radius < top)
+                {
+                    continue;  // Not above the best so far, or not crossed this step
+                }
+                float t = crossingTime(prevY, prevDrop, y, top - radius);
+                float crossX = x0 + sweepX * t;
+                float right = platformX[i] + platformWidth[i];
+                if (crossX >= platformX[i] && crossX <= right)
                 {
                     targetY = top;
-                    landed = true;
+                    landTime = t;
+                    leaveTime = (wx > right) ? std::max(t, (right - x0) / sweepX) : 1.0f;
                 }
             }
         }
+        landed = targetY < cfg.groundY;
     }
 
     // Apply landing or ground collision
@@ -256,6 +708,7 @@ bool Level::resolveLanding(float ballX, float prevY, float &y, float &vy, float
     else if (y > cfg.groundY)
     {
         // Fell past ground level - snap to ground
+        landTime = (prevY <= cfg.groundY) ? crossingTime(prevY, prevDrop, y, cfg.groundY) : 0.0f;
         y = cfg.groundY;
         vy = 0.0f;
         landed = true;
@@ -266,44 +719,214 @@ bool Level::resolveLanding(float ballX, float prevY, float &y, float &vy, float
 }
 
 /**
- * drawPlatforms: Render all platforms with vertical camera offset
- * 
- * Camera System:
- * - cameraOffsetY shifts all Y coordinates for vertical scrolling
- * - As ball climbs higher, camera follows (offset becomes more negative)
- * - This keeps ball in visible area while showing vertical progress
+ * checkCollisionSwept: checkCollision along a segment
+ * - Every platform under the segment's X range is tested with
+ *   sweepCircleRect (scalar: coarse steps make few calls) for a circle
+ *   tolerance smaller than the ball
+ * - Simulation sweeps the step's chord up to the landing point (or the
+ *   end), then the roll along the surface after a landing
+ */
+bool Level::checkCollisionSwept(float fromX, float fromY, float toX, float toY, float radius, float tolerance,
+                                const GameConfig &cfg) const
+{
+    PROFILE_SCOPE(CheckCollision);
+
+    radius -= tolerance;
+
+    float x0 = worldX(fromX);
+    float x1 = worldX(toX);
+    PlatformWindow window = activeWindow(std::min(x0, x1) - radius - 1.0f, std::max(x0, x1) + radius + 1.0f);
+
+    int start[2], length[2];
+    int spans = splitWindow(window, start, length);
+    for (int s = 0; s < spans; s++)
+    {
+        for (int i = start[s]; i < start[s] + length[s]; i++)
+        {
+            float left = platformX[i];
+            float top = platformTop[i];
+            if (sweepCircleRect(x0, fromY, x1 - x0, toY - fromY, radius,
+                                left, top, left + platformWidth[i], top + cfg.platformHeight))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// ===== Batched Queries =====
+
+/**
+ * resolveLandingBatch: resolveLanding for many balls in one pass
+ * - The window under the ball is the same for every ball (same X), so it
+ *   is looked up once; each platform is loaded once and tested against
+ *   every ball (the inner loop has no branches and vectorizes)
+ * - Per ball the test and the min are highestLandingScalar's, so every
+ *   ball gets the same target as its own resolveLanding call
+ * - Rising balls (vy < 0) take no platform, like resolveLanding; the scan
+ *   is skipped when every ball is rising
  */
-void Level::drawPlatforms(const GameConfig &cfg, float cameraOffsetY) const
+void Level::resolveLandingBatch(float ballX, int balls, const float *prevY, float *y, float *vy, float radius,
+                                const GameConfig &cfg, bool *landed, bool *landedOnGround) const
 {
-    for (int i = 0; i < totalPlatforms; i++)
+    PROFILE_SCOPE(ResolveLanding);
+
+    balls = std::min(balls, kMaxBatchBalls);
+    float targetY[kMaxBatchBalls];
+    bool anyFalling = false;
+    for (int b = 0; b < balls; b++)
     {
-        float rx = platforms[i].x;
-        float ry = platforms[i].yTop - cameraOffsetY;  // Apply camera offset
-        DrawRectangle((int)rx, (int)ry, (int)platforms[i].width, (int)cfg.platformHeight, GOLD);
+        targetY[b] = cfg.groundY;
+        anyFalling = anyFalling || vy[b] >= 0.0f;
+    }
+
+    if (anyFalling)
+    {
+        float wx = worldX(ballX);
+        PlatformWindow window = activeWindow(wx - 1.0f, wx + 1.0f);
+
+        int start[2], length[2];
+        int spans = splitWindow(window, start, length);
+        for (int s = 0; s < spans; s++)
+        {
+            for (int i = start[s]; i < start[s] + length[s]; i++)
+            {
+                float top = platformTop[i];
+                float left = platformX[i];
+                float right = platformX[i] + platformWidth[i];
+                if (!(left <= wx && right >= wx))
+                {
+                    continue;  // Not under the balls (same for all of them)
+                }
+                for (int b = 0; b < balls; b++)
+                {
+                    bool crossed = vy[b] >= 0.0f && y[b] + radius >= top && prevY[b] + radius <= top;
+                    targetY[b] = (crossed && top < targetY[b]) ? top : targetY[b];
+                }
+            }
+        }
+    }
+
+    // Apply landing or ground collision per ball (as resolveLanding)
+    for (int b = 0; b < balls; b++)
+    {
+        landed[b] = targetY[b] < cfg.groundY;
+        landedOnGround[b] = false;
+        if (landed[b])
+        {
+            y[b] = targetY[b] - radius;
+            vy[b] = 0.0f;
+        }
+        else if (y[b] > cfg.groundY)
+        {
+            y[b] = cfg.groundY;
+            vy[b] = 0.0f;
+            landed[b] = true;
+            landedOnGround[b] = true;
+        }
+    }
+}
+
+/**
+ * checkCollisionBatch: checkCollision for many balls in one pass
+ * - One window lookup; per platform the X half of the closest-point test
+ *   is shared (all balls have the same X), the Y half is done per ball
+ * - Same float operations as anyCollisionScalar, so hit[b] equals
+ *   checkCollision for ball b
+ */
+void Level::checkCollisionBatch(float ballX, int balls, const float *ballY, float radius,
+                                const GameConfig &cfg, bool *hit) const
+{
+    PROFILE_SCOPE(CheckCollision);
+
+    balls = std::min(balls, kMaxBatchBalls);
+    for (int b = 0; b < balls; b++)
+    {
+        hit[b] = false;
+    }
+
+    float wx = worldX(ballX);
+    PlatformWindow window = activeWindow(wx - radius - 1.0f, wx + radius + 1.0f);
+
+    int start[2], length[2];
+    int spans = splitWindow(window, start, length);
+    for (int s = 0; s < spans; s++)
+    {
+        for (int i = start[s]; i < start[s] + length[s]; i++)
+        {
+            float rx = platformX[i];
+            float ry = platformTop[i];
+            float rw = platformWidth[i];
+            float rh = cfg.platformHeight;
+            float closestX = (wx < rx) ? rx : (wx > rx + rw ? rx + rw : wx);
+            float dx = wx - closestX;
+            for (int b = 0; b < balls; b++)
+            {
+                float closestY = (ballY[b] < ry) ? ry : (ballY[b] > ry + rh ? ry + rh : ballY[b]);
+                float dy = ballY[b] - closestY;
+                hit[b] = hit[b] || dx * dx + dy * dy < radius * radius;
+            }
+        }
     }
 }
 
 /**
- * drawSky: Render background elements (sun and clouds) with camera offset
+ * activeWindow: Find the run of platforms overlapping [minX, maxX]
  * 
- * Background Elements:
- * - Sun: Fixed position in top-left, moves with camera to stay visible
- * - Clouds: Multiple overlapping ellipses create puffy cloud shapes
- * - Camera offset applied so background scrolls with vertical movement
+ * - Broadphase: the grid visits the platforms in the cells under the range
+ *   (a superset of the answer); keep the lowest and highest ring offset
+ * - Platforms are X-ordered with increasing right edges, so everything
+ *   between those offsets is a candidate too
+ * - Narrowphase: within the candidates, skip the prefix that ends left of
+ *   minX, then take platforms until one starts right of maxX
+ * - Cost is the platforms in one or two cells, however many are live
  */
-void Level::drawSky(const GameConfig &cfg, float cameraOffsetY) const
+PlatformWindow Level::activeWindow(float minX, float maxX) const
 {
-    // Sun in top-left corner
-    DrawCircle(60, (int)(60 - cameraOffsetY), 40, YELLOW);
-    
-    // Draw each cloud as overlapping ellipses
-    for (const auto &c : clouds)
+    int lo = count;
+    int hi = -1;
+    grid.query(minX, maxX, [&](int i)
+    {
+        int k = (i >= head) ? i - head : i + capacity - head;  // Slot -> ring offset
+        lo = std::min(lo, k);
+        hi = std::max(hi, k);
+    });
+
+    int k = lo;
+    while (k <= hi && platformX[slot(k)] + platformWidth[slot(k)] < minX)
+    {
+        k++;
+    }
+    int first = k;
+    while (k <= hi && platformX[slot(k)] <= maxX)
+    {
+        k++;
+    }
+    return {first, k - first};
+}
+
+/**
+ * splitWindow: Turn a window (ring offsets) into contiguous slot ranges
+ * A window that wraps past the end of the arrays becomes two ranges
+ * Returns the number of ranges written (0, 1 or 2)
+ */
+int Level::splitWindow(PlatformWindow window, int start[2], int length[2]) const
+{
+    if (window.count <= 0)
+    {
+        return 0;
+    }
+    int first = slot(window.first);
+    int untilEnd = capacity - first;
+    start[0] = first;
+    if (window.count <= untilEnd)
     {
-        float cy = c.y - cameraOffsetY;  // Apply camera offset
-        
-        // Cloud made of 3 overlapping ellipses for puffy appearance
-        DrawEllipse((int)c.x, (int)cy, c.w * 0.6f, c.h * 0.6f, WHITE);
-        DrawEllipse((int)(c.x + c.w * 0.2f), (int)(cy - c.h * 0.2f), c.w * 0.5f, c.h * 0.5f, WHITE);
-        DrawEllipse((int)(c.x - c.w * 0.2f), (int)(cy - c.h * 0.1f), c.w * 0.55f, c.h * 0.55f, WHITE);
+        length[0] = window.count;
+        return 1;
     }
+    length[0] = untilEnd;
+    start[1] = 0;
+    length[1] = window.count - untilEnd;
+    return 2;
 }
@@ -1,105 +1,433 @@
 #pragma once
 
-#include "raylib.h"
-#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include "../config/Config.h"
+#include "../memory/Arena.h"
+#include "../sim/Rng.h"
+#include "PlatformGenerator.h"
+#include "SpatialGrid.h"
 
 /**
  * Platform: Represents a single climbable platform
  * Platforms form the level - player must jump from platform to platform
  * without touching the ground after the first jump
+ * (Level stores platforms as parallel arrays; this is the per-platform view)
  */
 struct Platform
 {
     float x;           // Left edge X position (world coordinates)
     float yTop;        // Top surface Y position (where player lands)
     float width;       // Platform width in pixels
-    bool counted;      // Has this platform been scored? (prevents double-counting)
+};
+
+/**
+ * PlatformWindow: A run of consecutive platforms in X order
+ * Offsets are relative to the ring head: offset k lives in slot (head + k) % capacity
+ */
+struct PlatformWindow
+{
+    int first;         // Ring offset of the first platform in the window
+    int count;         // Number of platforms in the window
 };
 
 /**
  * Cloud: Decorative parallax background element
- * Clouds move slower than platforms to create depth illusion
+ * Clouds move slower than platforms to create depth illusion: each lives
+ * in its own parallax layer that scrolls `parallax` times as far as the camera
+ * (screen X = x - cameraX * parallax, see Level::cloudScreenX)
  */
 struct Cloud
 {
-    float x;           // Center X position
+    float x;           // Center X in its parallax layer
     float y;           // Center Y position  
     float w;           // Width
     float h;           // Height
-    float speed;       // Horizontal scroll speed (slower than platform scroll)
+    float parallax;    // Fraction of the camera's scrolling (speed / scrollSpeed, < 1)
+};
+
+/**
+ * LevelSnapshot: A Level's mutable state, copied out for a later restore
+ * - Scalars (camera, ring cursors, generator and cloud streams, grid origin)
+ *   plus a byte copy of the level's storage span (ring arrays, clouds,
+ *   grid cells), which Level carves as one contiguous arena range
+ * - Plain data: snapshots can be copied, stored and compared with memcpy
+ * - Only restorable into the Level it was taken from while that level's
+ *   storage is unchanged (same run, or a later run whose generate/load
+ *   carved the same span)
+ */
+struct LevelSnapshot
+{
+    static const int kStorageBytes = 4096;  // Largest storage span a snapshot holds (see Level::snapshotFits)
+
+    double cameraX;                   // Level::cameraX
+    int count;                        // Level::count
+    int head;                         // Level::head
+    int scoreCursor;                  // Level::scoreCursor
+    PlatformGenerator generator;      // Stream position
+    Rng cloudRng;                     // Cloud stream position
+    SpatialGrid grid;                 // Origin and overflow list length (arrays are in storage)
+    const unsigned char *storageBegin;  // Span the bytes came from (identity check on restore)
+    uint32_t storageSize;             // Bytes used in storage
+    unsigned char storage[kStorageBytes];  // Copy of the storage span
 };
 
 /**
  * Level: Manages the scrolling platform world and background
  * 
  * Responsibilities:
- * - Generate random platforms with increasing height
- * - Scroll platforms and clouds leftward each frame
- * - Recycle off-screen platforms to the right
+ * - Stream platforms from a PlatformGenerator just ahead of the viewport
+ * - Scroll the camera rightward over the world each frame
+ * - Drop off-screen platforms on the left
  * - Collision detection (ball hitting platform sides = death)
  * - Landing resolution (ball landing on platform tops = safe)
  * - Score tracking (award points when ball passes platforms)
- * - Rendering platforms and sky elements with camera offset
+ * 
+ * Rendering lives in LevelRenderer, so Level builds and links without raylib
+ * 
+ * Camera:
+ * - Platforms are stored in fixed world coordinates and never move;
+ *   cameraX (world X at the left screen edge) is the only thing scrolling
+ *   is written to, so scroll() costs the same for any number of platforms
+ *   and the platform arrays are only written when platforms stream in
+ * - Queries take the ball's screen X and convert it once (worldX); drawing
+ *   subtracts the camera (the horizontal partner of Simulation::cameraOffsetY)
+ * - cameraX is a double and pulled back by kRebaseX now and then (platforms,
+ *   clouds and grid move with it), so world X stays small and float
+ *   precision is the same after an hour of endless play as at the start
+ *
+ * Storage:
+ * - Platforms live in a ring buffer of `capacity` slots, stored as
+ *   parallel arrays (x, yTop, width) for the SIMD kernels
+ * - capacity only depends on the screen and spacing settings (enough for
+ *   every platform between the left drop edge and generateAhead), so memory
+ *   and generate() cost are the same for 200 platforms, 1M or endless mode
+ * - head is the leftmost platform and count the live ones; walking the
+ *   ring from head visits platforms in increasing X (new ones are appended
+ *   at the right end)
+ * - Per-frame queries only touch the active window of platforms near the
+ *   ball or on screen, found through a SpatialGrid broadphase (handle = ring
+ *   slot): platforms are registered as they stream in and removed as they
+ *   are dropped
+ * - Scoring is a cursor into the ring: everything before it has been passed
+ * - The arrays, clouds and grid cells are carved from Level's own Arena
+ *   by generate()/load(), reset before each new level; sized once up front
+ *   (reserveStorage), a restart then costs a cursor reset, never a heap
+ *   round trip. Moving a Level keeps its storage, so two Levels (or the
+ *   Simulations holding them) can be swapped in O(1)
+ * - A stage built at reset time (packStage) lives in the level's second
+ *   arena and is swapped with it the same way
  */
 class Level
 {
 public:
-    explicit Level(int totalPlatforms);
-
     /**
      * generate: Create initial platform layout
-     * - Generates all platforms starting from right side of screen
-     * - Each platform steps up randomly (creating vertical challenge)
+     * - Sizes the ring and restarts the platform stream from cfg.seed
+     * - Generates platforms from the right side of the screen up to generateAhead
      * - Also generates parallax cloud decorations
+     * - Storage is carved fresh from the arena (see reserveStorage)
      */
     void generate(const GameConfig &cfg);
+
+    /**
+     * load: Play a fixed stage instead of a generated layout
+     * - Platforms are read from the stage as they scroll into range
+     *   (no random numbers; no allocation once the ring is big enough)
+     * - Clouds continue the cloud stream of the previous level (new sky,
+     *   no reseeding)
+     * - The stage ends after its last platform, whatever cfg.endless says
+     */
+    void load(const LevelStage &stage, const GameConfig &cfg);
     
     /**
-     * scroll: Move all platforms and clouds leftward
-     * - Platforms scroll at scrollSpeed
-     * - Clouds scroll at their individual slower speeds (parallax effect)
-     * - Recycles off-screen platforms to maintain infinite level
+     * reserveStorage: Size the arena for layouts of up to `bytes`
+     * (storageBytes) up front, so no later generate()/load() allocates,
+     * and the stage storage for packStage lists of up to stagePlatforms
+     * Drops the current ring - call before generate()/load()
+     */
+    void reserveStorage(size_t bytes, int stagePlatforms = 0);
+
+    /**
+     * packStage: A platform list (x from PlatformGenerator::startX, as
+     * CurveGenerator builds it) as a stage this level owns - load() it
+     * - Kept in a second arena, outside the span snapshots copy, that moves
+     *   with the level: a swapped-in level brings its stage along
+     * - Valid until the next packStage or reserveStorage
+     */
+    LevelStage packStage(const Platform *platforms, int n);
+
+    /**
+     * capture: Copy the level's state into out (a scalar copy and one memcpy)
+     * Returns false if the storage span doesn't fit a snapshot or isn't
+     * contiguous (the arena overflowed while carving it) - the first can't
+     * happen for a layout that passed snapshotFits
+     */
+    bool capture(LevelSnapshot &out) const;
+
+    /**
+     * restore: Put back a state captured from this level
+     * Returns false (and changes nothing) if the snapshot belongs to other storage
+     */
+    bool restore(const LevelSnapshot &in);
+
+    /**
+     * storageBytes: Arena bytes generate()/load() take for a layout
+     * (the ring arrays, clouds and grid)
+     */
+    static size_t storageBytes(const GameConfig &layout);
+
+    /**
+     * snapshotFits: Whether every level of a layout can be captured
+     * (storageBytes, padding included, within LevelSnapshot::kStorageBytes)
+     * Callers that checkpoint reject a layout that doesn't up front;
+     * capture() would fail on every call for it
+     */
+    static bool snapshotFits(const GameConfig &layout)
+    {
+        return storageBytes(layout) <= (size_t)LevelSnapshot::kStorageBytes;
+    }
+
+    /**
+     * stageLayout: The settings load() sizes the ring from for a stage
+     * (cfg with the stage's spacing, length and no endless mode)
+     */
+    static GameConfig stageLayout(const LevelStage &stage, const GameConfig &cfg);
+
+    /**
+     * scroll: Move the camera right by scrollSpeed * dt
+     * - Platforms stay put (world coordinates); clouds follow through their
+     *   parallax layers (slower scrolling = farther away)
+     * - Drops off-screen platforms and streams in new ones ahead of the viewport
+     *   (about one platform every minGap pixels of scrolling, never a burst)
      */
     void scroll(float dt, const GameConfig &cfg);
     
     /**
-     * awardScore: Check if ball has passed any uncounted platforms
+     * awardScore: Check if ball (screen X) has passed any unscored platforms
      * Returns number of newly passed platforms (0 if none)
-     * Marks platforms as counted to prevent double-scoring
+     * Advances the score cursor past them (O(1) amortized per frame)
      */
     int awardScore(float ballX, float radius);
     
     /**
-     * checkCollision: Detect if ball hits side/bottom of any platform
+     * checkCollision: Detect if ball (screen X) hits side/bottom of any platform
      * Used for death condition - hitting platform edges = game over
      * Returns true if collision detected
      */
     bool checkCollision(float ballX, float ballY, float radius, const GameConfig &cfg) const;
     
     /**
-     * resolveLanding: Handle ball landing on platform tops or ground
+     * resolveLanding: Handle ball (screen X) landing on platform tops or ground
      * - Checks if ball should land on any platform top surface
      * - Falls through to ground if no platform underneath
      * - Sets landedOnGround flag if touched ground (not a platform)
      * Returns true if ball landed (stopped falling)
      */
     bool resolveLanding(float ballX, float prevY, float &y, float &vy, float radius, const GameConfig &cfg, bool &landedOnGround);
-    
+
+    // ===== Swept Queries (GameConfig::continuousCollision) =====
+    // Contacts along the path the ball moved this step, found at their
+    // time of impact instead of at the end position, so no platform or
+    // top is skipped however far a coarse step moves the ball
+
+    /**
+     * resolveLandingSwept: resolveLanding along the step's path
+     * - The ball moved sweepX world pixels right (ending at screen X
+     *   ballX) while its Y followed y(t) = prevY + prevDrop*t + c*t^2 from
+     *   prevY to y (prevDrop = start velocity * dt; exact for constant
+     *   acceleration)
+     * - A top counts if the ball is over it when it crosses it, wherever
+     *   it ends the step; tops are crossed highest first
+     * - landTime: when (0..1) the platform or ground was reached, 1 if not
+     * - leaveTime: when the ball's centre then passed the platform's right
+     *   edge (it rolled off), 1 if it is still over it
+     */
+    bool resolveLandingSwept(float ballX, float sweepX, float prevY, float prevDrop, float &y, float &vy,
+                             float radius, const GameConfig &cfg, bool &landedOnGround,
+                             float &landTime, float &leaveTime);
+
+    /**
+     * checkCollisionSwept: Does the ball come closer than radius to any
+     * platform (checkCollision's rule) anywhere on the straight segment
+     * from screen X/Y (fromX, fromY) to (toX, toY)?
+     * - Contacts shallower than tolerance don't count: the ball's real
+     *   path is a curve within tolerance of the segment, and where that
+     *   matters (grazing a corner) the end position is tested exactly
+     * - Touching at the very end doesn't count (that is a landing)
+     */
+    bool checkCollisionSwept(float fromX, float fromY, float toX, float toY, float radius, float tolerance,
+                             const GameConfig &cfg) const;
+
+    // ===== Batched Queries (GhostRace) =====
+    // Many balls at one screen X (every racer scrolls with the same camera):
+    // one window lookup and one pass over its platforms answer all of them,
+    // each exactly as the single-ball query would. Read-only, so one level
+    // is shared by every racer
+
+    static constexpr int kMaxBatchBalls = 8;  // Balls one batched query takes
+
     /**
-     * drawPlatforms: Render all platforms with camera offset
-     * Camera offset creates vertical scrolling as ball climbs
+     * resolveLandingBatch: resolveLanding for `balls` balls at screen X ballX
+     * - Ball b moved from prevY[b] to y[b]; y[b] / vy[b] are snapped as
+     *   resolveLanding does, landed[b] / landedOnGround[b] report the result
+     * - At most kMaxBatchBalls balls
      */
-    void drawPlatforms(const GameConfig &cfg, float cameraOffsetY) const;
+    void resolveLandingBatch(float ballX, int balls, const float *prevY, float *y, float *vy, float radius,
+                             const GameConfig &cfg, bool *landed, bool *landedOnGround) const;
+
+    /**
+     * checkCollisionBatch: checkCollision for `balls` balls at screen X ballX
+     * hit[b] = ball b (center Y ballY[b]) touches a platform side or bottom
+     */
+    void checkCollisionBatch(float ballX, int balls, const float *ballY, float radius,
+                             const GameConfig &cfg, bool *hit) const;
     
     /**
-     * drawSky: Render background elements (sun, clouds) with camera offset
-     * Clouds use parallax scrolling for depth effect
+     * activeWindow: Platforms whose X extent overlaps [minX, maxX] (world X)
+     * Only visits the grid cells under the range, so cost does not grow
+     * with the number of live platforms
      */
-    void drawSky(const GameConfig &cfg, float cameraOffsetY) const;
+    PlatformWindow activeWindow(float minX, float maxX) const;
+
+    /**
+     * slot: Array index of the platform at ring offset k (0 = leftmost)
+     */
+    int slot(int k) const
+    {
+        int i = head + k;
+        return (i >= capacity) ? i - capacity : i;
+    }
+
+    /**
+     * platform: Copy of the platform at ring offset k (0 = leftmost, world X)
+     */
+    Platform platform(int k) const
+    {
+        int i = slot(k);
+        return {platformX[i], platformTop[i], platformWidth[i]};
+    }
+
+    /**
+     * nextPlatform: First platform the ball has not passed yet
+     * (the one it is on or heading for - used by bots and the HUD)
+     * Returns false if every live platform has been passed
+     */
+    bool nextPlatform(Platform &out) const
+    {
+        if (scoreCursor >= count)
+        {
+            return false;
+        }
+        out = platform(scoreCursor);
+        return true;
+    }
+
+    /**
+     * worldX: World X of a screen X under the current camera
+     */
+    float worldX(float screenX) const
+    {
+        return (float)(cameraX + (double)screenX);
+    }
+
+    /**
+     * cloudScreenX: Where cloud c's center is on screen for a camera at `camera`
+     */
+    static float cloudScreenX(const Cloud &c, double camera)
+    {
+        return c.x - (float)(camera * (double)c.parallax);
+    }
+
+    /**
+     * kRebaseX: Camera distance after which the world origin is moved
+     * (a power of two: whole-pixel platform X stay exact when shifted by it)
+     */
+    static constexpr double kRebaseX = 16384.0;
 
     // ===== Public Data =====
-    int totalPlatforms;              // Total platforms in level (= total points to win)
-    std::vector<Platform> platforms; // All platform instances
-    std::vector<Cloud> clouds;       // Background cloud decorations
+    double cameraX = 0.0;            // World X at the left screen edge (< kRebaseX)
+    int capacity = 0;                // Ring slots (fixed by generate)
+    int count = 0;                   // Live platforms (ring offsets 0..count-1)
+    int head = 0;                    // Ring slot of the leftmost platform
+    int scoreCursor = 0;             // Ring offset of the first unscored platform
+    ArenaArray<float> platformX;     // Left edge X per slot
+    ArenaArray<float> platformTop;   // Top surface Y per slot
+    ArenaArray<float> platformWidth; // Width per slot
+    ArenaArray<Cloud> clouds;        // Background cloud decorations
+    PlatformGenerator generator;     // Platform stream (seeded from cfg.seed)
+    Rng cloudRng;                    // Cloud generator stream (independent of platforms)
+    SpatialGrid grid;                // Broadphase over live platforms (handle = slot)
+
+    /**
+     * ringCapacity: Slots needed to hold every platform that can be live at once
+     * Platforms live from x + width >= -60 to x < screenWidth + generateAhead
+     * (plus one gap), and consecutive left edges are at least minGap apart
+     * A finite level never needs more slots than it has platforms
+     * (constexpr: sim/Tuning.h sizes compile-time rings with it)
+     */
+    static constexpr int ringCapacity(const GameConfig &cfg)
+    {
+        int slots = (int)(liveSpan(cfg) / std::max(1.0f, cfg.minGap)) + 2;
+        if (!cfg.endless)
+        {
+            slots = std::min(slots, std::max(1, cfg.totalPlatforms));
+        }
+        return slots;
+    }
+
+    /**
+     * liveSpan: Widest X range live platforms cover - from the drop edge (-60)
+     * past the widest platform, the screen, generateAhead and one more gap
+     */
+    static constexpr float liveSpan(const GameConfig &cfg)
+    {
+        return 60.0f + cfg.maxPlatformWidth + (float)cfg.screenWidth + cfg.generateAhead + cfg.maxGap;
+    }
+
+private:
+    /**
+     * resetRing: Carve the ring, clouds and grid for a layout and empty them
+     */
+    void resetRing(const GameConfig &layout);
+
+    /**
+     * rebase: Move the world origin `distance` pixels right (camera, platforms,
+     * grid and cloud layers together - nothing changes on screen)
+     */
+    void rebase(double distance);
+
+    /**
+     * generateClouds: Scatter cloudCount clouds from the cloud stream
+     */
+    void generateClouds(const GameConfig &cfg);
+
+    /**
+     * fillAhead: Append platforms until the stream reaches generateAhead
+     * (or the level has produced all of its platforms)
+     */
+    void fillAhead(const GameConfig &cfg);
+
+    /**
+     * splitWindow: Split a window into at most two contiguous slot ranges
+     * (the ring may wrap past the end of the arrays)
+     */
+    int splitWindow(PlatformWindow window, int start[2], int length[2]) const;
+
+    /**
+     * stageBytes: Stage arena bytes packStage takes for n platforms
+     */
+    static size_t stageBytes(int n);
+
+    /**
+     * gridCellWidth / gridCellSlots: SpatialGrid settings for a layout
+     */
+    static float gridCellWidth(const GameConfig &layout);
+    static int gridCellSlots(const GameConfig &layout);
+
+    Arena ownArena;                  // Ring, clouds and grid storage
+    Arena stageArena;                // Platform arrays of a packed stage (packStage)
+    unsigned char *storageBegin = nullptr;  // Contiguous span carved by resetRing (nullptr if it overflowed)
+    size_t storageSize = 0;          // Bytes in that span
 };
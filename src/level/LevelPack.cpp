@@ -0,0 +1,305 @@
+#include "LevelPack.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char kLevelPackMagic[4] = {'J', 'B', 'L', 'P'};
+static const size_t kLevelPackHeaderSize = 32;
+static const size_t kLevelPackEntrySize = 16;
+
+// ===== Little-Endian Helpers =====
+
+static void storeU16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void storeU32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint16_t loadU16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t loadU32(const uint8_t *p)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+/**
+ * hostIsLittleEndian: Stage arrays are used in place, so their byte order
+ * must be the CPU's
+ */
+static bool hostIsLittleEndian()
+{
+    uint16_t probe = 1;
+    uint8_t first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+/**
+ * stageBytes: Size of one stage's arrays, padded to 8 bytes
+ */
+static size_t stageBytes(size_t platforms)
+{
+    return (platforms * 3 * sizeof(uint16_t) + 7) & ~(size_t)7;
+}
+
+/**
+ * quantize: Store value in [lo, hi] only if it is a whole number
+ */
+static bool quantize(float value, long lo, long hi, long &out)
+{
+    if (!(value >= (float)lo && value <= (float)hi) || std::floor(value) != value)
+    {
+        return false;
+    }
+    out = (long)value;
+    return true;
+}
+
+// ===== LevelPack =====
+
+LevelPack::~LevelPack()
+{
+    close();
+}
+
+/**
+ * open: Map the whole file read-only, then validate header and directory
+ * Stage data is not touched here (checked per stage in stage())
+ */
+bool LevelPack::open(const char *path)
+{
+    close();
+    if (!hostIsLittleEndian())
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)kLevelPackHeaderSize)
+    {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);  // The mapping keeps the file open
+    if (!mapping)
+    {
+        return false;
+    }
+    const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);  // The view keeps the mapping alive
+    if (!view)
+    {
+        return false;
+    }
+    data = (const uint8_t *)view;
+    size = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < (off_t)kLevelPackHeaderSize)
+    {
+        ::close(fd);
+        return false;
+    }
+    void *view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file open
+    if (view == MAP_FAILED)
+    {
+        return false;
+    }
+    data = (const uint8_t *)view;
+    size = (size_t)info.st_size;
+#endif
+
+    uint32_t count = loadU32(data + 8);
+    directory = loadU32(data + 12);
+    bool valid = std::memcmp(data, kLevelPackMagic, 4) == 0 &&
+                 loadU16(data + 4) == kLevelPackVersion &&
+                 count <= 0x7FFFFFFFu &&
+                 directory % 8 == 0 && directory >= kLevelPackHeaderSize &&
+                 directory <= size && (size - directory) / kLevelPackEntrySize >= count;
+    if (!valid)
+    {
+        close();
+        return false;
+    }
+    stages = (int)count;
+    return true;
+}
+
+/**
+ * close: Release the mapping
+ */
+void LevelPack::close()
+{
+    if (data)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(data);
+#else
+        munmap((void *)data, size);
+#endif
+    }
+    data = nullptr;
+    size = 0;
+    stages = 0;
+    directory = 0;
+}
+
+/**
+ * stage: Decode directory entry i and point the view into the mapping
+ */
+bool LevelPack::stage(int i, LevelStage &out) const
+{
+    if (i < 0 || i >= stages)
+    {
+        return false;
+    }
+    const uint8_t *entry = data + directory + (size_t)i * kLevelPackEntrySize;
+    uint32_t offset = loadU32(entry);
+    uint32_t platforms = loadU32(entry + 4);
+    if (offset % 8 != 0 || platforms > 0x7FFFFFFFu || offset > size || stageBytes(platforms) > size - offset)
+    {
+        return false;  // Corrupt entry
+    }
+
+    const uint8_t *base = data + offset;
+    out.gap = (const uint16_t *)base;
+    out.top = (const int16_t *)(base + platforms * sizeof(uint16_t));
+    out.width = (const uint16_t *)(base + platforms * 2 * sizeof(uint16_t));
+    out.count = (int)platforms;
+    out.minGap = (float)loadU16(entry + 8);
+    out.maxGap = (float)loadU16(entry + 10);
+    out.maxWidth = (float)loadU16(entry + 12);
+    return true;
+}
+
+/**
+ * generateStage: Run the level's platform stream to its end
+ */
+std::vector<Platform> LevelPack::generateStage(const GameConfig &cfg)
+{
+    std::vector<Platform> platforms((size_t)std::max(0, cfg.totalPlatforms));
+    PlatformGenerator generator;
+    generator.reset(cfg);
+    float previousX = 0.0f;  // Relative to startX
+    for (auto &p : platforms)
+    {
+        generator.next(previousX, cfg, p.x, p.yTop, p.width);
+        previousX = p.x;
+    }
+    return platforms;
+}
+
+/**
+ * write: Quantize every stage, lay out header + directory + stage arrays
+ * in memory, then write the file in one go
+ */
+bool LevelPack::write(const char *path, const std::vector<std::vector<Platform>> &stageList)
+{
+    size_t total = kLevelPackHeaderSize + stageList.size() * kLevelPackEntrySize;
+    total = (total + 7) & ~(size_t)7;
+    size_t dataStart = total;
+    for (const auto &platforms : stageList)
+    {
+        total += stageBytes(platforms.size());
+    }
+    if (total > 0xFFFFFFFFu)
+    {
+        return false;  // Offsets are 32-bit
+    }
+
+    std::vector<uint8_t> bytes(total, 0);
+    std::memcpy(bytes.data(), kLevelPackMagic, 4);
+    storeU16(&bytes[4], kLevelPackVersion);
+    storeU32(&bytes[8], (uint32_t)stageList.size());
+    storeU32(&bytes[12], (uint32_t)kLevelPackHeaderSize);
+
+    size_t offset = dataStart;
+    for (size_t s = 0; s < stageList.size(); s++)
+    {
+        const std::vector<Platform> &platforms = stageList[s];
+        size_t n = platforms.size();
+        uint8_t *gap = &bytes[offset];
+        uint8_t *top = gap + n * 2;
+        uint8_t *width = top + n * 2;
+
+        long minGap = 0xFFFF, maxGap = 0, maxWidth = 0;
+        float previousX = 0.0f;
+        for (size_t i = 0; i < n; i++)
+        {
+            long g, t, w;
+            if (!quantize(platforms[i].x - previousX, 0, 0xFFFF, g) ||
+                !quantize(platforms[i].yTop, -0x8000, 0x7FFF, t) ||
+                !quantize(platforms[i].width, 0, 0xFFFF, w))
+            {
+                return false;
+            }
+            storeU16(gap + i * 2, (uint16_t)g);
+            storeU16(top + i * 2, (uint16_t)(int16_t)t);
+            storeU16(width + i * 2, (uint16_t)w);
+            minGap = std::min(minGap, g);
+            maxGap = std::max(maxGap, g);
+            maxWidth = std::max(maxWidth, w);
+            previousX = platforms[i].x;
+        }
+        if (n == 0)
+        {
+            minGap = 0;
+        }
+
+        uint8_t *entry = &bytes[kLevelPackHeaderSize + s * kLevelPackEntrySize];
+        storeU32(entry, (uint32_t)offset);
+        storeU32(entry + 4, (uint32_t)n);
+        storeU16(entry + 8, (uint16_t)minGap);
+        storeU16(entry + 10, (uint16_t)maxGap);
+        storeU16(entry + 12, (uint16_t)maxWidth);
+        offset += stageBytes(n);
+    }
+
+    std::FILE *file = std::fopen(path, "wb");
+    if (!file)
+    {
+        return false;
+    }
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size();
+    ok = (std::fclose(file) == 0) && ok;
+    return ok;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../config/Config.h"
+#include "Level.h"
+#include "PlatformGenerator.h"
+
+/**
+ * Level pack file format (all integers little-endian)
+ *
+ * Header (32 bytes):
+ *   char[4]  magic "JBLP"
+ *   uint16   version (kLevelPackVersion)
+ *   uint16   reserved (0)
+ *   uint32   stage count
+ *   uint32   directory offset (bytes from file start, 8-aligned)
+ *   uint8[16] reserved (0)
+ *
+ * Directory (16 bytes per stage):
+ *   uint32   stage data offset (bytes from file start, 8-aligned)
+ *   uint32   platform count n
+ *   uint16   smallest gap, largest gap, widest platform (LevelStage bounds)
+ *   uint16   reserved (0)
+ *
+ * Stage data (Structure of Arrays, padded to 8 bytes):
+ *   uint16[n] gap    left edge minus the previous platform's left edge
+ *                    (platform 0: minus PlatformGenerator::startX)
+ *   int16[n]  top    top surface Y
+ *   uint16[n] width
+ *
+ * Generated levels use whole-pixel gaps, widths and heights, so 16 bits
+ * store them exactly; the writer refuses anything that would not round-trip.
+ */
+static const uint16_t kLevelPackVersion = 1;
+
+/**
+ * LevelPack: Read-only, memory-mapped set of curated stages
+ *
+ * open() maps the file (mmap / MapViewOfFile) and checks only the header
+ * and directory bounds, so a pack with thousands of stages opens in
+ * constant time. stage() returns views straight into the mapping - no
+ * copy, no allocation, no random numbers - and Level::load streams the
+ * platforms out of it as they scroll in. Pages the game never reaches
+ * are never read from disk.
+ *
+ * The mapping lives until close() (or destruction); LevelStage views and
+ * Levels playing them must not outlive it.
+ */
+class LevelPack
+{
+public:
+    LevelPack() = default;
+    ~LevelPack();
+
+    LevelPack(const LevelPack &) = delete;
+    LevelPack &operator=(const LevelPack &) = delete;
+
+    /**
+     * open: Map a pack file
+     * Returns false if it is missing, not a pack, a different version, or truncated
+     */
+    bool open(const char *path);
+
+    /**
+     * close: Unmap the file (stage views become invalid)
+     */
+    void close();
+
+    /**
+     * stageCount: Stages in the pack (0 if none is open)
+     */
+    int stageCount() const { return stages; }
+
+    /**
+     * stage: View of stage i
+     * Returns false if i is out of range or its data lies outside the file
+     */
+    bool stage(int i, LevelStage &out) const;
+
+    /**
+     * generateStage: Platforms of the level cfg.seed generates (totalPlatforms
+     * of them), with x measured from PlatformGenerator::startX - input for write()
+     */
+    static std::vector<Platform> generateStage(const GameConfig &cfg);
+
+    /**
+     * write: Save stages (x measured from PlatformGenerator::startX, in X order)
+     * Returns false if a value doesn't fit its 16-bit field exactly or the
+     * file can't be written
+     */
+    static bool write(const char *path, const std::vector<std::vector<Platform>> &stageList);
+
+private:
+    const uint8_t *data = nullptr;  // Mapped file (read-only)
+    size_t size = 0;                // Mapped bytes
+    int stages = 0;                 // Directory entries
+    uint32_t directory = 0;         // Directory offset
+};
@@ -0,0 +1,289 @@
+#include "LevelRenderer.h"
+#include "rlgl.h"
+#include "raymath.h"
+#include "../profile/Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Cloud sprite layout: the reference cloud is kCloudWidth x kCloudHeight
+ * Its three ellipses (centers and radii as fractions of w/h) span
+ * x in [-0.75w, 0.70w] and y in [-0.70h, 0.60h] around the cloud center;
+ * kCloudPad pixels of transparent border keep the filtered edges soft
+ */
+static const float kCloudWidth = 130.0f;                 // Widest generated cloud (no upscaling)
+static const float kCloudHeight = kCloudWidth * 0.6f;    // Clouds are 0.6 as tall as wide
+static const float kCloudPad = 1.0f;
+static const float kCloudOriginX = 0.75f * kCloudWidth + kCloudPad;   // Cloud center inside the sprite
+static const float kCloudOriginY = 0.70f * kCloudHeight + kCloudPad;
+static const int kCloudSpriteWidth = (int)std::ceil(1.45f * kCloudWidth + 2.0f * kCloudPad);
+static const int kCloudSpriteHeight = (int)std::ceil(1.30f * kCloudHeight + 2.0f * kCloudPad);
+
+static const int kMaxQuads = 65536 / 4 - 1;  // 16-bit mesh indices
+
+/**
+ * load: Build GPU resources
+ *
+ * Platform Mesh:
+ * - Capacity = platforms that can overlap the screen at once
+ *   (each takes at least minGap + minPlatformWidth of X), plus one at each edge
+ * - Index buffer and texcoords never change (two triangles per quad)
+ * - Vertex positions are rewritten every frame (dynamic buffer)
+ *
+ * Cloud Sprite:
+ * - Rendered once; clouds only move and scale afterwards
+ *
+ * Sky Layer:
+ * - screenWidth x (screenHeight + kSkyLayerMargin) world units at
+ *   pixelsPerUnit, point sampled (one texel per window pixel, no blur);
+ *   drawn by the first updateSkyLayer
+ */
+void LevelRenderer::load(const GameConfig &cfg, float pixelsPerUnit)
+{
+    unload();
+
+    float spacing = std::max(1.0f, cfg.minGap + cfg.minPlatformWidth);
+    quadCapacity = (int)((float)cfg.screenWidth / spacing) + 2;
+    quadCapacity = std::max(1, std::min(quadCapacity, std::min(Level::ringCapacity(cfg), kMaxQuads)));
+
+    platformMesh = Mesh{};
+    platformMesh.vertexCount = quadCapacity * 4;
+    platformMesh.triangleCount = quadCapacity * 2;
+    platformMesh.vertices = (float *)MemAlloc(platformMesh.vertexCount * 3 * sizeof(float));
+    platformMesh.texcoords = (float *)MemAlloc(platformMesh.vertexCount * 2 * sizeof(float));  // Zeroed: samples the white default texture
+    platformMesh.indices = (unsigned short *)MemAlloc(platformMesh.triangleCount * 3 * sizeof(unsigned short));
+    for (int q = 0; q < quadCapacity; q++)
+    {
+        // Same winding as raylib's own rectangles (top-left, bottom-left, bottom-right, top-right)
+        unsigned short v = (unsigned short)(q * 4);
+        unsigned short *idx = platformMesh.indices + q * 6;
+        idx[0] = v;     idx[1] = v + 1; idx[2] = v + 2;
+        idx[3] = v;     idx[4] = v + 2; idx[5] = v + 3;
+    }
+    UploadMesh(&platformMesh, true);  // Dynamic: positions re-uploaded every frame
+
+    platformMaterial = LoadMaterialDefault();
+    platformMaterial.maps[MATERIAL_MAP_DIFFUSE].color = GOLD;
+
+    cloudSprite = LoadRenderTexture(kCloudSpriteWidth, kCloudSpriteHeight);
+    SetTextureFilter(cloudSprite.texture, TEXTURE_FILTER_BILINEAR);
+    renderCloudSprite();
+
+    layerScale = std::max(1.0f, pixelsPerUnit);
+    skyLayer = LoadRenderTexture((int)std::ceil(cfg.screenWidth * layerScale),
+                                 (int)std::ceil((cfg.screenHeight + kSkyLayerMargin) * layerScale));
+    SetTextureFilter(skyLayer.texture, TEXTURE_FILTER_POINT);
+    layerValid = false;
+
+    loaded = true;
+}
+
+/**
+ * unload: Release mesh, material and sprite (UnloadMesh frees the CPU arrays too)
+ */
+void LevelRenderer::unload()
+{
+    if (!loaded)
+    {
+        return;
+    }
+    UnloadMesh(platformMesh);
+    UnloadMaterial(platformMaterial);
+    UnloadRenderTexture(cloudSprite);
+    UnloadRenderTexture(skyLayer);
+    platformMesh = Mesh{};
+    platformMaterial = Material{};
+    cloudSprite = RenderTexture2D{};
+    skyLayer = RenderTexture2D{};
+    layerValid = false;
+    quadCapacity = 0;
+    loaded = false;
+}
+
+/**
+ * renderCloudSprite: Draw the three-ellipse cloud shape at reference size
+ * Background is transparent white (not transparent black) so bilinear
+ * filtering at the edges fades alpha without darkening the color
+ */
+void LevelRenderer::renderCloudSprite()
+{
+    float cx = kCloudOriginX;
+    float cy = kCloudOriginY;
+    float w = kCloudWidth;
+    float h = kCloudHeight;
+
+    BeginTextureMode(cloudSprite);
+    ClearBackground(Color{255, 255, 255, 0});
+    DrawEllipse((int)cx, (int)cy, w * 0.6f, h * 0.6f, WHITE);
+    DrawEllipse((int)(cx + w * 0.2f), (int)(cy - h * 0.2f), w * 0.5f, h * 0.5f, WHITE);
+    DrawEllipse((int)(cx - w * 0.2f), (int)(cy - h * 0.1f), w * 0.55f, h * 0.55f, WHITE);
+    EndTextureMode();
+}
+
+/**
+ * updateSkyLayer: Keep the layer covering cameraOffsetY
+ * - The layer's rows show world Y from layerTopY down; it can be shown
+ *   for any camera offset in [layerTopY, layerTopY + kSkyLayerMargin]
+ * - Outside that range it is redrawn centered on the current offset
+ *   (whole units, so the shapes snap to the same grid as before)
+ * - Drawn in world units through a Camera2D at layerScale, with the
+ *   same shapes drawSky used to draw every frame
+ */
+void LevelRenderer::updateSkyLayer(const GameConfig &cfg, float cameraOffsetY, Color background)
+{
+    if (!loaded || skyLayer.id == 0)
+    {
+        return;
+    }
+    bool covered = cameraOffsetY >= layerTopY && cameraOffsetY <= layerTopY + kSkyLayerMargin;
+    bool sameColor = background.r == layerBackground.r && background.g == layerBackground.g &&
+                     background.b == layerBackground.b && background.a == layerBackground.a;
+    if (layerValid && covered && sameColor)
+    {
+        return;
+    }
+
+    PROFILE_SCOPE(DrawSky);
+    layerTopY = std::floor(cameraOffsetY - kSkyLayerMargin * 0.5f);
+    layerBackground = background;
+
+    Camera2D view = {};
+    view.target = {0.0f, layerTopY};  // Camera offset of the layer's top row
+    view.zoom = layerScale;
+
+    BeginTextureMode(skyLayer);
+    ClearBackground(background);
+    BeginMode2D(view);
+    DrawCircle(60, 60, 40, YELLOW);  // Sun in the top-left corner
+    DrawRectangle(0, (int)(cfg.groundY + cfg.radius), cfg.screenWidth,
+                  (int)(cfg.screenHeight + kSkyLayerMargin), DARKGREEN);  // Ground, down past the layer
+    EndMode2D();
+    EndTextureMode();
+
+    layerValid = true;
+    skyLayerDraws++;
+}
+
+/**
+ * drawPlatforms: Pack visible platforms into the mesh and draw it
+ *
+ * Camera System:
+ * - Platforms are in world X; cameraX is subtracted as quads are packed
+ * - cameraOffsetY shifts all Y coordinates for vertical scrolling
+ * - As ball climbs higher, camera follows (offset becomes more negative)
+ * - This keeps ball in visible area while showing vertical progress
+ *
+ * Culling:
+ * - Only the active window of platforms between cameraX and
+ *   cameraX + screenWidth is packed
+ *
+ * Batching:
+ * - Shapes drawn earlier sit in raylib's batch, so it is flushed first
+ *   to keep back-to-front order
+ * - One UpdateMeshBuffer + DrawMesh per quadCapacity platforms
+ *   (a single call unless the config changed since load)
+ */
+void LevelRenderer::drawPlatforms(const Level &level, const GameConfig &cfg, double cameraX, float cameraOffsetY)
+{
+    PROFILE_SCOPE(DrawPlatforms);
+
+    if (!loaded)
+    {
+        return;
+    }
+
+    PlatformWindow window = level.activeWindow((float)cameraX, (float)(cameraX + cfg.screenWidth));
+    if (window.count == 0)
+    {
+        return;
+    }
+
+    rlDrawRenderBatchActive();  // Sky and ground go to the screen before the platforms
+
+    float h = (float)(int)cfg.platformHeight;
+    int done = 0;
+    while (done < window.count)
+    {
+        int quads = std::min(quadCapacity, window.count - done);
+        float *v = platformMesh.vertices;
+        for (int q = 0; q < quads; q++)
+        {
+            int i = level.slot(window.first + done + q);
+            float x0 = (float)(int)((double)level.platformX[i] - cameraX);  // Screen X (pixel-snapped)
+            float y0 = (float)(int)(level.platformTop[i] - cameraOffsetY);  // Apply camera offset
+            float x1 = x0 + (float)(int)level.platformWidth[i];
+            float y1 = y0 + h;
+
+            v[0] = x0;  v[1] = y0;  v[2] = 0.0f;    // Top-left
+            v[3] = x0;  v[4] = y1;  v[5] = 0.0f;    // Bottom-left
+            v[6] = x1;  v[7] = y1;  v[8] = 0.0f;    // Bottom-right
+            v[9] = x1;  v[10] = y0; v[11] = 0.0f;   // Top-right
+            v += 12;
+        }
+
+        UpdateMeshBuffer(platformMesh, 0, platformMesh.vertices, quads * 12 * (int)sizeof(float), 0);
+        Mesh batch = platformMesh;
+        batch.triangleCount = quads * 2;  // Draw only the packed quads
+        DrawMesh(batch, platformMaterial, MatrixIdentity());
+        done += quads;
+    }
+}
+
+/**
+ * drawSky: Render background elements (sun and clouds) with camera offset
+ *
+ * Background Elements:
+ * - Sky layer: one opaque quad over the whole world view - background,
+ *   sun (fixed in the top-left, moves with the camera to stay visible)
+ *   and ground; its source rows start cameraOffsetY - layerTopY units
+ *   down the layer. Blending is off for it (it covers everything behind)
+ * - Clouds: Cached sprite scaled to each cloud's size, placed by its
+ *   parallax layer (Level::cloudScreenX), off-screen ones skipped
+ * - Camera offset applied so background scrolls with vertical movement
+ * - Without a layer (not loaded) the sun and ground are drawn directly
+ */
+void LevelRenderer::drawSky(const Level &level, const GameConfig &cfg, double cameraX, float cameraOffsetY) const
+{
+    PROFILE_SCOPE(DrawSky);
+
+    if (!loaded || !layerValid)
+    {
+        DrawCircle(60, (int)(60 - cameraOffsetY), 40, YELLOW);  // Sun in top-left corner
+        DrawRectangle(0, (int)(cfg.groundY + cfg.radius - cameraOffsetY), cfg.screenWidth, cfg.screenHeight, DARKGREEN);
+    }
+    else
+    {
+        float layerHeight = (float)skyLayer.texture.height;
+        float rows = cfg.screenHeight * layerScale;
+        float firstRow = (cameraOffsetY - layerTopY) * layerScale;  // Layer row at the top of the screen
+        Rectangle layerSource = {0.0f, layerHeight - firstRow - rows, cfg.screenWidth * layerScale, -rows};  // Stored upside down
+        Rectangle screen = {0.0f, 0.0f, (float)cfg.screenWidth, (float)cfg.screenHeight};
+        rlDrawRenderBatchActive();  // Anything queued before goes out with blending on
+        rlDisableColorBlend();
+        DrawTexturePro(skyLayer.texture, layerSource, screen, Vector2{0.0f, 0.0f}, 0.0f, WHITE);
+        rlDrawRenderBatchActive();
+        rlEnableColorBlend();
+    }
+
+    if (!loaded)
+    {
+        return;
+    }
+
+    Rectangle source = {0.0f, 0.0f, (float)kCloudSpriteWidth, -(float)kCloudSpriteHeight};  // Render textures are stored upside down
+    for (const auto &c : level.clouds)
+    {
+        float sx = c.w / kCloudWidth;
+        float sy = c.h / kCloudHeight;
+        float left = Level::cloudScreenX(c, cameraX) - kCloudOriginX * sx;  // Own parallax layer
+        float top = c.y - cameraOffsetY - kCloudOriginY * sy;       // Apply camera offset
+        float width = kCloudSpriteWidth * sx;
+        if (left > (float)cfg.screenWidth || left + width < 0.0f)
+        {
+            continue;  // Off screen
+        }
+
+        Rectangle dest = {left, top, width, kCloudSpriteHeight * sy};
+        DrawTexturePro(cloudSprite.texture, source, dest, Vector2{0.0f, 0.0f}, 0.0f, WHITE);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "raylib.h"
+#include "../config/Config.h"
+#include "Level.h"
+
+/**
+ * LevelRenderer: Draws a Level's platforms and sky with few draw calls
+ *
+ * Platforms:
+ * - Culled to the viewport through Level::activeWindow
+ * - Visible platform quads are packed into one dynamic mesh, uploaded
+ *   with a single buffer update and drawn with a single DrawMesh call
+ *   (instead of one DrawRectangle per platform)
+ *
+ * Clouds:
+ * - Every cloud has the same shape (three ellipses scaled by its w/h),
+ *   so the shape is tessellated once into a cached render texture
+ * - Each frame a cloud is one textured sprite; all sprites share that
+ *   texture and land in one raylib batch
+ *
+ * Sky Layer (background, sun, ground):
+ * - None of them move sideways, and vertically they only follow
+ *   cameraOffsetY, so they are drawn once into a render texture at window
+ *   resolution, kSkyLayerMargin world units taller than the screen
+ * - Each frame the layer is one opaque full-screen quad (blending off)
+ *   whose source rows slide with the camera offset; it is only redrawn
+ *   when the offset leaves the range the layer covers (or the colors change)
+ * - Replaces the background fill, the sun and the full-width ground
+ *   rectangle that used to be drawn over it, so every pixel of the screen
+ *   is written once before the clouds
+ * - Clouds stay sprites: they drift every frame at parallax speeds of
+ *   their own, so a cloud layer would be redrawn almost every frame and its
+ *   full-screen blended composite costs more fill than the sprites themselves
+ *
+ * Owns GPU resources: call load() after InitWindow and unload() before
+ * CloseWindow. Level itself stays raylib-free for the headless build.
+ */
+class LevelRenderer
+{
+public:
+    static constexpr float kSkyLayerMargin = 128.0f;  // World units of camera travel one sky layer covers
+
+    /**
+     * load: Create the platform mesh, the cloud sprite and the sky layer
+     * Mesh capacity is sized for the most platforms that fit on screen;
+     * the sky layer has pixelsPerUnit texels per world unit (the window's zoom)
+     */
+    void load(const GameConfig &cfg, float pixelsPerUnit = 1.0f);
+
+    /**
+     * unload: Free GPU resources (safe to call when not loaded)
+     */
+    void unload();
+
+    /**
+     * drawPlatforms: Render on-screen platforms for a camera
+     * cameraX is the world X at the left screen edge (Level::cameraX, or a
+     * value between steps when interpolating); cameraOffsetY the vertical offset
+     */
+    void drawPlatforms(const Level &level, const GameConfig &cfg, double cameraX, float cameraOffsetY);
+
+    /**
+     * updateSkyLayer: Redraw the sky layer if cameraOffsetY is outside the
+     * range it covers (or background changed) - call before BeginDrawing
+     * (the layer is drawn through its own texture mode)
+     */
+    void updateSkyLayer(const GameConfig &cfg, float cameraOffsetY, Color background);
+
+    /**
+     * drawSky: Render background elements (sky layer - background, sun and
+     * ground - then clouds) for a camera
+     * Clouds use parallax scrolling for depth effect
+     */
+    void drawSky(const Level &level, const GameConfig &cfg, double cameraX, float cameraOffsetY) const;
+
+    // ===== Statistics =====
+    long long skyLayerDraws = 0;  // Times the sky layer was (re)drawn
+
+private:
+    /**
+     * renderCloudSprite: Tessellate the cloud shape once into cloudSprite
+     */
+    void renderCloudSprite();
+
+    // ===== Platform Mesh =====
+    Mesh platformMesh{};         // Dynamic quad mesh (4 vertices, 2 triangles per platform)
+    Material platformMaterial{}; // Default shader, diffuse color = platform color
+    int quadCapacity = 0;        // Platforms the mesh can hold per draw call
+    bool loaded = false;         // GPU resources exist
+
+    // ===== Cloud Sprite =====
+    RenderTexture2D cloudSprite{};  // Pre-tessellated cloud (transparent background)
+
+    // ===== Sky Layer =====
+    RenderTexture2D skyLayer{};     // Background, sun and ground (opaque)
+    float layerScale = 1.0f;        // Texels per world unit
+    float layerTopY = 0.0f;         // Camera offset the layer's top row is drawn for (whole units)
+    Color layerBackground{};        // Background color it was drawn with
+    bool layerValid = false;        // Layer holds a drawing (updateSkyLayer ran since load)
+};
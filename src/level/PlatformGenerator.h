@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "../config/Config.h"
+#include "../sim/Rng.h"
+
+/**
+ * LevelStage: A fixed, pre-built platform sequence (read-only view)
+ *
+ * Points straight into a LevelPack's mapped file (see LevelPack.h), so
+ * playing a stage copies nothing up front. Platforms are quantized to
+ * whole pixels:
+ * - gap[i]: left edge of platform i minus the left edge of platform i-1
+ *   (platform 0 is measured from PlatformGenerator::startX)
+ * - top[i], width[i]: top surface Y and width
+ * The spacing bounds size the Level ring (Level::ringCapacity).
+ */
+struct LevelStage
+{
+    const uint16_t *gap = nullptr;
+    const int16_t *top = nullptr;
+    const uint16_t *width = nullptr;
+    int count = 0;                // Platforms in the stage
+    float minGap = 0.0f;          // Smallest gap in the stage
+    float maxGap = 0.0f;          // Largest gap in the stage
+    float maxWidth = 0.0f;        // Widest platform in the stage
+};
+
+/**
+ * PlatformGenerator: The platform stream, produced one platform at a time
+ *
+ * Level (and BatchSim) pull platforms from here only when they are about
+ * to come into view, so a level of any length - or an endless one - costs
+ * the same memory and the same startup time.
+ *
+ * Layout Rules:
+ * - Horizontal: each platform starts a random gap (minGap..maxGap) after
+ *   the previous one's left edge; the first starts after screenWidth + 200
+ * - Width: random (minPlatformWidth..maxPlatformWidth)
+ * - Vertical: heights walk up by random steps (stepUpMin..stepUpMax) from
+ *   just above the ground to minPlatformY, then walk back down by the same
+ *   kind of steps, and so on - the level keeps changing height forever
+ *   instead of flattening out at minPlatformY
+ *
+ * A generator can also replay a LevelStage instead (curated levels): it
+ * then hands out the stage's platforms in order and draws no random numbers.
+ *
+ * All state is plain values (copyable, deterministic for a given seed).
+ * The layout functions take cfg as a GameConfig or any tuning with its
+ * field names (sim/Tuning.h), so compile-time tunings fold the ranges in.
+ */
+struct PlatformGenerator
+{
+    Rng rng;                  // Platform stream (seeded from cfg.seed)
+    float yTop = 0.0f;        // Top of the last produced platform
+    int direction = -1;       // -1 = climbing (Y decreasing), +1 = descending
+    long long produced = 0;   // Platforms produced since reset
+    LevelStage stage;         // Source platforms (stage.gap == nullptr = random stream)
+
+    /**
+     * reset: Restart the stream for a level seed
+     */
+    void reset(const GameConfig &cfg)
+    {
+        rng.seed(cfg.seed);
+        yTop = lowestTop(cfg);
+        direction = -1;
+        produced = 0;
+        stage = LevelStage();
+    }
+
+    /**
+     * reset: Restart as a replay of a fixed stage (no random numbers used)
+     */
+    void reset(const LevelStage &source, const GameConfig &cfg)
+    {
+        yTop = lowestTop(cfg);
+        direction = -1;
+        produced = 0;
+        stage = source;
+    }
+
+    /**
+     * exhausted: Finite levels end after totalPlatforms (endless never does),
+     * stages after their last platform
+     */
+    template <typename Tuning>
+    bool exhausted(const Tuning &cfg) const
+    {
+        if (stage.gap)
+        {
+            return produced >= stage.count;
+        }
+        return !cfg.endless && produced >= cfg.totalPlatforms;
+    }
+
+    /**
+     * startX: Left edge the first platform's gap is measured from
+     */
+    template <typename Tuning>
+    static float startX(const Tuning &cfg)
+    {
+        return (float)cfg.screenWidth + 200.0f;  // Start off-screen right
+    }
+
+    /**
+     * lowestTop: Lowest platform top - where the climb starts and turns around
+     */
+    template <typename Tuning>
+    static float lowestTop(const Tuning &cfg)
+    {
+        return cfg.groundY - 20.0f;  // Slightly above ground
+    }
+
+    /**
+     * next: Produce the platform that follows one whose left edge is previousX
+     * Draws gap, width and step from the stream in that order
+     * (or reads the next stage platform)
+     */
+    template <typename Tuning>
+    void next(float previousX, const Tuning &cfg, float &x, float &top, float &width)
+    {
+        if (stage.gap)
+        {
+            size_t i = (size_t)produced;
+            x = previousX + (float)stage.gap[i];
+            yTop = top = (float)stage.top[i];
+            width = (float)stage.width[i];
+            produced++;
+            return;
+        }
+
+        float gap = (float)rng.range((int)cfg.minGap, (int)cfg.maxGap);
+        width = (float)rng.range((int)cfg.minPlatformWidth, (int)cfg.maxPlatformWidth);
+        float step = (float)rng.range((int)cfg.stepUpMin, (int)cfg.stepUpMax);
+
+        // Bounce between lowestTop and minPlatformY
+        yTop += (float)direction * step;
+        if (direction < 0 && yTop <= cfg.minPlatformY)
+        {
+            yTop = cfg.minPlatformY;  // Don't go above screen top - head back down
+            direction = 1;
+        }
+        else if (direction > 0 && yTop >= lowestTop(cfg))
+        {
+            yTop = lowestTop(cfg);    // Back near the ground - climb again
+            direction = -1;
+        }
+
+        x = previousX + gap;
+        top = yTop;
+        produced++;
+    }
+};
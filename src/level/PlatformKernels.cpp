@@ -0,0 +1,347 @@
+#include "PlatformKernels.h"
+#include "../config/Hints.h"
+
+/**
+ * Which SIMD paths can be compiled here
+ *
+ * x86: SSE2/AVX2 kernels are compiled with per-function target attributes
+ * (no global -mavx2 needed) and chosen at runtime via __builtin_cpu_supports.
+ * They are only enabled when scalar float math itself uses SSE
+ * (__SSE_MATH__, the default on x86-64). 32-bit builds using x87 math
+ * evaluate the scalar code in 80-bit precision, so vector results would
+ * not match it bit for bit - those builds stay on the scalar kernels.
+ *
+ * ARM: NEON is part of AArch64, so it is used unconditionally there.
+ * (32-bit NEON flushes denormals and is not IEEE exact, so it is skipped.)
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE_MATH__)
+#define PLATFORM_KERNELS_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define PLATFORM_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+// ===== Scalar reference =====
+
+/**
+ * anyCollisionScalar: Closest-point circle vs rectangle test per platform
+ * - Clamp ball center onto the rectangle
+ * - Collision if distance to that point is below the radius
+ * - Forced inline: it is also every SIMD kernel's tail (and with a
+ *   handful of platforms near the ball, often all of its work), and an
+ *   out-of-line call there doubled the cost of a step at -O2
+ */
+static FORCE_INLINE bool anyCollisionScalar(const float *x, const float *yTop, const float *width, int count,
+                               float ballX, float ballY, float radius, float platformHeight)
+{
+    for (int i = 0; i < count; i++)
+    {
+        // Platform rectangle bounds
+        float rx = x[i];
+        float ry = yTop[i];
+        float rw = width[i];
+        float rh = platformHeight;
+
+        // Find closest point on rectangle to ball center
+        float closestX = (ballX < rx) ? rx : (ballX > rx + rw ? rx + rw : ballX);
+        float closestY = (ballY < ry) ? ry : (ballY > ry + rh ? ry + rh : ballY);
+
+        // Collision if distance < radius
+        float dx = ballX - closestX;
+        float dy = ballY - closestY;
+        if (dx * dx + dy * dy < radius * radius)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * highestLandingScalar: Lowest yTop (= highest surface) crossed this step
+ * - Ball bottom moved from above the top (prevY) to on/below it (y)
+ * - Ball center is horizontally within [left, right]
+ * - Forced inline for the same reason as anyCollisionScalar
+ */
+static FORCE_INLINE float highestLandingScalar(const float *x, const float *yTop, const float *width, int count,
+                                  float ballX, float prevY, float y, float radius, float floorY)
+{
+    float targetY = floorY;
+    for (int i = 0; i < count; i++)
+    {
+        float top = yTop[i];
+        float left = x[i];
+        float right = x[i] + width[i];
+
+        if (y + radius >= top &&
+            prevY + radius <= top &&
+            left <= ballX &&
+            right >= ballX)
+        {
+            targetY = (top < targetY) ? top : targetY;
+        }
+    }
+    return targetY;
+}
+
+static const PlatformKernels kScalarKernels = {anyCollisionScalar, highestLandingScalar, "scalar"};
+
+#if PLATFORM_KERNELS_X86
+
+// ===== SSE2 (4 platforms per instruction) =====
+
+/**
+ * select4: Bitwise lane select (mask ? a : b) - exact, works on plain SSE2
+ */
+__attribute__((target("sse2"))) static inline __m128 select4(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+__attribute__((target("sse2")))
+static bool anyCollisionSse2(const float *x, const float *yTop, const float *width, int count,
+                             float ballX, float ballY, float radius, float platformHeight)
+{
+    const __m128 bx = _mm_set1_ps(ballX);
+    const __m128 by = _mm_set1_ps(ballY);
+    const __m128 rh = _mm_set1_ps(platformHeight);
+    const __m128 r2 = _mm_set1_ps(radius * radius);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 rx = _mm_loadu_ps(x + i);
+        __m128 ry = _mm_loadu_ps(yTop + i);
+        __m128 rxw = _mm_add_ps(rx, _mm_loadu_ps(width + i));
+        __m128 ryh = _mm_add_ps(ry, rh);
+
+        __m128 cx = select4(_mm_cmplt_ps(bx, rx), rx, select4(_mm_cmpgt_ps(bx, rxw), rxw, bx));
+        __m128 cy = select4(_mm_cmplt_ps(by, ry), ry, select4(_mm_cmpgt_ps(by, ryh), ryh, by));
+        __m128 dx = _mm_sub_ps(bx, cx);
+        __m128 dy = _mm_sub_ps(by, cy);
+        __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+        if (_mm_movemask_ps(_mm_cmplt_ps(d2, r2)) != 0)
+        {
+            return true;
+        }
+    }
+    return anyCollisionScalar(x + i, yTop + i, width + i, count - i, ballX, ballY, radius, platformHeight);
+}
+
+__attribute__((target("sse2")))
+static float highestLandingSse2(const float *x, const float *yTop, const float *width, int count,
+                                float ballX, float prevY, float y, float radius, float floorY)
+{
+    const __m128 bx = _mm_set1_ps(ballX);
+    const __m128 bottom = _mm_set1_ps(y + radius);
+    const __m128 prevBottom = _mm_set1_ps(prevY + radius);
+    __m128 best = _mm_set1_ps(floorY);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 top = _mm_loadu_ps(yTop + i);
+        __m128 left = _mm_loadu_ps(x + i);
+        __m128 right = _mm_add_ps(left, _mm_loadu_ps(width + i));
+
+        __m128 crossed = _mm_and_ps(_mm_cmpge_ps(bottom, top), _mm_cmple_ps(prevBottom, top));
+        crossed = _mm_and_ps(crossed, _mm_and_ps(_mm_cmple_ps(left, bx), _mm_cmpge_ps(right, bx)));
+
+        // best = (top < best) ? top : best, only in crossed lanes
+        best = select4(_mm_and_ps(crossed, _mm_cmplt_ps(top, best)), top, best);
+    }
+
+    // Fold lanes with the same (a < b ? a : b) rule, then finish the tail
+    float lanes[4];
+    _mm_storeu_ps(lanes, best);
+    float targetY = lanes[0];
+    for (int l = 1; l < 4; l++)
+    {
+        targetY = (lanes[l] < targetY) ? lanes[l] : targetY;
+    }
+    return highestLandingScalar(x + i, yTop + i, width + i, count - i, ballX, prevY, y, radius, targetY);
+}
+
+static const PlatformKernels kSse2Kernels = {anyCollisionSse2, highestLandingSse2, "sse2"};
+
+// ===== AVX2 (8 platforms per instruction) =====
+
+__attribute__((target("avx2")))
+static bool anyCollisionAvx2(const float *x, const float *yTop, const float *width, int count,
+                             float ballX, float ballY, float radius, float platformHeight)
+{
+    const __m256 bx = _mm256_set1_ps(ballX);
+    const __m256 by = _mm256_set1_ps(ballY);
+    const __m256 rh = _mm256_set1_ps(platformHeight);
+    const __m256 r2 = _mm256_set1_ps(radius * radius);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 rx = _mm256_loadu_ps(x + i);
+        __m256 ry = _mm256_loadu_ps(yTop + i);
+        __m256 rxw = _mm256_add_ps(rx, _mm256_loadu_ps(width + i));
+        __m256 ryh = _mm256_add_ps(ry, rh);
+
+        // blendv(b, a, mask) = mask ? a : b
+        __m256 cx = _mm256_blendv_ps(_mm256_blendv_ps(bx, rxw, _mm256_cmp_ps(bx, rxw, _CMP_GT_OQ)),
+                                     rx, _mm256_cmp_ps(bx, rx, _CMP_LT_OQ));
+        __m256 cy = _mm256_blendv_ps(_mm256_blendv_ps(by, ryh, _mm256_cmp_ps(by, ryh, _CMP_GT_OQ)),
+                                     ry, _mm256_cmp_ps(by, ry, _CMP_LT_OQ));
+        __m256 dx = _mm256_sub_ps(bx, cx);
+        __m256 dy = _mm256_sub_ps(by, cy);
+        __m256 d2 = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+        if (_mm256_movemask_ps(_mm256_cmp_ps(d2, r2, _CMP_LT_OQ)) != 0)
+        {
+            return true;
+        }
+    }
+    return anyCollisionScalar(x + i, yTop + i, width + i, count - i, ballX, ballY, radius, platformHeight);
+}
+
+__attribute__((target("avx2")))
+static float highestLandingAvx2(const float *x, const float *yTop, const float *width, int count,
+                                float ballX, float prevY, float y, float radius, float floorY)
+{
+    const __m256 bx = _mm256_set1_ps(ballX);
+    const __m256 bottom = _mm256_set1_ps(y + radius);
+    const __m256 prevBottom = _mm256_set1_ps(prevY + radius);
+    __m256 best = _mm256_set1_ps(floorY);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 top = _mm256_loadu_ps(yTop + i);
+        __m256 left = _mm256_loadu_ps(x + i);
+        __m256 right = _mm256_add_ps(left, _mm256_loadu_ps(width + i));
+
+        __m256 crossed = _mm256_and_ps(_mm256_cmp_ps(bottom, top, _CMP_GE_OQ),
+                                       _mm256_cmp_ps(prevBottom, top, _CMP_LE_OQ));
+        crossed = _mm256_and_ps(crossed, _mm256_and_ps(_mm256_cmp_ps(left, bx, _CMP_LE_OQ),
+                                                       _mm256_cmp_ps(right, bx, _CMP_GE_OQ)));
+
+        __m256 better = _mm256_and_ps(crossed, _mm256_cmp_ps(top, best, _CMP_LT_OQ));
+        best = _mm256_blendv_ps(best, top, better);
+    }
+
+    float lanes[8];
+    _mm256_storeu_ps(lanes, best);
+    float targetY = lanes[0];
+    for (int l = 1; l < 8; l++)
+    {
+        targetY = (lanes[l] < targetY) ? lanes[l] : targetY;
+    }
+    return highestLandingScalar(x + i, yTop + i, width + i, count - i, ballX, prevY, y, radius, targetY);
+}
+
+static const PlatformKernels kAvx2Kernels = {anyCollisionAvx2, highestLandingAvx2, "avx2"};
+
+#endif // PLATFORM_KERNELS_X86
+
+#if PLATFORM_KERNELS_NEON
+
+// ===== NEON (4 platforms per instruction, AArch64) =====
+
+static bool anyCollisionNeon(const float *x, const float *yTop, const float *width, int count,
+                             float ballX, float ballY, float radius, float platformHeight)
+{
+    const float32x4_t bx = vdupq_n_f32(ballX);
+    const float32x4_t by = vdupq_n_f32(ballY);
+    const float32x4_t rh = vdupq_n_f32(platformHeight);
+    const float32x4_t r2 = vdupq_n_f32(radius * radius);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t rx = vld1q_f32(x + i);
+        float32x4_t ry = vld1q_f32(yTop + i);
+        float32x4_t rxw = vaddq_f32(rx, vld1q_f32(width + i));
+        float32x4_t ryh = vaddq_f32(ry, rh);
+
+        // vbslq(mask, a, b) = mask ? a : b
+        float32x4_t cx = vbslq_f32(vcltq_f32(bx, rx), rx, vbslq_f32(vcgtq_f32(bx, rxw), rxw, bx));
+        float32x4_t cy = vbslq_f32(vcltq_f32(by, ry), ry, vbslq_f32(vcgtq_f32(by, ryh), ryh, by));
+        float32x4_t dx = vsubq_f32(bx, cx);
+        float32x4_t dy = vsubq_f32(by, cy);
+        float32x4_t d2 = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));  // Separate mul/add (no fused vfma)
+
+        if (vmaxvq_u32(vcltq_f32(d2, r2)) != 0)
+        {
+            return true;
+        }
+    }
+    return anyCollisionScalar(x + i, yTop + i, width + i, count - i, ballX, ballY, radius, platformHeight);
+}
+
+static float highestLandingNeon(const float *x, const float *yTop, const float *width, int count,
+                                float ballX, float prevY, float y, float radius, float floorY)
+{
+    const float32x4_t bx = vdupq_n_f32(ballX);
+    const float32x4_t bottom = vdupq_n_f32(y + radius);
+    const float32x4_t prevBottom = vdupq_n_f32(prevY + radius);
+    float32x4_t best = vdupq_n_f32(floorY);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        float32x4_t top = vld1q_f32(yTop + i);
+        float32x4_t left = vld1q_f32(x + i);
+        float32x4_t right = vaddq_f32(left, vld1q_f32(width + i));
+
+        uint32x4_t crossed = vandq_u32(vcgeq_f32(bottom, top), vcleq_f32(prevBottom, top));
+        crossed = vandq_u32(crossed, vandq_u32(vcleq_f32(left, bx), vcgeq_f32(right, bx)));
+
+        best = vbslq_f32(vandq_u32(crossed, vcltq_f32(top, best)), top, best);
+    }
+
+    float lanes[4];
+    vst1q_f32(lanes, best);
+    float targetY = lanes[0];
+    for (int l = 1; l < 4; l++)
+    {
+        targetY = (lanes[l] < targetY) ? lanes[l] : targetY;
+    }
+    return highestLandingScalar(x + i, yTop + i, width + i, count - i, ballX, prevY, y, radius, targetY);
+}
+
+static const PlatformKernels kNeonKernels = {anyCollisionNeon, highestLandingNeon, "neon"};
+
+#endif // PLATFORM_KERNELS_NEON
+
+/**
+ * detectKernels: Pick the widest supported implementation
+ */
+static const PlatformKernels &detectKernels()
+{
+#if PLATFORM_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return kAvx2Kernels;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return kSse2Kernels;
+    }
+#elif PLATFORM_KERNELS_NEON
+    return kNeonKernels;
+#endif
+    return kScalarKernels;
+}
+
+/**
+ * platformKernels: Detection runs once (thread-safe static init)
+ */
+const PlatformKernels &platformKernels()
+{
+    static const PlatformKernels &kernels = detectKernels();
+    return kernels;
+}
+
+const PlatformKernels &scalarPlatformKernels()
+{
+    return kScalarKernels;
+}
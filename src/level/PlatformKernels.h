@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * PlatformKernels: Hot per-platform loops over Structure-of-Arrays data
+ *
+ * Each kernel walks `count` platforms stored as three parallel arrays
+ * (x, yTop, width). Several implementations exist (scalar, SSE2, AVX2,
+ * NEON); platformKernels() picks the widest one the CPU supports the first
+ * time it is called.
+ *
+ * Every implementation performs the same float operations in the same
+ * order as the scalar version (compares, selects, min - no FMA, no
+ * reassociation), so results are bit-for-bit identical on every path.
+ */
+struct PlatformKernels
+{
+    /**
+     * anyCollision: Does the ball circle overlap any platform rectangle?
+     * Same closest-point test as the original Level::checkCollision loop
+     */
+    bool (*anyCollision)(const float *x, const float *yTop, const float *width, int count,
+                         float ballX, float ballY, float radius, float platformHeight);
+
+    /**
+     * highestLanding: Highest platform top the ball crossed this step
+     * - Only platforms horizontally under ballX whose top lies between
+     *   prevY + radius and y + radius count
+     * - Returns floorY if no platform qualifies (or if a qualifying top is not above it)
+     */
+    float (*highestLanding)(const float *x, const float *yTop, const float *width, int count,
+                            float ballX, float prevY, float y, float radius, float floorY);
+
+    const char *name;  // "scalar", "sse2", "avx2" or "neon" (for logs/benchmarks)
+};
+
+/**
+ * platformKernels: Best kernel set for this CPU (detected once, then cached)
+ */
+const PlatformKernels &platformKernels();
+
+/**
+ * scalarPlatformKernels: Reference implementation (always available)
+ */
+const PlatformKernels &scalarPlatformKernels();
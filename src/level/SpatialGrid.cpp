@@ -0,0 +1,127 @@
+#include "SpatialGrid.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * ringCells: Enough cells that liveSpan plus one partial cell at each end
+ * never wraps, rounded up to a power of two for masking
+ */
+int SpatialGrid::ringCells(float cellWidth, float liveSpan)
+{
+    float width = std::max(1.0f, cellWidth);
+    int needed = (int)std::ceil(std::max(0.0f, liveSpan) / width) + 2;
+    int n = 1;
+    while (n < needed)
+    {
+        n *= 2;
+    }
+    return n;
+}
+
+/**
+ * storageBytes: Cell slots, cell sizes, extents and the overflow list
+ */
+size_t SpatialGrid::storageBytes(float cellWidth, float liveSpan, int handles, int cellSlots)
+{
+    size_t n = (size_t)ringCells(cellWidth, liveSpan);
+    size_t h = (size_t)std::max(0, handles);
+    return Arena::footprintOf<int>(n * (size_t)std::max(1, cellSlots)) + Arena::footprintOf<int>(n)
+         + Arena::footprintOf<Extent>(h) + Arena::footprintOf<int>(h);
+}
+
+/**
+ * reset: Carve fresh arrays and clear every cell
+ * (the arena makes this O(cells + handles), with no heap traffic)
+ */
+void SpatialGrid::reset(float cellWidth, float liveSpan, int handles, int slots, Arena &arena)
+{
+    float width = std::max(1.0f, cellWidth);
+    inverseCell = 1.0 / (double)width;
+    origin = 0.0;
+
+    int n = ringCells(cellWidth, liveSpan);
+    cellMask = n - 1;
+    cellSlots = std::max(1, slots);
+    handles = std::max(0, handles);
+
+    cellHandles.allocate(arena, n * cellSlots);
+    cellSize.allocate(arena, n);
+    extents.allocate(arena, handles);
+    overflow.allocate(arena, handles);
+    std::fill(cellSize.begin(), cellSize.end(), 0);
+    std::fill(extents.begin(), extents.end(), Extent());
+    overflowCount = 0;
+}
+
+/**
+ * insert: Append the handle to each cell its extent touches
+ * (at most one pass round the ring, for objects wider than all cells);
+ * if any of those cells is full it goes to the overflow list alone, so
+ * a handle is never in both and queries report it once
+ */
+void SpatialGrid::insert(int handle, float x, float width)
+{
+    int first = key(x);
+    int last = key(x + width);
+    Extent &e = extents[handle];
+    e.first = first;
+    e.last = last;
+    int cells = spannedCells(e);
+
+    int *size = cellSize.data();
+    bool spilled = false;
+    for (int j = 0; j < cells; j++)
+    {
+        spilled = spilled || size[cellIndex(first + j)] >= cellSlots;
+    }
+    e.spilled = spilled;
+    if (spilled)
+    {
+        overflow[overflowCount++] = handle;
+        return;
+    }
+    int *slots = cellHandles.data();
+    for (int j = 0; j < cells; j++)
+    {
+        int c = cellIndex(first + j);
+        slots[c * cellSlots + size[c]++] = handle;
+    }
+}
+
+/**
+ * remove: Swap-and-pop the handle out of each cell it was inserted into
+ * (or out of the overflow list)
+ */
+void SpatialGrid::remove(int handle)
+{
+    Extent &e = extents[handle];
+    if (e.last < e.first)
+    {
+        return;
+    }
+    if (e.spilled)
+    {
+        int *end = overflow.begin() + overflowCount;
+        int *it = std::find(overflow.begin(), end, handle);
+        if (it != end)
+        {
+            *it = overflow[--overflowCount];
+        }
+    }
+    else
+    {
+        int cells = spannedCells(e);
+        for (int j = 0; j < cells; j++)
+        {
+            int c = cellIndex(e.first + j);
+            int *cell = &cellHandles[c * cellSlots];
+            int *end = cell + cellSize[c];
+            int *it = std::find(cell, end, handle);
+            if (it != end)
+            {
+                *it = cell[--cellSize[c]];
+            }
+        }
+    }
+    e = Extent();
+}
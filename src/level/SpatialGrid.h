@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+#include "../memory/Arena.h"
+
+/**
+ * SpatialGrid: Uniform 1D grid over world X (broadphase)
+ *
+ * Any entity type can register its objects here under small integer
+ * handles (indices into the owner's own arrays - Level uses ring slots)
+ * with their X extent. query() then visits only the objects in the one or
+ * two cells under a range instead of scanning every object.
+ *
+ * Scrolling:
+ * - The whole world scrolls together, so objects never change cell. Cells
+ *   are keyed in grid space (world X minus a running origin), and shift()
+ *   moves the origin in O(1) instead of re-bucketing anything
+ * - Owners only touch the grid when an object appears (insert) or is
+ *   recycled (remove), which keeps updates incremental
+ *
+ * Cells:
+ * - Choose cellWidth >= the widest object, so an object spans at most two
+ *   cells (Level uses maxGap + maxPlatformWidth)
+ * - Cells form a ring of enough cells to cover liveSpan, the widest X range
+ *   live objects can occupy at once (rounded up to a power of two n);
+ *   ring cell k holds grid keys k, k + n, ...
+ *   Keys that alias are filtered by the stored extent, so an undersized
+ *   ring is slower, never wrong
+ * - Each cell holds up to cellSlots handles in one flat arena array (the
+ *   owner's bound on objects per cell); an object that finds a full cell
+ *   goes to a shared overflow list instead, so a low bound is slower,
+ *   never wrong. insert/remove never allocate
+ *
+ * Queries are conservative: every object within kSlack of the range is
+ * visited (and maybe a few more), so narrowphase tests on the owner's exact
+ * positions decide. Each object is visited once per query.
+ */
+class SpatialGrid
+{
+public:
+    /**
+     * kSlack: Query margin (pixels) absorbing rounding between the grid's
+     * origin and the owners' own per-frame float positions
+     */
+    static constexpr float kSlack = 1.0f;
+
+    /**
+     * reset: Empty the grid, set its geometry and carve its storage from arena
+     * - cellWidth: cell size in pixels (at least the widest object)
+     * - liveSpan:  widest X range the live objects cover at any time
+     * - handles:   handles are 0..handles-1
+     * - cellSlots: most objects expected to touch one cell at once
+     * Previous storage is abandoned (the arena's owner recycles it)
+     */
+    void reset(float cellWidth, float liveSpan, int handles, int cellSlots, Arena &arena);
+
+    /**
+     * storageBytes: Arena bytes reset() takes for these settings
+     */
+    static size_t storageBytes(float cellWidth, float liveSpan, int handles, int cellSlots);
+
+    /**
+     * shift: Every registered object moved by dx (O(1))
+     */
+    void shift(float dx)
+    {
+        origin += dx;
+    }
+
+    /**
+     * insert: Register handle with its current extent [x, x + width]
+     * (handle must not already be registered)
+     */
+    void insert(int handle, float x, float width);
+
+    /**
+     * remove: Unregister handle (no-op if it isn't registered)
+     */
+    void remove(int handle);
+
+    /**
+     * contains: Is handle registered?
+     */
+    bool contains(int handle) const
+    {
+        return extents[handle].last >= extents[handle].first;
+    }
+
+    /**
+     * query: Call visit(handle) for every object whose extent may overlap
+     * [minX, maxX] (current world X)
+     */
+    template <typename Visit>
+    void query(float minX, float maxX, Visit visit) const
+    {
+        int k0 = key(minX - kSlack);
+        int k1 = key(maxX + kSlack);
+        for (int k = k0; k <= k1; k++)
+        {
+            int c = cellIndex(k);
+            const int *cell = &cellHandles[c * cellSlots];
+            for (int j = 0; j < cellSize[c]; j++)
+            {
+                int handle = cell[j];
+                const Extent &e = extents[handle];
+                // Skip aliased keys; report objects spanning several cells
+                // only in the first cell of theirs that the query reaches
+                if (k >= e.first && k <= e.last && k == (e.first > k0 ? e.first : k0))
+                {
+                    visit(handle);
+                }
+            }
+        }
+        for (int j = 0; j < overflowCount; j++)
+        {
+            const Extent &e = extents[overflow[j]];
+            if (e.first <= k1 && e.last >= k0)
+            {
+                visit(overflow[j]);
+            }
+        }
+    }
+
+    /**
+     * cellCount: Cells in the ring
+     */
+    int cellCount() const { return cellMask + 1; }
+
+private:
+    /**
+     * Extent: Grid keys of a registered object's first and last cell
+     * (last < first = not registered)
+     */
+    struct Extent
+    {
+        int first = 0;   // 32 bits cover 2^31 cells (~1e12 px at Level's cell size)
+        int last = -1;
+        bool spilled = false;  // In the overflow list instead of the cells
+    };
+
+    /**
+     * ringCells: Ring size for a live span (power of two)
+     */
+    static int ringCells(float cellWidth, float liveSpan);
+
+    /**
+     * spannedCells: Ring cells an extent occupies (a full lap at most)
+     */
+    int spannedCells(const Extent &e) const
+    {
+        return (e.last - e.first + 1 < cellMask + 1) ? e.last - e.first + 1 : cellMask + 1;
+    }
+
+    /**
+     * key: Grid key of world X (cell number in grid space)
+     * floor() by hand: truncate, then step down for negative fractions
+     * (inline - std::floor is a library call without SSE4.1)
+     */
+    int key(float x) const
+    {
+        double g = ((double)x - origin) * inverseCell;
+        int k = (int)g;
+        return ((double)k > g) ? k - 1 : k;
+    }
+
+    /**
+     * cellIndex: Ring cell holding grid key k (ring size is a power of two,
+     * and two's complement masking wraps negative keys correctly)
+     */
+    int cellIndex(int k) const
+    {
+        return (int)(k & cellMask);
+    }
+
+    double origin = 0.0;                   // Grid X = world X - origin (double: endless runs scroll far)
+    double inverseCell = 1.0;              // 1 / cellWidth
+    int cellMask = 0;                      // Ring cells - 1
+    int cellSlots = 0;                     // Handle slots per cell
+    ArenaArray<int> cellHandles;           // cellSlots handles per ring cell (cell-major)
+    ArenaArray<int> cellSize;              // Handles in use per ring cell
+    ArenaArray<Extent> extents;            // Registered extent per handle
+    ArenaArray<int> overflow;              // Handles that found a full cell
+    int overflowCount = 0;                 // Live entries in overflow
+};
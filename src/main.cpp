@@ -1,8 +1,86 @@
 #include "game/Game.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
 
-int main()
+/**
+ * main: Play random levels, or the stages of a level pack
+ * USAGE: game [--demo] [--curve] [--telemetry events.ndjson] [--ghost run.replay]... [levels.pack]
+ *        game --benchmark run.replay...
+ * - --demo: attract mode (the bot plays until Space is pressed)
+ * - --curve: random levels follow GameConfig's difficulty ramp
+ *   (curveFrom -> curveTo, CurveGenerator) instead of staying flat
+ * - --telemetry: append run events to a file as NDJSON ("-" = stdout)
+ * - --ghost: race a recorded run (repeat for up to 8 ghosts on the same level)
+ * - --benchmark: play replays offscreen as fast as possible and print frame
+ *   times (Game::benchmark; the PGO training run of release-pgo)
+ */
+int main(int argc, char **argv)
 {
     Game game;
-    game.run();
+    if (argc > 1 && std::strcmp(argv[1], "--benchmark") == 0)
+    {
+        std::vector<std::string> replays(argv + 2, argv + argc);
+        std::vector<float> frameMs;
+        bool reproduced = game.benchmark(replays, frameMs);
+        std::sort(frameMs.begin(), frameMs.end());
+        if (!frameMs.empty())
+        {
+            std::printf("%zu frames: p50 %.3f ms, p99 %.3f ms\n", frameMs.size(),
+                        frameMs[frameMs.size() / 2], frameMs[std::min(frameMs.size() - 1, frameMs.size() * 99 / 100)]);
+        }
+        if (!reproduced)
+        {
+            std::fprintf(stderr, "a replay was unreadable or didn't reproduce (or the layout is too large to checkpoint)\n");
+        }
+        return reproduced ? 0 : 1;
+    }
+
+    int arg = 1;
+    for (; arg < argc; arg++)
+    {
+        if (std::strcmp(argv[arg], "--demo") == 0)
+        {
+            game.setDemo(true);
+        }
+        else if (std::strcmp(argv[arg], "--curve") == 0)
+        {
+            game.setCurveLevels(true);
+        }
+        else if (std::strcmp(argv[arg], "--telemetry") == 0 && arg + 1 < argc)
+        {
+            arg++;
+            if (!game.openTelemetry(argv[arg]))
+            {
+                std::fprintf(stderr, "cannot open telemetry output %s\n", argv[arg]);
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[arg], "--ghost") == 0 && arg + 1 < argc)
+        {
+            arg++;
+            if (!game.addGhost(argv[arg]))
+            {
+                std::fprintf(stderr, "cannot race %s (unreadable, too many ghosts, or another level or config)\n", argv[arg]);
+                return 1;
+            }
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (arg < argc && !game.openLevelPack(argv[arg]))
+    {
+        std::fprintf(stderr, "cannot open level pack %s (unreadable, empty, or a stage too large to checkpoint)\n", argv[arg]);
+        return 1;
+    }
+    if (!game.run())
+    {
+        std::fprintf(stderr, "level layout needs more storage than a checkpoint holds (LevelSnapshot::kStorageBytes)\n");
+        return 1;
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,644 @@
+/**
+ * Benchmark runner: Microbenchmarks for the Level and Player hot paths
+ *
+ * Self-contained harness (no external benchmark library, no raylib).
+ * Every case times a tight loop of one operation and reports nanoseconds
+ * per operation:
+ *   - generate:       Level::generate (full level + clouds)
+ *   - loadStage:      Level::load of a memory-mapped level pack stage
+ *   - scroll:         Level::scroll by one fixed step (camera, streaming, clouds)
+ *   - checkCollision: Level::checkCollision with the ball over a platform
+ *   - resolveLanding: Level::resolveLanding for a ball crossing a platform top
+ *   - awardScore:     Level::awardScore passing exactly one platform
+ *   - playerUpdate:   Player::update (gravity + jump hold), float and Q16.16
+ *   - broadphase:     X-range query over N small objects across the live
+ *                     span, through a SpatialGrid vs a linear scan
+ *   - snapshot:       Simulation::capture / restore of a run 10 s in
+ *   - batchStep:      BatchSim::step of 64 games with scripted jumps, through
+ *                     the runtime-tuning and the compile-time production kernel
+ *   - telemetry:      Telemetry::push of one event, with no output open and
+ *                     into a live writer (bursts of half the ring, timed
+ *                     while the writer sleeps - the game thread's cost)
+ * Level cases run for totalPlatforms 200 / 10k / 1M; generate and scroll
+ * (the only ones that touch clouds) also sweep cloudCount.
+ *
+ * Timing:
+ * - Iterations are calibrated so one repetition takes about minTime seconds
+ * - Each case runs kRepetitions times; the fastest repetition is reported
+ *   (least disturbed by the OS), the mean is reported alongside
+ *
+ * Output:
+ * - A table on stdout
+ * - JSON written to jsonPath, with Google Benchmark style fields
+ *   (name, iterations, real_time, time_unit) so its compare tools work
+ *
+ * USAGE:
+ *   bench [jsonPath] [minTime] [filter]
+ *   - jsonPath: JSON result file (default bench.json, "-" = don't write)
+ *   - minTime:  seconds per repetition (default 0.05)
+ *   - filter:   only run cases whose name contains this text (default all)
+ */
+
+#include "level/Level.h"
+#include "level/LevelPack.h"
+#include "level/PlatformKernels.h"
+#include "level/SpatialGrid.h"
+#include "memory/Arena.h"
+#include "player/Player.h"
+#include "sim/BatchSim.h"
+#include "sim/RunEvaluator.h"
+#include "sim/Simulation.h"
+#include "telemetry/Telemetry.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const int kRepetitions = 5;
+
+/**
+ * benchSink: Results are folded in here so the optimizer can't drop the work
+ */
+static volatile double benchSink = 0.0;
+
+/**
+ * BenchResult: Timing of one benchmark case
+ */
+struct BenchResult
+{
+    std::string name;       // "case/platforms:N/clouds:M"
+    std::string caseName;   // Operation being timed
+    int totalPlatforms;     // Level size (0 = not a level case)
+    int cloudCount;         // Clouds in the level
+    long long iterations;   // Operations per repetition
+    double bestNs;          // Fastest repetition, ns per operation
+    double meanNs;          // Mean over repetitions, ns per operation
+};
+
+/**
+ * secondsSince: Wall time elapsed since start
+ */
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * measure: Calibrate and time body(iterations)
+ * body must run the operation `iterations` times in a loop
+ */
+template <typename Body>
+static void measure(Body body, double minTime, long long &iterations, double &bestNs, double &meanNs)
+{
+    // Grow the iteration count until one run takes a measurable slice of minTime
+    iterations = 1;
+    for (;;)
+    {
+        auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        double seconds = secondsSince(start);
+        if (seconds >= minTime * 0.1 || iterations >= (1LL << 40))
+        {
+            double scale = seconds > 0.0 ? minTime / seconds : 10.0;
+            iterations = std::max(1LL, (long long)(iterations * std::min(scale, 10.0)));
+            break;
+        }
+        iterations *= 10;
+    }
+
+    bestNs = 0.0;
+    double total = 0.0;
+    for (int r = 0; r < kRepetitions; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        double ns = secondsSince(start) * 1e9 / (double)iterations;
+        bestNs = (r == 0) ? ns : std::min(bestNs, ns);
+        total += ns;
+    }
+    meanNs = total / kRepetitions;
+}
+
+/**
+ * makeConfig: Default config with the swept parameters applied
+ */
+static GameConfig makeConfig(int totalPlatforms, int cloudCount)
+{
+    GameConfig cfg;
+    cfg.totalPlatforms = totalPlatforms;
+    cfg.cloudCount = cloudCount;
+    return cfg;
+}
+
+/**
+ * scrollUnderBall: Scroll a fresh level until the middle of its first
+ * platform is under ballX (so queries see real platforms, as in play)
+ */
+static void scrollUnderBall(Level &level, const GameConfig &cfg, float ballX)
+{
+    Platform first = level.platform(0);
+    float distance = first.x + first.width * 0.5f - level.worldX(ballX);
+    level.scroll(distance / cfg.scrollSpeed, cfg);
+}
+
+/**
+ * runLevelCase: Time one Level operation for one parameter set
+ */
+static BenchResult runLevelCase(const char *caseName, int totalPlatforms, int cloudCount, double minTime)
+{
+    GameConfig cfg = makeConfig(totalPlatforms, cloudCount);
+    Level level;
+    level.generate(cfg);
+
+    float ballX = cfg.screenWidth * 0.25f;  // Same fixed X as Player::reset
+    float radius = cfg.radius;
+    float dt = cfg.fixedTimestep;
+    scrollUnderBall(level, cfg, ballX);
+    Platform under = level.platform(0);
+
+    BenchResult result;
+    result.name = std::string(caseName) + "/platforms:" + std::to_string(totalPlatforms) + "/clouds:" + std::to_string(cloudCount);
+    result.caseName = caseName;
+    result.totalPlatforms = totalPlatforms;
+    result.cloudCount = cloudCount;
+
+    if (std::strcmp(caseName, "generate") == 0)
+    {
+        measure([&](long long n)
+        {
+            for (long long i = 0; i < n; i++)
+            {
+                level.generate(cfg);
+                benchSink = benchSink + level.platformX[0];
+            }
+        }, minTime, result.iterations, result.bestNs, result.meanNs);
+    }
+    else if (std::strcmp(caseName, "loadStage") == 0)
+    {
+        // One-stage pack of the same level, written next to the JSON and removed after
+        const char *packPath = "bench_stage.pack";
+        LevelPack pack;
+        LevelStage stage;
+        std::vector<std::vector<Platform>> stageList(1, LevelPack::generateStage(cfg));
+        if (!LevelPack::write(packPath, stageList) || !pack.open(packPath) || !pack.stage(0, stage))
+        {
+            std::fprintf(stderr, "bench: could not create %s\n", packPath);
+            result.iterations = 0;
+            result.bestNs = result.meanNs = 0.0;
+            std::remove(packPath);
+            return result;
+        }
+        measure([&](long long n)
+        {
+            for (long long i = 0; i < n; i++)
+            {
+                level.load(stage, cfg);
+                benchSink = benchSink + level.platformX[0];
+            }
+        }, minTime, result.iterations, result.bestNs, result.meanNs);
+        pack.close();
+        std::remove(packPath);
+    }
+    else if (std::strcmp(caseName, "scroll") == 0)
+    {
+        measure([&](long long n)
+        {
+            for (long long i = 0; i < n; i++)
+            {
+                level.scroll(dt, cfg);
+            }
+            benchSink = benchSink + level.platformX[level.head];
+        }, minTime, result.iterations, result.bestNs, result.meanNs);
+    }
+    else if (std::strcmp(caseName, "checkCollision") == 0)
+    {
+        // Ball heights sweep from above the platform through it (hits and misses)
+        measure([&](long long n)
+        {
+            int hits = 0;
+            for (long long i = 0; i < n; i++)
+            {
+                float ballY = under.yTop - 2.0f * radius + (float)(i & 63);
+                hits += level.checkCollision(ballX, ballY, radius, cfg) ? 1 : 0;
+            }
+            benchSink = benchSink + hits;
+        }, minTime, result.iterations, result.bestNs, result.meanNs);
+    }
+    else if (std::strcmp(caseName, "resolveLanding") == 0)
+    {
+        // Ball falls across the platform top this step
+        measure([&](long long n)
+        {
+            float total = 0.0f;
+            for (long long i = 0; i < n; i++)
+            {
+                float prevY = under.yTop - radius - 1.0f - (float)(i & 7);
+                float y = under.yTop - radius + 2.0f;
+                float vy = 300.0f;
+                bool landedOnGround = false;
+                level.resolveLanding(ballX, prevY, y, vy, radius, cfg, landedOnGround);
+                total += y;
+            }
+            benchSink = benchSink + total;
+        }, minTime, result.iterations, result.bestNs, result.meanNs);
+    }
+    else if (std::strcmp(caseName, "awardScore") == 0)
+    {
+        // Ball just past the first platform's right edge: exactly one platform scores
+        float passedX = under.x + under.width + radius + 1.0f;
+        measure([&](long long n)
+        {
+            int gained = 0;
+            for (long long i = 0; i < n; i++)
+            {
+                level.scoreCursor = 0;
+                gained += level.awardScore(passedX, radius);
+            }
+            benchSink = benchSink + gained;
+        }, minTime, result.iterations, result.bestNs, result.meanNs);
+    }
+    return result;
+}
+
+/**
+ * runPlayerCase: Time Player::update (independent of level size) for one
+ * physics number type
+ * Falling below the ground is clamped like a landing so the state stays in range
+ */
+template <typename Scalar>
+static BenchResult runPlayerCase(double minTime)
+{
+    typedef ScalarTraits<Scalar> Traits;
+    GameConfig cfg;
+    BasicPlayer<Scalar> player;
+    player.reset(cfg);
+    player.startJump();
+    float dt = cfg.fixedTimestep;
+    const Scalar groundY = Traits::fromFloat(cfg.groundY);
+    const Scalar jumpVelocity = Traits::fromFloat(cfg.jumpVelocity);
+
+    BenchResult result;
+    result.name = std::string("playerUpdate/scalar:") + Traits::name();
+    result.caseName = "playerUpdate";
+    result.totalPlatforms = 0;
+    result.cloudCount = 0;
+    measure([&](long long n)
+    {
+        for (long long i = 0; i < n; i++)
+        {
+            player.update(dt, (i & 31) < 8, cfg);
+            if (player.y > groundY)
+            {
+                player.y = groundY;
+                player.vy = jumpVelocity;  // Bounce: keeps jump-hold branches live
+                player.isJumping = true;
+                player.jumpHoldTimer = Scalar();
+            }
+        }
+        benchSink = benchSink + Traits::toFloat(player.y);
+    }, minTime, result.iterations, result.bestNs, result.meanNs);
+    return result;
+}
+
+/**
+ * runBroadphaseCase: Time one ball-sized X-range query over `objects`
+ * hazard-sized objects (16 px wide, evenly spread over the live span)
+ * - grid:   SpatialGrid with 64 px cells, then the exact overlap test per visit
+ * - linear: the overlap test on every object
+ * Query positions sweep the span so both hits and empty cells are timed
+ */
+static BenchResult runBroadphaseCase(bool useGrid, int objects, double minTime)
+{
+    GameConfig cfg;
+    const float span = (float)cfg.screenWidth + cfg.generateAhead;
+    const float objectWidth = 16.0f;
+    std::vector<float> x(objects);
+    const float cellWidth = 64.0f;
+    int cellSlots = (int)std::ceil((cellWidth + objectWidth) * (float)objects / span) + 1;  // Objects touching one cell
+    Arena arena(SpatialGrid::storageBytes(cellWidth, span, objects, cellSlots));
+    SpatialGrid grid;
+    grid.reset(cellWidth, span, objects, cellSlots, arena);
+    for (int i = 0; i < objects; i++)
+    {
+        x[i] = span * (float)i / (float)objects;
+        grid.insert(i, x[i], objectWidth);
+    }
+    float radius = cfg.radius;
+
+    BenchResult result;
+    result.name = std::string("broadphase/") + (useGrid ? "grid" : "linear") + "/objects:" + std::to_string(objects);
+    result.caseName = "broadphase";
+    result.totalPlatforms = 0;
+    result.cloudCount = 0;
+    measure([&](long long n)
+    {
+        int hits = 0;
+        for (long long i = 0; i < n; i++)
+        {
+            float ballX = (float)((i * 37) % (long long)span);
+            float minX = ballX - radius;
+            float maxX = ballX + radius;
+            if (useGrid)
+            {
+                grid.query(minX, maxX, [&](int k)
+                {
+                    hits += (x[k] <= maxX && x[k] + objectWidth >= minX) ? 1 : 0;
+                });
+            }
+            else
+            {
+                for (int k = 0; k < objects; k++)
+                {
+                    hits += (x[k] <= maxX && x[k] + objectWidth >= minX) ? 1 : 0;
+                }
+            }
+        }
+        benchSink = benchSink + hits;
+    }, minTime, result.iterations, result.bestNs, result.meanNs);
+    return result;
+}
+
+/**
+ * runSnapshotCase: Time capturing (or restoring) a default run 10 s in
+ * (restore alternates with nothing else, so it copies the same bytes back)
+ */
+static BenchResult runSnapshotCase(bool restore, double minTime)
+{
+    GameConfig cfg;
+    Simulation sim(cfg);
+    sim.reset();
+    for (int i = 0; i < 1200; i++)
+    {
+        sim.step(FrameInput(), cfg.fixedTimestep);
+    }
+    std::vector<SimSnapshot> snapshot(1);  // ~4.5 KB: keep it off the stack
+    sim.capture(snapshot[0]);
+
+    BenchResult result;
+    result.name = restore ? "snapshot/restore" : "snapshot/capture";
+    result.caseName = "snapshot";
+    result.totalPlatforms = cfg.totalPlatforms;
+    result.cloudCount = cfg.cloudCount;
+    measure([&](long long n)
+    {
+        bool ok = true;
+        for (long long i = 0; i < n; i++)
+        {
+            ok = (restore ? sim.restore(snapshot[0]) : sim.capture(snapshot[0])) && ok;
+        }
+        benchSink = benchSink + (ok ? snapshot[0].level.storage[0] : -1.0);
+    }, minTime, result.iterations, result.bestNs, result.meanNs);
+    return result;
+}
+
+/**
+ * runBatchCase: Time one BatchSim::step of kGames default games
+ * - specialized: ProductionTuning kernel; otherwise the RuntimeTuning one
+ *   (same settings, so both do identical work)
+ * - Games jump on staggered ScriptedPolicy frames and are restarted with
+ *   new seeds as they finish, so every lane stays busy
+ */
+static BenchResult runBatchCase(bool specialized, double minTime)
+{
+    const int kGames = 64;
+    GameConfig cfg;
+    BatchSim batch(kGames, cfg);
+    batch.specialized = specialized;
+    batch.reset(1);
+    uint64_t nextSeed = 1 + kGames;
+    ScriptedPolicy policy;
+    policy.jumpDelay = 0;  // Jump from the first step: lanes keep dying and restarting (the workload this case times)
+    std::vector<FrameInput> inputs(kGames);
+
+    BenchResult result;
+    result.name = std::string("batchStep/tuning:") + (specialized ? "production" : "runtime") + "/games:" + std::to_string(kGames);
+    result.caseName = "batchStep";
+    result.totalPlatforms = cfg.totalPlatforms;
+    result.cloudCount = 0;
+    measure([&](long long n)
+    {
+        for (long long i = 0; i < n; i++)
+        {
+            for (int g = 0; g < kGames; g++)
+            {
+                inputs[g] = policy.input(batch.frame[g] + g);
+            }
+            batch.step(inputs.data(), cfg.fixedTimestep);
+            for (int g = 0; g < kGames; g++)
+            {
+                if (batch.isFinished(g))
+                {
+                    batch.resetGame(g, nextSeed++);
+                }
+            }
+        }
+        benchSink = benchSink + batch.score[0];
+    }, minTime, result.iterations, result.bestNs, result.meanNs);
+    return result;
+}
+
+/**
+ * runTelemetryCase: Time Telemetry::push of a Jump-sized event
+ * - open = false: nothing opened, push is the enabled() branch
+ * - open = true: writer on /dev/null; each repetition is one burst of
+ *   kCapacity / 2 pushes timed on its own, then the writer is let drain
+ *   the ring (so no push is dropped and its sleep isn't timed)
+ */
+static BenchResult runTelemetryCase(bool open, double minTime)
+{
+    Telemetry telemetry;
+    TelemetryEvent event;
+    event.type = TelemetryEventType::Jump;
+    event.amount = 0.1f;
+
+    BenchResult result;
+    result.name = std::string("telemetry/push:") + (open ? "writer" : "closed");
+    result.caseName = "telemetry";
+    result.totalPlatforms = 0;
+    result.cloudCount = 0;
+    if (!open)
+    {
+        measure([&](long long n)
+        {
+            for (long long i = 0; i < n; i++)
+            {
+                event.frame = (int32_t)i;
+                telemetry.push(event);
+            }
+            benchSink = benchSink + event.frame;
+        }, minTime, result.iterations, result.bestNs, result.meanNs);
+        return result;
+    }
+
+    if (!telemetry.open("/dev/null"))
+    {
+        std::fprintf(stderr, "bench: telemetry can't open /dev/null\n");
+        return result;
+    }
+    const int kBurst = Telemetry::kCapacity / 2;
+    long long pushed = 0;
+    result.iterations = kBurst;
+    result.bestNs = 0.0;
+    double total = 0.0;
+    for (int r = 0; r < kRepetitions; r++)
+    {
+        while (telemetry.written.load() + telemetry.dropped.load() < pushed)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));  // Ring empty again
+        }
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < kBurst; i++)
+        {
+            event.frame = i;
+            telemetry.push(event);
+        }
+        double ns = secondsSince(start) * 1e9 / kBurst;
+        pushed += kBurst;
+        result.bestNs = (r == 0) ? ns : std::min(result.bestNs, ns);
+        total += ns;
+    }
+    result.meanNs = total / kRepetitions;
+    telemetry.close();
+    if (telemetry.dropped.load() != 0)
+    {
+        std::fprintf(stderr, "bench: telemetry dropped %lld events\n", telemetry.dropped.load());
+    }
+    return result;
+}
+
+/**
+ * writeJson: Store results (plus build context) for regression tracking
+ */
+static bool writeJson(const char *path, const std::vector<BenchResult> &results, double minTime)
+{
+    std::FILE *file = std::fopen(path, "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    std::fprintf(file, "{\n  \"context\": {\n");
+    std::fprintf(file, "    \"kernels\": \"%s\",\n", platformKernels().name);
+    std::fprintf(file, "    \"min_time\": %.3f,\n", minTime);
+    std::fprintf(file, "    \"repetitions\": %d,\n", kRepetitions);
+#ifdef __OPTIMIZE__
+    std::fprintf(file, "    \"library_build_type\": \"release\"\n");
+#else
+    std::fprintf(file, "    \"library_build_type\": \"debug\"\n");
+#endif
+    std::fprintf(file, "  },\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult &r = results[i];
+        std::fprintf(file,
+                     "    {\"name\": \"%s\", \"case\": \"%s\", \"total_platforms\": %d, \"cloud_count\": %d, "
+                     "\"iterations\": %lld, \"real_time\": %.3f, \"mean_time\": %.3f, \"time_unit\": \"ns\"}%s\n",
+                     r.name.c_str(), r.caseName.c_str(), r.totalPlatforms, r.cloudCount,
+                     r.iterations, r.bestNs, r.meanNs, (i + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+
+    bool ok = std::ferror(file) == 0;
+    ok = (std::fclose(file) == 0) && ok;
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    const char *jsonPath = (argc > 1) ? argv[1] : "bench.json";
+    double minTime = (argc > 2) ? std::atof(argv[2]) : 0.05;
+    const char *filter = (argc > 3) ? argv[3] : "";
+    if (minTime <= 0.0) minTime = 0.05;
+
+    const int platformCounts[] = {200, 10000, 1000000};
+    const int cloudCounts[] = {10, 100};  // Default and a crowded sky
+    const char *levelCases[] = {"generate", "loadStage", "scroll", "checkCollision", "resolveLanding", "awardScore"};
+
+    std::vector<BenchResult> results;
+    std::printf("%-44s %14s %12s %12s\n", "benchmark", "iterations", "best ns/op", "mean ns/op");
+
+    auto report = [&](const BenchResult &r)
+    {
+        std::printf("%-44s %14lld %12.1f %12.1f\n", r.name.c_str(), r.iterations, r.bestNs, r.meanNs);
+        std::fflush(stdout);
+        results.push_back(r);
+    };
+
+    for (const char *caseName : levelCases)
+    {
+        bool usesClouds = std::strcmp(caseName, "generate") == 0 || std::strcmp(caseName, "scroll") == 0;
+        for (int platforms : platformCounts)
+        {
+            for (int clouds : cloudCounts)
+            {
+                if (!usesClouds && clouds != cloudCounts[0])
+                {
+                    continue;  // Clouds don't affect this case
+                }
+                std::string name = std::string(caseName) + "/platforms:" + std::to_string(platforms) + "/clouds:" + std::to_string(clouds);
+                if (name.find(filter) == std::string::npos)
+                {
+                    continue;
+                }
+                report(runLevelCase(caseName, platforms, clouds, minTime));
+            }
+        }
+    }
+    if (std::string("playerUpdate/scalar:float").find(filter) != std::string::npos)
+    {
+        report(runPlayerCase<float>(minTime));
+    }
+    if (std::string("playerUpdate/scalar:fixed").find(filter) != std::string::npos)
+    {
+        report(runPlayerCase<Q16_16>(minTime));
+    }
+    for (int objects : {100, 1000, 10000})
+    {
+        for (bool useGrid : {true, false})
+        {
+            std::string name = std::string("broadphase/") + (useGrid ? "grid" : "linear") + "/objects:" + std::to_string(objects);
+            if (name.find(filter) != std::string::npos)
+            {
+                report(runBroadphaseCase(useGrid, objects, minTime));
+            }
+        }
+    }
+    for (bool restore : {false, true})
+    {
+        if (std::string(restore ? "snapshot/restore" : "snapshot/capture").find(filter) != std::string::npos)
+        {
+            report(runSnapshotCase(restore, minTime));
+        }
+    }
+    for (bool specialized : {false, true})
+    {
+        std::string name = std::string("batchStep/tuning:") + (specialized ? "production" : "runtime") + "/games:64";
+        if (name.find(filter) != std::string::npos)
+        {
+            report(runBatchCase(specialized, minTime));
+        }
+    }
+    for (bool open : {false, true})
+    {
+        if (std::string(open ? "telemetry/push:writer" : "telemetry/push:closed").find(filter) != std::string::npos)
+        {
+            report(runTelemetryCase(open, minTime));
+        }
+    }
+
+    if (std::strcmp(jsonPath, "-") != 0)
+    {
+        if (!writeJson(jsonPath, results, minTime))
+        {
+            std::fprintf(stderr, "bench: could not write %s\n", jsonPath);
+            return 1;
+        }
+        std::printf("results written to %s\n", jsonPath);
+    }
+    return 0;
+}
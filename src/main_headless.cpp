@@ -0,0 +1,1026 @@
+/**
+ * Headless runner: Jumping Ball simulation without a window
+ *
+ * Drives Simulation::step at the fixed config timestep with scripted
+ * input and no InitWindow / BeginDrawing, so it runs on CI boxes and bot
+ * farms. Finished runs restart immediately until the step budget is used;
+ * run i uses level seed (seed + i), so every invocation is reproducible.
+ *
+ * With games > 1 the runs are simulated side by side in a BatchSim
+ * (one lane per game, finished lanes restart with the next seed).
+ *
+ * Replay mode plays a recorded run back as fast as possible and checks
+ * that it reproduces the recorded score and outcome (leaderboard check).
+ * Eval mode plays many complete runs across all cores (work-stealing
+ * ThreadPool) and prints score / death-frame / death-cause statistics.
+ * Pack mode writes generated levels to a memory-mapped level pack, then
+ * reopens it and checks every stage plays exactly like its seed.
+ * Bot mode lets the reference SearchBot play complete runs and reports
+ * its scores and how long its decisions take (the per-step budget).
+ * Restart mode restarts like the game does - every run prebuilt by the
+ * LevelPregenerator while the previous one is played - and checks each
+ * swapped-in run plays exactly like a freshly reset one.
+ * Coarse mode plays the same inputs at the default step and at a coarse
+ * one (e.g. 30 Hz), with and without continuous collision, and reports
+ * how many runs keep their outcome and how much faster the coarse step is.
+ * Race mode races ghosts against the bot on its level (GhostRace, one
+ * shared Level) and checks each ghost against a Simulation of its own.
+ * Curve mode generates levels that follow a difficulty ramp
+ * (CurveGenerator), times them against the pre-generation budget, shows
+ * target vs measured difficulty along the level and lets the bot play them.
+ *
+ * USAGE:
+ *   headless [steps] [jumpPeriod] [jumpHold] [seed] [games] [jumpDelay]
+ *   headless replay <file> [more files...]
+ *   headless eval [runs] [threads] [jumpPeriod] [jumpHold] [seed] [jumpDelay]
+ *   headless pack <file> [stages] [seed]
+ *   headless bot [runs] [seed] [maxSteps]
+ *   headless restart [runs] [seed] [curve]
+ *   headless coarse [runs] [hz] [seed]
+ *   headless race [runs] [ghosts] [seed]
+ *   headless curve [levels] [threads] [from] [to] [seed]
+ *   - steps:      total steps to simulate, summed over all games (default 1000000)
+ *   - jumpPeriod: press jump every N steps (default 40)
+ *   - jumpHold:   hold jump for N steps after pressing (default 8)
+ *   - jumpDelay:  steps before the first press (default 540, see ScriptedPolicy)
+ *   - seed:       level seed of the first run (default 1)
+ *   - games:      games simulated in lockstep (default 1 = single Simulation)
+ *   - replay:     exit status 0 if the replay verifies, 1 if not, 2 if unreadable
+ *                 (several files are verified in parallel; 0 only if all verify)
+ *   - eval:       runs = complete runs (default 100000), threads = 0 for all cores;
+ *                 exit status 1 if the scores don't spread (p90 == p10)
+ *   - pack:       stages = levels to write (default 1000), seeds seed, seed+1, ...
+ *                 exit status 0 if every stage reproduces its generated level
+ *   - bot:        runs = complete runs (default 20), one thread, runs longer
+ *                 than maxSteps (default 72000 = 10 min) are stopped
+ *   - restart:    runs = restarts (default 20), SearchBot input, curve = 1 for
+ *                 curve levels (GameConfig::curveLevels); exit status 0 if every
+ *                 run was swapped in, matched the synchronous reset and its
+ *                 recording verified
+ *   - coarse:     runs = bot runs (default 20), hz = coarse step rate (default 30,
+ *                 must divide the default rate); exit status 0 if every run
+ *                 ends the same at both rates with continuous collision
+ *   - race:       runs = bot runs (default 10), ghosts = racers (default 8), each
+ *                 a bot starting 6 * (g + 1) steps late; exit status 0 if every
+ *                 ghost matched its own Simulation on every step
+ *   - curve:      levels = generated levels (default 20), threads = pool size
+ *                 (default 4), difficulty ramps from `from` to `to` (default
+ *                 0.5 -> 0.7); exit status 0 if every jump passed the envelope
+ *                 without falling back
+ */
+
+#include "sim/Simulation.h"
+#include "sim/BatchSim.h"
+#include "sim/Replay.h"
+#include "sim/RunEvaluator.h"
+#include "sim/LevelPregenerator.h"
+#include "sim/GhostRace.h"
+#include "sim/CurveGenerator.h"
+#include "parallel/ThreadPool.h"
+#include "level/LevelPack.h"
+#include "control/SearchBot.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * RunTotals: Aggregated results of all finished runs
+ */
+struct RunTotals
+{
+    long long runs = 0;
+    long long wins = 0;
+    long long totalScore = 0;
+    int bestScore = 0;
+
+    void add(int score, bool complete)
+    {
+        runs++;
+        wins += complete ? 1 : 0;
+        totalScore += score;
+        if (score > bestScore) bestScore = score;
+    }
+};
+
+/**
+ * runSingle: Step one Simulation, restarting it with the next seed on finish
+ */
+static void runSingle(RunTotals &totals, GameConfig cfg, long long steps, const ScriptedPolicy &policy, uint64_t seed)
+{
+    cfg.seed = seed;
+    Simulation sim(cfg);
+    sim.reset();
+    uint64_t nextSeed = seed + 1;
+    float dt = cfg.fixedTimestep;
+
+    for (long long i = 0; i < steps; i++)
+    {
+        sim.step(policy.input(sim.frame), dt);
+
+        // Record finished run and start the next one
+        if (sim.isFinished())
+        {
+            totals.add(sim.score, sim.levelComplete);
+            sim.config.seed = nextSeed++;  // Next run, next level
+            sim.reset();
+        }
+    }
+}
+
+/**
+ * runBatch: Step games lanes of a BatchSim until the step budget is used
+ * Finished lanes are recorded and restarted with the next unused seed
+ */
+static void runBatch(RunTotals &totals, const GameConfig &cfg, long long steps, const ScriptedPolicy &policy, uint64_t seed, int games)
+{
+    BatchSim batch(games, cfg);
+    batch.reset(seed);
+    uint64_t nextSeed = seed + (uint64_t)games;
+    std::vector<FrameInput> inputs((size_t)games);
+    float dt = cfg.fixedTimestep;
+
+    for (long long done = 0; done < steps; done += games)
+    {
+        for (int g = 0; g < games; g++)
+        {
+            inputs[g] = policy.input(batch.frame[g]);
+        }
+        batch.step(inputs.data(), dt);
+
+        for (int g = 0; g < games; g++)
+        {
+            if (batch.isFinished(g))
+            {
+                totals.add(batch.score[g], batch.levelComplete[g] != 0);
+                batch.resetGame(g, nextSeed++);
+            }
+        }
+    }
+}
+
+/**
+ * runReplay: Re-simulate a recorded run and compare against its footer
+ * - Config is rebuilt from the replay (seed, mode, curve ramp) and must hash
+ *   to the recorded value, otherwise the result can't be trusted
+ * - See playReplay for the comparison
+ */
+static int runReplay(const char *path)
+{
+    ReplayReader reader;
+    if (!reader.open(path))
+    {
+        std::printf("replay:      cannot read %s\n", path);
+        return 2;
+    }
+
+    bool configMatches = configHash(reader.config()) == reader.hash;
+    Simulation sim;
+
+    auto start = std::chrono::steady_clock::now();
+    bool verified = playReplay(reader, sim);
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double realTime = sim.frame * sim.config.fixedTimestep;
+
+    std::printf("replay:      %s (seed %llu, %s physics%s%s)\n", path, (unsigned long long)reader.seed,
+                reader.fixedPhysics ? "fixed" : "float", reader.endless ? ", endless" : "",
+                reader.curveLevels ? ", curve level" : "");
+    std::printf("config:      %s\n", configMatches ? "matches" :
+                reader.fixedPhysics != kPhysicsFixed ? "MISMATCH (recorded with the other physics number type)" :
+                "MISMATCH (different build or settings)");
+    std::printf("recorded:    score %d, %lld steps, %s\n", reader.result.score, reader.result.frames,
+                !reader.complete ? "truncated" : reader.result.levelComplete ? "complete" : reader.result.gameOver ? "game over" : "unfinished");
+    std::printf("replayed:    score %d, %lld steps, %s\n", sim.score, sim.frame,
+                sim.levelComplete ? "complete" : sim.gameOver ? "game over" : "unfinished");
+    std::printf("elapsed:     %.4f s (%.0fx real time)\n", seconds, seconds > 0.0 ? realTime / seconds : 0.0);
+    std::printf("verified:    %s\n", verified ? "yes" : "NO");
+    return verified ? 0 : 1;
+}
+
+/**
+ * printHistogram: Summary of an evaluation (outcomes, score spread, death times)
+ */
+static void printHistogram(const RunHistogram &h, int totalPlatforms, double seconds, int threads)
+{
+    long long deaths = h.groundDeaths + h.platformDeaths;
+    double dt = GameConfig().fixedTimestep;
+    std::printf("runs:        %lld on %d thread%s (%lld complete, %lld stopped)\n", h.runs, threads, threads == 1 ? "" : "s", h.wins, h.unfinished);
+    std::printf("deaths:      %lld ground, %lld platform side\n", h.groundDeaths, h.platformDeaths);
+    std::printf("score:       p50 %d, p90 %d, p99 %d, max %d / %d\n",
+                h.scorePercentile(0.50), h.scorePercentile(0.90), h.scorePercentile(0.99), h.scorePercentile(1.0), totalPlatforms);
+    if (deaths > 0)
+    {
+        std::printf("death time:  p50 %.0f s, p90 %.0f s (1 s buckets)\n",
+                    h.deathFramePercentile(0.50) * dt, h.deathFramePercentile(0.90) * dt);
+    }
+    std::printf("elapsed:     %.3f s\n", seconds);
+    std::printf("runs/sec:    %.0f (%.0f steps/sec)\n", seconds > 0.0 ? h.runs / seconds : 0.0, seconds > 0.0 ? h.steps / seconds : 0.0);
+}
+
+/**
+ * runReplays: Verify several replays in parallel
+ */
+static int runReplays(const std::vector<std::string> &paths)
+{
+    ThreadPool pool;
+    RunEvaluator evaluator(pool);
+
+    auto start = std::chrono::steady_clock::now();
+    RunHistogram h = evaluator.evaluateReplays(paths);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printHistogram(h, GameConfig().totalPlatforms, seconds, pool.threadCount());
+    std::printf("verified:    %lld / %zu\n", h.verified, paths.size());
+    return (h.failed == 0) ? 0 : 1;
+}
+
+/**
+ * runEval: Play full runs of consecutive seeds across all cores
+ * - Fails unless the scores spread (p90 above p10): runs that all end the
+ *   same way, like a policy that never reaches a platform, measure nothing
+ */
+static int runEval(int argc, char **argv)
+{
+    long long runs = (argc > 2) ? std::atoll(argv[2]) : 100000;
+    int threads = (argc > 3) ? std::atoi(argv[3]) : 0;
+    ScriptedPolicy policy;
+    policy.jumpPeriod = (argc > 4) ? std::max(1, std::atoi(argv[4])) : policy.jumpPeriod;
+    policy.jumpHold = (argc > 5) ? std::atoi(argv[5]) : policy.jumpHold;
+    uint64_t seed = (argc > 6) ? std::strtoull(argv[6], nullptr, 10) : 1;
+    policy.jumpDelay = (argc > 7) ? std::max(0, std::atoi(argv[7])) : policy.jumpDelay;
+
+    GameConfig cfg;
+    ThreadPool pool(threads);
+    RunEvaluator evaluator(pool);
+
+    auto start = std::chrono::steady_clock::now();
+    RunHistogram h = evaluator.evaluateSeeds(cfg, seed, runs, policy);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printHistogram(h, cfg.totalPlatforms, seconds, pool.threadCount());
+    int low = h.scorePercentile(0.10), high = h.scorePercentile(0.90);
+    bool spread = high > low;
+    std::printf("spread:      p10 %d .. p90 %d%s\n", low, high, spread ? "" : " (every run ends alike - nothing measured)");
+    return spread ? 0 : 1;
+}
+
+/**
+ * runPack: Build a level pack from consecutive seeds and verify it
+ * - Every stage must scroll through exactly the platforms Level::generate
+ *   gives its seed
+ * - Prints the pack size and how long opening and switching stages take
+ */
+static int runPack(int argc, char **argv)
+{
+    const char *path = argv[2];
+    int stageTotal = (argc > 3) ? std::max(0, std::atoi(argv[3])) : 1000;
+    uint64_t seed = (argc > 4) ? std::strtoull(argv[4], nullptr, 10) : 1;
+
+    GameConfig cfg;
+    std::vector<std::vector<Platform>> stageList((size_t)stageTotal);
+    for (int i = 0; i < stageTotal; i++)
+    {
+        cfg.seed = seed + (uint64_t)i;
+        stageList[(size_t)i] = LevelPack::generateStage(cfg);
+    }
+    if (!LevelPack::write(path, stageList))
+    {
+        std::printf("pack:        cannot write %s\n", path);
+        return 2;
+    }
+
+    LevelPack pack;
+    auto start = std::chrono::steady_clock::now();
+    bool opened = pack.open(path);
+    double openSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!opened || pack.stageCount() != stageTotal)
+    {
+        std::printf("pack:        cannot read back %s\n", path);
+        return 2;
+    }
+
+    // Stage switching alone (what the game pays between stages)
+    Level level;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < stageTotal; i++)
+    {
+        LevelStage stage;
+        if (pack.stage(i, stage))
+        {
+            level.load(stage, cfg);
+        }
+    }
+    double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Scroll the generated level and its stage side by side to the end
+    int mismatches = 0;
+    float dt = cfg.fixedTimestep;
+    for (int i = 0; i < stageTotal; i++)
+    {
+        cfg.seed = seed + (uint64_t)i;
+        Level generated;
+        generated.generate(cfg);
+        LevelStage stage;
+        if (!pack.stage(i, stage))
+        {
+            mismatches++;
+            continue;
+        }
+        level.load(stage, cfg);
+        bool same = true;
+        while (same && (generated.count > 0 || level.count > 0))
+        {
+            same = generated.count == level.count;
+            for (int k = 0; same && k < level.count; k++)
+            {
+                Platform a = generated.platform(k);
+                Platform b = level.platform(k);
+                same = a.x == b.x && a.yTop == b.yTop && a.width == b.width;
+            }
+            generated.scroll(dt, cfg);
+            level.scroll(dt, cfg);
+        }
+        mismatches += same ? 0 : 1;
+    }
+
+    std::FILE *file = std::fopen(path, "rb");
+    long bytes = 0;
+    if (file)
+    {
+        std::fseek(file, 0, SEEK_END);
+        bytes = std::ftell(file);
+        std::fclose(file);
+    }
+    std::printf("pack:        %s (%d stages, %ld bytes)\n", path, stageTotal, bytes);
+    std::printf("open:        %.1f us\n", openSeconds * 1e6);
+    std::printf("load stage:  %.0f ns each\n", stageTotal > 0 ? loadSeconds * 1e9 / stageTotal : 0.0);
+    std::printf("verified:    %d / %d stages\n", stageTotal - mismatches, stageTotal);
+    return (mismatches == 0) ? 0 : 1;
+}
+
+/**
+ * runBot: Let the SearchBot play runs of consecutive seeds
+ * - Each run is stepped exactly like the game does (input, then step)
+ * - Decision times are wall-clock per input() call; the tail percentiles
+ *   are what has to stay under the frame budget (max also catches the
+ *   process being descheduled)
+ * - Fails when p99.9 exceeds SearchBot::kBudgetNs: the bot fits its work
+ *   into the budget, so calls over it are ones the process was preempted
+ *   in (rarer than one in a thousand, but they can reach p99.99)
+ */
+static int runBot(int argc, char **argv)
+{
+    long long runs = (argc > 2) ? std::max(1LL, std::atoll(argv[2])) : 20;
+    uint64_t seed = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 1;
+    long long maxSteps = (argc > 4) ? std::max(1LL, std::atoll(argv[4])) : 72000;
+
+    GameConfig cfg;
+    Simulation sim(cfg);
+    SearchBot bot;
+    RunTotals totals;
+    long long stopped = 0;
+    long long steps = 0;
+    float dt = cfg.fixedTimestep;
+
+    auto start = std::chrono::steady_clock::now();
+    for (long long r = 0; r < runs; r++)
+    {
+        sim.config.seed = seed + (uint64_t)r;
+        sim.reset();
+        bot.reset();
+        while (!sim.isFinished() && sim.frame < maxSteps)
+        {
+            sim.step(bot.input(sim), dt);
+        }
+        steps += sim.frame;
+        if (sim.isFinished())
+        {
+            totals.add(sim.score, sim.levelComplete);
+        }
+        else
+        {
+            stopped++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool within = bot.decidePercentileNs(0.999) <= SearchBot::kBudgetNs;
+    std::printf("runs:        %lld (%lld complete, %lld stopped)\n", runs, totals.wins, stopped);
+    std::printf("best score:  %d / %d\n", totals.bestScore, cfg.totalPlatforms);
+    std::printf("avg score:   %.2f\n", totals.runs > 0 ? (double)totals.totalScore / totals.runs : 0.0);
+    std::printf("searches:    %lld (%.1f steps each, %lld exact replays, %lld verify misses)\n", bot.searches,
+                bot.searches > 0 ? (double)steps / bot.searches : 0.0, bot.replays, bot.verifyFailures);
+    std::printf("decide:      avg %.2f us, p99 %.0f us, p99.9 %.0f us, p99.99 %.0f us, max %.0f us per step\n",
+                bot.decisions > 0 ? bot.totalDecideNs / 1e3 / bot.decisions : 0.0,
+                bot.decidePercentileNs(0.99) / 1e3, bot.decidePercentileNs(0.999) / 1e3,
+                bot.decidePercentileNs(0.9999) / 1e3, bot.maxDecideNs / 1e3);
+    std::printf("budget:      %lld steps over %.0f us, p99.9 %s; %lld searches spread over several steps\n",
+                bot.overBudget, SearchBot::kBudgetNs / 1e3, within ? "within" : "OVER", bot.spreadSearches);
+    std::printf("elapsed:     %.3f s (%lld steps)\n", seconds, steps);
+    return within ? 0 : 1;
+}
+
+/**
+ * runRestart: Game::reset's flow on consecutive seeds
+ * - While run r is played, run r + 1 is ordered from the pregenerator
+ *   when it is worth building (LevelPregenerator::prebuilt: curve levels);
+ *   the restart takes it (timed) while a second Simulation resets
+ *   synchronously (timed) for comparison. Flat levels are reset in place,
+ *   as Game does, and only the reset is timed
+ * - Level storage is reserved up front for both and the pregenerator, as
+ *   Game does, so neither timing includes a heap allocation
+ * - Curve levels: the difficulty table is swept once up front (timed);
+ *   the synchronous reset then generates each level on this thread
+ * - Every run is recorded like the game records it, and the recording
+ *   must verify through playReplay (curve levels rebuilt from the header)
+ * - The bot plays the swapped-in run; the reference gets the same inputs
+ *   and must end with the same score, outcome and step count
+ */
+static int runRestart(int argc, char **argv)
+{
+    long long runs = (argc > 2) ? std::max(1LL, std::atoll(argv[2])) : 20;
+    uint64_t seed = (argc > 3) ? std::strtoull(argv[3], nullptr, 10) : 1;
+    const long long maxSteps = 72000;
+
+    GameConfig cfg;
+    cfg.curveLevels = (argc > 4) && std::atoi(argv[4]) != 0;
+    LevelPregenerator pregenerator;
+    ThreadPool pool;
+    CurveGenerator curves(pool);
+    double modelSeconds = 0.0;
+    int curvePlatforms = 0;
+    if (cfg.curveLevels)
+    {
+        auto start = std::chrono::steady_clock::now();
+        curves.prepare(cfg);
+        modelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        pregenerator.useCurves(&curves);
+        curvePlatforms = cfg.totalPlatforms;
+    }
+    Simulation sim(cfg);
+    Simulation reference(cfg);
+    SearchBot bot;
+    float dt = cfg.fixedTimestep;
+    size_t levelBytes = Level::storageBytes(cfg);
+    sim.level.reserveStorage(levelBytes, curvePlatforms);
+    reference.level.reserveStorage(levelBytes, curvePlatforms);
+    pregenerator.reserve(levelBytes, curvePlatforms);
+    bool prebuilt = LevelPregenerator::prebuilt(cfg);
+    long long mismatches = 0, unverified = 0;
+    double takeNs = 0.0, takeMaxNs = 0.0, resetNs = 0.0, resetMaxNs = 0.0;
+    const char *replayPath = "headless_restart.replay";
+    ReplayWriter writer;
+    ReplayReader reader;
+    Simulation replayed;
+
+    for (long long r = 0; r < runs; r++)
+    {
+        GameConfig run = cfg;
+        run.seed = seed + (uint64_t)r;
+
+        auto t0 = std::chrono::steady_clock::now();
+        if (!prebuilt || !pregenerator.take(run, LevelStage(), sim))
+        {
+            pregenerator.resetNow(run, LevelStage(), sim);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        pregenerator.resetNow(run, LevelStage(), reference);
+        auto t2 = std::chrono::steady_clock::now();
+        double took = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        double reset = std::chrono::duration<double, std::nano>(t2 - t1).count();
+        if (r > 0)  // The first run can't have been ordered
+        {
+            takeNs += took;
+            takeMaxNs = std::max(takeMaxNs, took);
+            resetNs += reset;
+            resetMaxNs = std::max(resetMaxNs, reset);
+        }
+
+        if (prebuilt)
+        {
+            GameConfig next = run;
+            next.seed = run.seed + 1;
+            pregenerator.order(next);
+        }
+
+        bot.reset();
+        writer.begin(replayPath, sim.config);
+        while (!sim.isFinished() && sim.frame < maxSteps)
+        {
+            FrameInput input = bot.input(sim);
+            writer.record(sim.frame, input);
+            sim.step(input, dt);
+            reference.step(input, dt);
+        }
+        bool same = sim.score == reference.score && sim.frame == reference.frame &&
+                    sim.gameOver == reference.gameOver && sim.levelComplete == reference.levelComplete &&
+                    toFloat(sim.player.y) == toFloat(reference.player.y);
+        mismatches += same ? 0 : 1;
+
+        ReplayResult result;
+        result.frames = sim.frame;
+        result.score = sim.score;
+        result.gameOver = sim.gameOver;
+        result.levelComplete = sim.levelComplete;
+        result.finished = sim.isFinished();
+        bool verified = writer.finish(result) && reader.open(replayPath) && playReplay(reader, replayed, &curves);
+        unverified += verified ? 0 : 1;
+    }
+    std::remove(replayPath);
+
+    long long timed = std::max(1LL, runs - 1);
+    if (prebuilt)
+    {
+        std::printf("runs:        %lld curve levels (%lld swapped in, %lld built on demand)\n", runs,
+                    pregenerator.hits, pregenerator.misses);
+    }
+    else
+    {
+        std::printf("runs:        %lld flat levels (reset in place)\n", runs);
+    }
+    if (cfg.curveLevels)
+    {
+        std::printf("model:       swept in %.1f ms (once per session)\n", modelSeconds * 1e3);
+    }
+    if (prebuilt)
+    {
+        std::printf("restart:     take avg %.2f us, max %.2f us (synchronous reset avg %.2f us, max %.2f us)\n",
+                    takeNs / timed / 1e3, takeMaxNs / 1e3, resetNs / timed / 1e3, resetMaxNs / 1e3);
+    }
+    else
+    {
+        std::printf("restart:     synchronous reset avg %.2f us, max %.2f us (not pregenerated)\n",
+                    takeNs / timed / 1e3, takeMaxNs / 1e3);
+    }
+    std::printf("identical:   %s (%lld mismatching runs)\n", mismatches == 0 ? "yes" : "NO", mismatches);
+    std::printf("replays:     %lld / %lld recorded runs verified\n", runs - unverified, runs);
+    return (mismatches == 0 && unverified == 0 && pregenerator.hits == (prebuilt ? runs - 1 : 0)) ? 0 : 1;
+}
+
+/**
+ * RunOutcome: How a run ended, for comparing the same inputs at two steps
+ */
+struct RunOutcome
+{
+    int score = 0;
+    bool complete = false;
+    DeathCause cause = DeathCause::None;
+    double seconds = 0.0;   // Simulated time when it ended
+
+    /**
+     * sameAs: Same score and ending, within one step of tolerance in time
+     */
+    bool sameAs(const RunOutcome &o, double tolerance) const
+    {
+        return score == o.score && complete == o.complete && cause == o.cause &&
+               std::fabs(seconds - o.seconds) <= tolerance;
+    }
+};
+
+/**
+ * playInputs: Play one decision per period of cfg's step, each decision
+ * held for `substeps` steps (pressed on the first only)
+ * Returns the outcome; steps gets the steps taken
+ */
+static RunOutcome playInputs(const GameConfig &cfg, const std::vector<FrameInput> &decisions, int substeps, long long &steps)
+{
+    Simulation sim(cfg);
+    sim.reset();
+    float dt = cfg.fixedTimestep;
+    for (size_t d = 0; d < decisions.size() && !sim.isFinished(); d++)
+    {
+        FrameInput in = decisions[d];
+        for (int k = 0; k < substeps && !sim.isFinished(); k++)
+        {
+            sim.step(in, dt);
+            in.jumpPressed = false;
+        }
+    }
+    steps += sim.frame;
+
+    RunOutcome out;
+    out.score = sim.score;
+    out.complete = sim.levelComplete;
+    out.cause = sim.deathCause;
+    out.seconds = sim.frame * (double)dt;
+    return out;
+}
+
+/**
+ * runCoarse: Same inputs at the default step and at a coarse one
+ * - The bot plays each seed at the default step with continuous
+ *   collision, deciding once per coarse step (its input is held for the
+ *   substeps in between), so both rates can be fed identical inputs
+ * - The recorded decisions are then replayed (timed, no bot) at the
+ *   default step and at the coarse step with continuous collision, and at
+ *   the coarse step with the discrete per-step tests
+ * - A run agrees if it ends with the same score and outcome within one
+ *   coarse step of the reference
+ */
+static int runCoarse(int argc, char **argv)
+{
+    long long runs = (argc > 2) ? std::max(1LL, std::atoll(argv[2])) : 20;
+    int hz = (argc > 3) ? std::max(1, std::atoi(argv[3])) : 30;
+    uint64_t seed = (argc > 4) ? std::strtoull(argv[4], nullptr, 10) : 1;
+    const long long maxDecisions = 600LL * hz;  // Ten minutes
+
+    GameConfig fine;
+    fine.continuousCollision = true;
+    int substeps = std::max(1, (int)std::lround(1.0 / (fine.fixedTimestep * hz)));
+    GameConfig coarse = fine;
+    coarse.fixedTimestep = fine.fixedTimestep * substeps;
+    GameConfig discrete = coarse;
+    discrete.continuousCollision = false;
+
+    Simulation sim(fine);
+    SearchBot bot;
+    std::vector<FrameInput> decisions;
+    long long agreeContinuous = 0, agreeDiscrete = 0;
+    long long fineSteps = 0, coarseSteps = 0, discreteSteps = 0;
+    double fineSeconds = 0.0, coarseSeconds = 0.0, discreteSeconds = 0.0;
+    double fineSimulated = 0.0, coarseSimulated = 0.0, discreteSimulated = 0.0;
+
+    for (long long r = 0; r < runs; r++)
+    {
+        // Record the bot's decisions, one per coarse step
+        sim.config.seed = seed + (uint64_t)r;
+        sim.reset();
+        bot.reset();
+        decisions.clear();
+        while (!sim.isFinished() && (long long)decisions.size() < maxDecisions)
+        {
+            FrameInput in = bot.input(sim);
+            decisions.push_back(in);
+            for (int k = 0; k < substeps && !sim.isFinished(); k++)
+            {
+                sim.step(in, fine.fixedTimestep);
+                in.jumpPressed = false;
+            }
+        }
+
+        GameConfig fineRun = fine, coarseRun = coarse, discreteRun = discrete;
+        fineRun.seed = coarseRun.seed = discreteRun.seed = sim.config.seed;
+
+        auto t0 = std::chrono::steady_clock::now();
+        RunOutcome reference = playInputs(fineRun, decisions, substeps, fineSteps);
+        auto t1 = std::chrono::steady_clock::now();
+        RunOutcome continuous = playInputs(coarseRun, decisions, 1, coarseSteps);
+        auto t2 = std::chrono::steady_clock::now();
+        RunOutcome stepped = playInputs(discreteRun, decisions, 1, discreteSteps);
+        auto t3 = std::chrono::steady_clock::now();
+        fineSeconds += std::chrono::duration<double>(t1 - t0).count();
+        coarseSeconds += std::chrono::duration<double>(t2 - t1).count();
+        discreteSeconds += std::chrono::duration<double>(t3 - t2).count();
+        fineSimulated += reference.seconds;
+        coarseSimulated += continuous.seconds;
+        discreteSimulated += stepped.seconds;
+
+        double tolerance = coarse.fixedTimestep * 1.001;
+        agreeContinuous += continuous.sameAs(reference, tolerance) ? 1 : 0;
+        agreeDiscrete += stepped.sameAs(reference, tolerance) ? 1 : 0;
+    }
+
+    std::printf("runs:        %lld bot runs, %.0f s simulated (decisions at %d Hz)\n", runs, fineSimulated, hz);
+    std::printf("steps:       %.0f Hz reference, %.0f Hz coarse (%d substeps)\n",
+                1.0 / fine.fixedTimestep, 1.0 / coarse.fixedTimestep, substeps);
+    std::printf("agreement:   continuous %lld / %lld runs, discrete %lld / %lld runs\n",
+                agreeContinuous, runs, agreeDiscrete, runs);
+    std::printf("throughput:  reference %.0f, continuous %.0f, discrete %.0f simulated s per wall s\n",
+                fineSeconds > 0.0 ? fineSimulated / fineSeconds : 0.0,
+                coarseSeconds > 0.0 ? coarseSimulated / coarseSeconds : 0.0,
+                discreteSeconds > 0.0 ? discreteSimulated / discreteSeconds : 0.0);
+    std::printf("steps taken: %lld reference, %lld continuous, %lld discrete\n", fineSteps, coarseSteps, discreteSteps);
+    return agreeContinuous == runs ? 0 : 1;
+}
+
+/**
+ * runRace: Ghosts racing the bot on one shared level
+ * - The bot plays each seed as the host; ghost g is a bot too, playing a
+ *   Simulation of its own, but it idles for its first 6 * (g + 1) steps
+ *   (so the racers take different lines and end at different points)
+ * - The same inputs drive the ghosts in one GhostRace on the host's level;
+ *   after every host step each ghost's Y, velocity, score and outcome must
+ *   match its own Simulation
+ * - Times the race's step against stepping the separate Simulations, per
+ *   ghost that was still running
+ */
+static int runRace(int argc, char **argv)
+{
+    long long runs = (argc > 2) ? std::max(1LL, std::atoll(argv[2])) : 10;
+    int ghosts = (argc > 3) ? std::max(1, std::min(std::atoi(argv[3]), GhostRace::kMaxGhosts)) : GhostRace::kMaxGhosts;
+    uint64_t seed = (argc > 4) ? std::strtoull(argv[4], nullptr, 10) : 1;
+    const long long maxSteps = 72000;
+
+    GameConfig cfg;
+    float dt = cfg.fixedTimestep;
+    Simulation host(cfg);
+    SearchBot bot;
+    GhostRace race;
+    std::vector<Simulation> own(ghosts);      // Default config, as cfg
+    std::vector<SearchBot> ghostBots(ghosts);
+    long long mismatches = 0, ghostSteps = 0, ghostsSurvived = 0, scoreSum = 0;
+    double raceSeconds = 0.0, ownSeconds = 0.0;
+
+    for (long long r = 0; r < runs; r++)
+    {
+        host.config.seed = seed + (uint64_t)r;
+        host.reset();
+        bot.reset();
+        race.reset(host, ghosts);
+        for (int g = 0; g < ghosts; g++)
+        {
+            own[g].config.seed = host.config.seed;
+            own[g].reset();
+            ghostBots[g].reset();
+        }
+
+        FrameInput inputs[GhostRace::kMaxGhosts];
+        while (!host.isFinished() && host.frame < maxSteps)
+        {
+            for (int g = 0; g < ghosts; g++)
+            {
+                bool idle = own[g].frame < 6 * (g + 1) || own[g].isFinished();
+                inputs[g] = idle ? FrameInput() : ghostBots[g].input(own[g]);
+            }
+            host.step(bot.input(host), dt);
+
+            int running = race.running();
+            auto t0 = std::chrono::steady_clock::now();
+            race.step(inputs, dt, host);
+            auto t1 = std::chrono::steady_clock::now();
+            for (int g = 0; g < ghosts; g++)
+            {
+                own[g].step(inputs[g], dt);
+            }
+            auto t2 = std::chrono::steady_clock::now();
+            raceSeconds += std::chrono::duration<double>(t1 - t0).count();
+            ownSeconds += std::chrono::duration<double>(t2 - t1).count();
+            ghostSteps += running;
+
+            for (int g = 0; g < ghosts; g++)
+            {
+                const Simulation &sim = own[g];
+                bool same = toFloat(race.players[g].y) == toFloat(sim.player.y) &&
+                            toFloat(race.players[g].vy) == toFloat(sim.player.vy) &&
+                            race.score[g] == sim.score && race.gameOver[g] == sim.gameOver &&
+                            race.deathCause[g] == sim.deathCause && race.levelComplete[g] == sim.levelComplete;
+                mismatches += same ? 0 : 1;
+            }
+        }
+        ghostsSurvived += race.running();
+        for (int g = 0; g < ghosts; g++)
+        {
+            scoreSum += race.score[g];
+        }
+    }
+
+    std::printf("runs:        %lld bot runs, %d ghosts each\n", runs, ghosts);
+    std::printf("ghosts:      avg score %.1f, %lld still running when the host's run ended\n",
+                (double)scoreSum / (double)(runs * ghosts), ghostsSurvived);
+    std::printf("ghost steps: %lld, race %.1f ns per ghost step (own Simulations %.1f ns)\n", ghostSteps,
+                ghostSteps > 0 ? raceSeconds * 1e9 / ghostSteps : 0.0, ghostSteps > 0 ? ownSeconds * 1e9 / ghostSteps : 0.0);
+    std::printf("identical:   %s (%lld mismatching ghost steps)\n", mismatches == 0 ? "yes" : "NO", mismatches);
+    return mismatches == 0 ? 0 : 1;
+}
+
+/**
+ * runCurve: Difficulty-curve levels on consecutive seeds
+ * - Sweeps the difficulty model once (timed), then generates each level
+ *   (timed: the cost the pre-generation thread would pay per level) and
+ *   measures its jumps (timed separately - a checking tool's cost)
+ * - Target, table-predicted and measured difficulty averaged per tenth
+ *   of the level
+ * - The flat generator's levels for the same seeds are checked against
+ *   the jump envelope for comparison
+ * - The bot plays every generated level as a stage
+ */
+static int runCurve(int argc, char **argv)
+{
+    int levels = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 20;
+    int threads = (argc > 3) ? std::atoi(argv[3]) : 4;
+    float from = (argc > 4) ? (float)std::atof(argv[4]) : 0.5f;
+    float to = (argc > 5) ? (float)std::atof(argv[5]) : 0.7f;
+    uint64_t seed = (argc > 6) ? std::strtoull(argv[6], nullptr, 10) : 1;
+    const long long maxSteps = 72000;
+    const int kTenths = 10;
+
+    GameConfig cfg;
+    ThreadPool pool(threads);
+    CurveGenerator generator(pool);
+    DifficultyCurve curve = DifficultyCurve::ramp(from, to);
+
+    auto start = std::chrono::steady_clock::now();
+    generator.prepare(cfg);
+    double modelSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const JumpEnvelope &envelope = generator.jumpEnvelope();
+
+    long long flatJumps = 0, flatUnreachable = 0;
+    long long jumps = 0, unreachable = 0, rejected = 0, fallbacks = 0;
+    double totalSeconds = 0.0, worstSeconds = 0.0, measureSeconds = 0.0, errorSum = 0.0;
+    double targetSum[kTenths] = {}, predictedSum[kTenths] = {}, measuredSum[kTenths] = {};
+    long long tenthCount[kTenths] = {};
+    RunTotals totals;
+    long long stopped = 0;
+    CurvedLevel level;
+    Simulation sim(cfg);
+    SearchBot bot;
+    float dt = cfg.fixedTimestep;
+
+    for (int l = 0; l < levels; l++)
+    {
+        cfg.seed = seed + (uint64_t)l;
+        std::vector<Platform> flat = LevelPack::generateStage(cfg);
+        for (size_t i = 1; i < flat.size(); i++)
+        {
+            Transition t = CurveGenerator::transition(flat, i);
+            flatUnreachable += envelope.reachable(t.prevWidth, t.gap, t.rise, t.width) ? 0 : 1;
+            flatJumps++;
+        }
+
+        start = std::chrono::steady_clock::now();
+        generator.generate(cfg, curve, level);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        totalSeconds += seconds;
+        worstSeconds = std::max(worstSeconds, seconds);
+        rejected += level.rejected;
+        fallbacks += level.fallbacks;
+
+        start = std::chrono::steady_clock::now();
+        generator.measure(cfg, level);
+        measureSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        size_t n = level.platforms.size();
+        for (size_t i = 1; i < n; i++)
+        {
+            Transition t = CurveGenerator::transition(level.platforms, i);
+            unreachable += envelope.reachable(t.prevWidth, t.gap, t.rise, t.width) ? 0 : 1;
+            jumps++;
+            int tenth = std::min(kTenths - 1, (int)(i * kTenths / n));
+            targetSum[tenth] += level.target[i];
+            predictedSum[tenth] += level.predicted[i];
+            measuredSum[tenth] += level.measured[i];
+            tenthCount[tenth]++;
+            errorSum += std::fabs(level.measured[i] - level.target[i]);
+        }
+
+        sim.config = cfg;
+        sim.reset(sim.level.packStage(level.platforms.data(), (int)level.platforms.size()));
+        bot.reset();
+        while (!sim.isFinished() && sim.frame < maxSteps)
+        {
+            sim.step(bot.input(sim), dt);
+        }
+        if (sim.isFinished())
+        {
+            totals.add(sim.score, sim.levelComplete);
+        }
+        else
+        {
+            stopped++;
+        }
+    }
+
+    std::printf("curve:       %.2f -> %.2f over %d platforms, %d levels, %d threads\n",
+                from, to, cfg.totalPlatforms, levels, pool.threadCount());
+    std::printf("model:       %d transitions x %d plans swept in %.1f ms (once per tuning)\n",
+                DifficultyModel::kCells, DifficultyModel::kTrials, modelSeconds * 1e3);
+    std::printf("generate:    avg %.3f ms, max %.3f ms per level\n", totalSeconds * 1e3 / levels, worstSeconds * 1e3);
+    std::printf("measure:     avg %.2f ms per level (%d plans per jump)\n", measureSeconds * 1e3 / levels,
+                DifficultyModel::kTrials);
+    std::printf("envelope:    %lld candidates rejected, %lld fallbacks, %lld / %lld jumps unreachable\n",
+                rejected, fallbacks, unreachable, jumps);
+    std::printf("flat levels: %lld / %lld jumps unreachable\n", flatUnreachable, flatJumps);
+    std::printf("target:     ");
+    for (int t = 0; t < kTenths; t++)
+    {
+        std::printf(" %.2f", tenthCount[t] > 0 ? targetSum[t] / tenthCount[t] : 0.0);
+    }
+    std::printf("\npredicted:  ");
+    for (int t = 0; t < kTenths; t++)
+    {
+        std::printf(" %.2f", tenthCount[t] > 0 ? predictedSum[t] / tenthCount[t] : 0.0);
+    }
+    std::printf("\nmeasured:   ");
+    for (int t = 0; t < kTenths; t++)
+    {
+        std::printf(" %.2f", tenthCount[t] > 0 ? measuredSum[t] / tenthCount[t] : 0.0);
+    }
+    std::printf("\nmean error:  %.3f per jump\n", jumps > 0 ? errorSum / jumps : 0.0);
+    std::printf("bot:         %lld / %d levels complete, avg score %.1f, %lld stopped\n", totals.wins, levels,
+                totals.runs > 0 ? (double)totals.totalScore / totals.runs : 0.0, stopped);
+    return (unreachable == 0 && fallbacks == 0) ? 0 : 1;
+}
+
+/**
+ * printUsage: The command lines of every mode (see the header comment)
+ */
+static void printUsage()
+{
+    std::printf("usage: headless [steps] [jumpPeriod] [jumpHold] [seed] [games] [jumpDelay]\n"
+                "       headless replay <file> [more files...]\n"
+                "       headless eval [runs] [threads] [jumpPeriod] [jumpHold] [seed] [jumpDelay]\n"
+                "       headless pack <file> [stages] [seed]\n"
+                "       headless bot [runs] [seed] [maxSteps]\n"
+                "       headless restart [runs] [seed] [curve]\n"
+                "       headless coarse [runs] [hz] [seed]\n"
+                "       headless race [runs] [ghosts] [seed]\n"
+                "       headless curve [levels] [threads] [from] [to] [seed]\n");
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "replay") == 0)
+    {
+        if (argc < 3)
+        {
+            std::printf("usage: headless replay <file> [more files...]\n");
+            return 2;
+        }
+        if (argc == 3)
+        {
+            return runReplay(argv[2]);
+        }
+        return runReplays(std::vector<std::string>(argv + 2, argv + argc));
+    }
+    if (argc > 1 && std::strcmp(argv[1], "eval") == 0)
+    {
+        return runEval(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "pack") == 0)
+    {
+        if (argc < 3)
+        {
+            std::printf("usage: headless pack <file> [stages] [seed]\n");
+            return 2;
+        }
+        return runPack(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "bot") == 0)
+    {
+        return runBot(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "restart") == 0)
+    {
+        return runRestart(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "coarse") == 0)
+    {
+        return runCoarse(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "race") == 0)
+    {
+        return runRace(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "curve") == 0)
+    {
+        return runCurve(argc, argv);
+    }
+
+    // Anything else must be a step count (not a misspelled mode or --help)
+    long long steps = 1000000;
+    if (argc > 1)
+    {
+        char *end = nullptr;
+        steps = std::strtoll(argv[1], &end, 10);
+        if (end == argv[1] || *end != '\0' || steps < 0)
+        {
+            printUsage();
+            return 2;
+        }
+    }
+    ScriptedPolicy policy;
+    policy.jumpPeriod = (argc > 2) ? std::max(1, std::atoi(argv[2])) : policy.jumpPeriod;
+    policy.jumpHold = (argc > 3) ? std::atoi(argv[3]) : policy.jumpHold;
+    uint64_t seed = (argc > 4) ? std::strtoull(argv[4], nullptr, 10) : 1;
+    int games = (argc > 5) ? std::atoi(argv[5]) : 1;
+    if (games < 1) games = 1;
+    policy.jumpDelay = (argc > 6) ? std::max(0, std::atoi(argv[6])) : policy.jumpDelay;
+
+    GameConfig cfg;
+    RunTotals totals;
+
+    auto start = std::chrono::steady_clock::now();
+    if (games == 1)
+    {
+        runSingle(totals, cfg, steps, policy, seed);
+    }
+    else
+    {
+        runBatch(totals, cfg, steps, policy, seed, games);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::printf("steps:       %lld (dt %.5f s, %d game%s in lockstep)\n", steps, cfg.fixedTimestep, games, games == 1 ? "" : "s");
+    std::printf("runs:        %lld (%lld complete)\n", totals.runs, totals.wins);
+    std::printf("best score:  %d / %d\n", totals.bestScore, cfg.totalPlatforms);
+    std::printf("avg score:   %.2f\n", totals.runs > 0 ? (double)totals.totalScore / totals.runs : 0.0);
+    std::printf("elapsed:     %.3f s\n", seconds);
+    std::printf("steps/sec:   %.0f\n", seconds > 0.0 ? steps / seconds : 0.0);
+    return 0;
+}
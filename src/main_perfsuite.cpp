@@ -0,0 +1,387 @@
+/**
+ * Performance suite: End-to-end regression check across builds
+ *
+ * Where bench times single operations, perfsuite plays a fixed corpus of
+ * recorded runs (perf/corpus, run_000.replay, run_001.replay, ...) the
+ * way the game plays them, and diffs the numbers against a stored
+ * baseline of the same build variant:
+ *   - Sim pass: every replay is reset (level generation) and stepped with
+ *     its recorded input on one reused Simulation, `passes` times; the
+ *     fastest pass is reported
+ *     - sim/frames_per_sec:   corpus steps / pass time (resets included)
+ *     - sim/ns_per_step:      time in Simulation::step only
+ *     - sim/allocs_per_frame: heap allocations while stepping (builds
+ *                             with ALLOC_CHECK=1 only - 0 expected)
+ *   - Render pass (built with RENDER=1, links raylib and the Game):
+ *     Game::benchmark plays the corpus through update / draw in a hidden
+ *     window, one fixed step per frame
+ *     - render/frame_ms_p50, _p95, _p99: frame time percentiles
+ *     - render/frames_per_sec: frames / summed frame time
+ * Every replay must reproduce its recorded outcome in both passes - a
+ * build that plays differently is a bug, not a data point.
+ *
+ * Makefile.simple builds one perfsuite per variant (debug, release, lto,
+ * pgo) and runs them all (`make perfsuite`); `table` lines their results
+ * up so it shows which optimization pays off where.
+ *
+ * USAGE:
+ *   perfsuite [run] [corpus] [results] [baseline] [tolerance] [passes]
+ *   perfsuite record [corpus] [runs] [seed]
+ *   perfsuite table <results> [more results...]
+ *   - corpus:    directory holding run_NNN.replay (default perf/corpus)
+ *   - results:   JSON written (default perfsuite.json, "-" = don't write)
+ *   - baseline:  stored results to diff against ("-" = no comparison,
+ *                the default); a baseline that is missing or was taken on
+ *                another corpus fails the run instead of passing unchecked
+ *   - tolerance: how much worse a metric may get (default 0.10 = 10%)
+ *   - passes:    sim passes over the corpus (default 5)
+ *   - run:       exit status 0 without regressions, 1 with, 2 if the
+ *                corpus is unreadable or a replay didn't reproduce, 3 if
+ *                the baseline is missing or doesn't match the corpus
+ *   - record:    replaces the corpus: the reference bot plays runs 0 ..
+ *                3/4 of runs, scripted jumping (early game overs) the
+ *                rest, on seeds seed, seed + 1, ... (default 8 runs from 1)
+ */
+
+#include "sim/Simulation.h"
+#include "sim/Replay.h"
+#include "sim/RunEvaluator.h"
+#include "control/SearchBot.h"
+#include "memory/AllocationCounter.h"
+#include "profile/PerfReport.h"
+#include "profile/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef PERFSUITE_RENDER
+#define PERFSUITE_RENDER 0
+#endif
+#if PERFSUITE_RENDER
+#include "game/Game.h"
+#endif
+
+// Variant name from the Makefile (-DPERFSUITE_VARIANT=lto); plain builds say what they are
+#define PERFSUITE_STRING_INNER(x) #x
+#define PERFSUITE_STRING(x) PERFSUITE_STRING_INNER(x)
+#ifdef PERFSUITE_VARIANT
+static const char *kVariant = PERFSUITE_STRING(PERFSUITE_VARIANT);
+#elif defined(__OPTIMIZE__)
+static const char *kVariant = "release";
+#else
+static const char *kVariant = "debug";
+#endif
+
+/**
+ * corpusPath: Path of replay i in a corpus directory
+ */
+static std::string corpusPath(const char *dir, int i)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "/run_%03d.replay", i);
+    return std::string(dir) + name;
+}
+
+/**
+ * loadCorpus: Read run_000, run_001, ... until one is missing
+ * Returns false if there is none, or one is unreadable or was recorded
+ * with another config (other physics type, changed settings)
+ */
+static bool loadCorpus(const char *dir, std::vector<std::string> &paths, std::vector<ReplayReader> &corpus)
+{
+    for (int i = 0;; i++)
+    {
+        std::string path = corpusPath(dir, i);
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        if (!file)
+        {
+            break;
+        }
+        std::fclose(file);
+
+        ReplayReader reader;
+        if (!reader.open(path.c_str()) || !reader.complete || configHash(reader.config()) != reader.hash)
+        {
+            std::fprintf(stderr, "perfsuite: %s is unreadable or was recorded with another config (perfsuite record)\n", path.c_str());
+            return false;
+        }
+        paths.push_back(path);
+        corpus.push_back(reader);
+    }
+    if (corpus.empty())
+    {
+        std::fprintf(stderr, "perfsuite: no replays in %s (perfsuite record %s)\n", dir, dir);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * SimPass: Timing of one pass over the corpus
+ */
+struct SimPass
+{
+    double seconds = 0.0;       // Whole pass
+    double stepSeconds = 0.0;   // Simulation::step only
+    long long frames = 0;
+    uint64_t allocations = 0;   // While stepping
+    bool reproduced = true;
+};
+
+/**
+ * runSimPass: Reset and step every replay on one Simulation (as the game
+ * reuses its own), comparing each outcome with the recorded footer
+ */
+static SimPass runSimPass(std::vector<ReplayReader> &corpus, Simulation &sim)
+{
+    SimPass pass;
+    auto passStart = std::chrono::steady_clock::now();
+    for (ReplayReader &reader : corpus)
+    {
+        reader.rewind();
+        sim.config = reader.config();
+        sim.reset();
+        const float dt = sim.config.fixedTimestep;
+        const long long limit = reader.result.frames;
+
+        uint64_t allocationsBefore = allocationCount();
+        auto start = std::chrono::steady_clock::now();
+        while (!sim.isFinished() && sim.frame < limit)
+        {
+            sim.step(reader.next(), dt);
+        }
+        pass.stepSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        pass.allocations += allocationCount() - allocationsBefore;
+
+        pass.frames += sim.frame;
+        pass.reproduced = pass.reproduced && sim.frame == reader.result.frames && sim.score == reader.result.score &&
+                          sim.gameOver == reader.result.gameOver && sim.levelComplete == reader.result.levelComplete;
+    }
+    pass.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - passStart).count();
+    return pass;
+}
+
+#if PERFSUITE_RENDER
+/**
+ * percentile: Nearest-rank percentile of sorted values
+ */
+static float percentile(const std::vector<float> &sorted, double p)
+{
+    if (sorted.empty())
+    {
+        return 0.0f;
+    }
+    size_t rank = std::min(sorted.size() - 1, (size_t)(p * (double)sorted.size()));
+    return sorted[rank];
+}
+#endif
+
+/**
+ * runSuite: Sim pass (and render pass when built in), then the baseline diff
+ */
+static int runSuite(int argc, char **argv, int first)
+{
+    const char *dir = (argc > first) ? argv[first] : "perf/corpus";
+    const char *resultsPath = (argc > first + 1) ? argv[first + 1] : "perfsuite.json";
+    const char *baselinePath = (argc > first + 2) ? argv[first + 2] : "-";
+    double tolerance = (argc > first + 3) ? std::atof(argv[first + 3]) : 0.10;
+    int passes = (argc > first + 4) ? std::max(1, std::atoi(argv[first + 4])) : 5;
+
+    std::vector<std::string> paths;
+    std::vector<ReplayReader> corpus;
+    if (!loadCorpus(dir, paths, corpus))
+    {
+        return 2;
+    }
+
+    PerfReport report;
+    report.variant = kVariant;
+    report.runs = (long long)corpus.size();
+
+    // ----- Sim pass: fastest of `passes` -----
+    if (kProfilerEnabled)
+    {
+        profiler();  // Its frame history is allocated on first use (the game does this at startup)
+    }
+    Simulation sim;
+    SimPass best;
+    bool reproduced = true;
+    for (int p = 0; p < passes; p++)
+    {
+        SimPass pass = runSimPass(corpus, sim);
+        reproduced = reproduced && pass.reproduced;
+        if (p == 0 || pass.seconds < best.seconds)
+        {
+            best = pass;
+        }
+    }
+    report.frames = best.frames;
+    std::printf("variant:     %s\n", kVariant);
+    std::printf("corpus:      %zu replays, %lld steps (%s)\n", corpus.size(), best.frames, dir);
+    std::printf("sim:         %.0f frames/sec, %.1f ns/step (best of %d passes)\n",
+                best.frames / best.seconds, best.stepSeconds * 1e9 / best.frames, passes);
+    report.add("sim/frames_per_sec", best.frames / best.seconds, "frames/s", true);
+    report.add("sim/ns_per_step", best.stepSeconds * 1e9 / best.frames, "ns", false);
+    if (kAllocationTracking)
+    {
+        double perFrame = (double)best.allocations / (double)best.frames;
+        std::printf("allocations: %.4f per frame\n", perFrame);
+        report.add("sim/allocs_per_frame", perFrame, "allocs", false);
+    }
+
+#if PERFSUITE_RENDER
+    // ----- Render pass: the Game's own frame in a hidden window -----
+    {
+        Game game;
+        std::vector<float> frameMs;
+        reproduced = game.benchmark(paths, frameMs) && reproduced;
+        double totalMs = 0.0;
+        for (float ms : frameMs)
+        {
+            totalMs += ms;
+        }
+        std::sort(frameMs.begin(), frameMs.end());
+        std::printf("render:      %zu frames, p50 %.3f ms, p95 %.3f ms, p99 %.3f ms\n", frameMs.size(),
+                    percentile(frameMs, 0.50), percentile(frameMs, 0.95), percentile(frameMs, 0.99));
+        report.add("render/frame_ms_p50", percentile(frameMs, 0.50), "ms", false);
+        report.add("render/frame_ms_p95", percentile(frameMs, 0.95), "ms", false);
+        report.add("render/frame_ms_p99", percentile(frameMs, 0.99), "ms", false);
+        report.add("render/frames_per_sec", totalMs > 0.0 ? frameMs.size() * 1000.0 / totalMs : 0.0, "frames/s", true);
+    }
+#endif
+
+    std::printf("reproduced:  %s\n", reproduced ? "yes" : "NO");
+    if (std::strcmp(resultsPath, "-") != 0)
+    {
+        if (!report.write(resultsPath))
+        {
+            std::fprintf(stderr, "perfsuite: could not write %s\n", resultsPath);
+            return 2;
+        }
+        std::printf("results:     %s\n", resultsPath);
+    }
+    if (!reproduced)
+    {
+        return 2;
+    }
+
+    if (std::strcmp(baselinePath, "-") == 0)
+    {
+        return 0;  // Recording a baseline (or just measuring)
+    }
+    PerfReport baseline;
+    if (!baseline.read(baselinePath))
+    {
+        std::fprintf(stderr, "perfsuite: no baseline at %s (record one first, or pass - to skip the comparison)\n",
+                     baselinePath);
+        return 3;
+    }
+    if (baseline.frames != report.frames)
+    {
+        std::fprintf(stderr, "perfsuite: %s played a different corpus (%lld steps, this one %lld) - record it again\n",
+                     baselinePath, baseline.frames, report.frames);
+        return 3;
+    }
+    std::printf("baseline:    %s (%s), tolerance %.0f%%\n\n", baselinePath, baseline.variant.c_str(), tolerance * 100.0);
+    int regressions = comparePerf(baseline, report, tolerance);
+    std::printf("\nregressions: %d\n", regressions);
+    return (regressions == 0) ? 0 : 1;
+}
+
+/**
+ * runRecord: Write a fresh corpus
+ * - The bot's runs are long, complete levels (the common case)
+ * - Scripted runs jump on a fixed period and die early (game over path)
+ */
+static int runRecord(int argc, char **argv)
+{
+    const char *dir = (argc > 2) ? argv[2] : "perf/corpus";
+    int runs = (argc > 3) ? std::max(1, std::atoi(argv[3])) : 8;
+    uint64_t seed = (argc > 4) ? std::strtoull(argv[4], nullptr, 10) : 1;
+    const long long maxSteps = 72000;  // 10 minutes
+
+    GameConfig cfg;
+    Simulation sim(cfg);
+    SearchBot bot;
+    ScriptedPolicy policy;
+    ReplayWriter writer;
+    int botRuns = std::max(1, runs * 3 / 4);
+    for (int r = 0; r < runs; r++)
+    {
+        std::string path = corpusPath(dir, r);
+        sim.config.seed = seed + (uint64_t)r;
+        sim.reset();
+        bot.reset();
+        if (!writer.begin(path.c_str(), sim.config))
+        {
+            std::fprintf(stderr, "perfsuite: cannot create %s\n", path.c_str());
+            return 2;
+        }
+        while (!sim.isFinished() && sim.frame < maxSteps)
+        {
+            FrameInput input = (r < botRuns) ? bot.input(sim) : policy.input(sim.frame);
+            writer.record(sim.frame, input);
+            sim.step(input, cfg.fixedTimestep);
+        }
+        ReplayResult result;
+        result.frames = sim.frame;
+        result.score = sim.score;
+        result.gameOver = sim.gameOver;
+        result.levelComplete = sim.levelComplete;
+        result.finished = sim.isFinished();
+        if (!writer.finish(result))
+        {
+            std::fprintf(stderr, "perfsuite: could not write %s\n", path.c_str());
+            return 2;
+        }
+        std::printf("%s: seed %llu, %s, score %d, %lld steps\n", path.c_str(), (unsigned long long)sim.config.seed,
+                    (r < botRuns) ? "bot" : "scripted", sim.score, sim.frame);
+    }
+
+    // Drop the rest of a longer earlier recording (it would still be played)
+    for (int r = runs; std::remove(corpusPath(dir, r).c_str()) == 0; r++)
+    {
+    }
+    return 0;
+}
+
+/**
+ * runTable: Stored results side by side
+ */
+static int runTable(int argc, char **argv)
+{
+    std::vector<PerfReport> reports;
+    for (int i = 2; i < argc; i++)
+    {
+        PerfReport report;
+        if (!report.read(argv[i]))
+        {
+            std::fprintf(stderr, "perfsuite: cannot read %s\n", argv[i]);
+            continue;
+        }
+        reports.push_back(report);
+    }
+    printPerfTable(reports);
+    return reports.empty() ? 2 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && std::strcmp(argv[1], "record") == 0)
+    {
+        return runRecord(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "table") == 0)
+    {
+        return runTable(argc, argv);
+    }
+    if (argc > 1 && std::strcmp(argv[1], "run") == 0)
+    {
+        return runSuite(argc, argv, 2);
+    }
+    return runSuite(argc, argv, 1);
+}
@@ -0,0 +1,84 @@
+#include "AllocationCounter.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if TRACK_ALLOCATIONS
+
+/**
+ * threadAllocations: Per-thread count, so worker threads (ThreadPool,
+ * RunEvaluator) never trip a scope on the game thread
+ */
+static thread_local uint64_t threadAllocations = 0;
+
+uint64_t allocationCount()
+{
+    return threadAllocations;
+}
+
+/**
+ * countedAllocate: malloc plus a count (the replaced operators below all
+ * route here; zero-size requests still get a unique pointer)
+ */
+static void *countedAllocate(size_t bytes)
+{
+    threadAllocations++;
+    void *p = std::malloc(bytes != 0 ? bytes : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void *operator new(size_t bytes)
+{
+    return countedAllocate(bytes);
+}
+
+void *operator new[](size_t bytes)
+{
+    return countedAllocate(bytes);
+}
+
+void *operator new(size_t bytes, const std::nothrow_t &) noexcept
+{
+    threadAllocations++;
+    return std::malloc(bytes != 0 ? bytes : 1);
+}
+
+void *operator new[](size_t bytes, const std::nothrow_t &) noexcept
+{
+    threadAllocations++;
+    return std::malloc(bytes != 0 ? bytes : 1);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+void operator delete[](void *p, size_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+
+#else
+
+uint64_t allocationCount()
+{
+    return 0;
+}
+
+#endif
+
+/**
+ * NoAllocationScope destructor: Report, then assert (debug builds keep asserts)
+ */
+NoAllocationScope::~NoAllocationScope()
+{
+    uint64_t made = allocationCount() - start;
+    if (made != 0)
+    {
+        std::fprintf(stderr, "%s: %llu heap allocation(s) in a no-allocation scope\n", name, (unsigned long long)made);
+    }
+    assert(made == 0 && "heap allocation inside NO_ALLOCATION_SCOPE");
+}
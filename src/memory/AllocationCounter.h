@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * TRACK_ALLOCATIONS: Compile-time switch for the heap allocation counter
+ * - 1: global operator new / delete are replaced by counting versions and
+ *   NO_ALLOCATION_SCOPE asserts that a block makes no heap allocation
+ *   (Makefile default for debug builds)
+ * - 0: the standard operators are used and NO_ALLOCATION_SCOPE expands to
+ *   nothing (default for release builds)
+ * Override with `make ALLOC_CHECK=0` to run a debug build without the check
+ *
+ * Only C++ allocations are counted (new, containers, std::string...);
+ * malloc from C libraries such as raylib or fopen is not.
+ */
+#ifndef TRACK_ALLOCATIONS
+#define TRACK_ALLOCATIONS 0
+#endif
+
+constexpr bool kAllocationTracking = TRACK_ALLOCATIONS != 0;
+
+/**
+ * allocationCount: Heap allocations made so far by the calling thread
+ * (always 0 when TRACK_ALLOCATIONS is 0)
+ */
+uint64_t allocationCount();
+
+/**
+ * NoAllocationScope: RAII check - asserts on destruction if the calling
+ * thread allocated since construction (names the scope and the count on
+ * stderr first). Use through NO_ALLOCATION_SCOPE.
+ */
+struct NoAllocationScope
+{
+    explicit NoAllocationScope(const char *name) : name(name), start(allocationCount()) {}
+    ~NoAllocationScope();
+
+    const char *name;
+    uint64_t start;
+};
+
+/**
+ * NO_ALLOCATION_SCOPE(name): Assert that the rest of the enclosing block
+ * makes no heap allocation (expands to nothing when TRACK_ALLOCATIONS is 0)
+ */
+#if TRACK_ALLOCATIONS
+#define ALLOCATION_CONCAT_INNER(a, b) a##b
+#define ALLOCATION_CONCAT(a, b) ALLOCATION_CONCAT_INNER(a, b)
+#define NO_ALLOCATION_SCOPE(name) NoAllocationScope ALLOCATION_CONCAT(noAllocationScope, __LINE__)(name)
+#else
+#define NO_ALLOCATION_SCOPE(name) ((void)0)
+#endif
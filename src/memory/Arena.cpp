@@ -0,0 +1,130 @@
+#include "Arena.h"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+/**
+ * Arena constructor: The block comes from the heap once, here
+ */
+Arena::Arena(size_t bytes)
+{
+    reserve(bytes);
+}
+
+Arena::~Arena()
+{
+    release();
+}
+
+/**
+ * Move: Take over the block and chunks (allocations don't move)
+ */
+Arena::Arena(Arena &&other) noexcept
+    : block(other.block), size(other.size), used(other.used), peak(other.peak),
+      chunks(other.chunks), overflows(other.overflows)
+{
+    other.block = nullptr;
+    other.size = 0;
+    other.used = 0;
+    other.chunks = nullptr;
+}
+
+Arena &Arena::operator=(Arena &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        block = other.block;
+        size = other.size;
+        used = other.used;
+        peak = other.peak;
+        chunks = other.chunks;
+        overflows = other.overflows;
+        other.block = nullptr;
+        other.size = 0;
+        other.used = 0;
+        other.chunks = nullptr;
+    }
+    return *this;
+}
+
+/**
+ * reserve: Replace the block with a bigger one (contents are not kept -
+ * there are none while nothing is allocated)
+ */
+void Arena::reserve(size_t bytes)
+{
+    if (bytes <= size || used != 0)
+    {
+        return;
+    }
+    ::operator delete(block);
+    block = static_cast<unsigned char *>(::operator new(bytes));
+    size = bytes;
+}
+
+/**
+ * allocate: Bump the cursor
+ * - Round up to the alignment (the block itself is max_align aligned, so
+ *   aligned offsets are aligned addresses)
+ * - Requests that don't fit go to an overflow chunk
+ */
+void *Arena::allocate(size_t bytes, size_t align)
+{
+    size_t offset = (used + align - 1) & ~(align - 1);
+    if (offset <= size && bytes <= size - offset)
+    {
+        used = offset + bytes;
+        peak = std::max(peak, used);
+        return block + offset;
+    }
+    return allocateOverflow(bytes, align);
+}
+
+/**
+ * allocateOverflow: One heap chunk per request
+ * The cursor moves past the block (and past this request), so later
+ * allocations also overflow until the arena is rewound - the cursor stays
+ * monotonic and marks keep working across block and chunks
+ */
+void *Arena::allocateOverflow(size_t bytes, size_t align)
+{
+    size_t headerBytes = footprint(sizeof(Chunk), align);
+    unsigned char *raw = static_cast<unsigned char *>(::operator new(headerBytes + bytes));
+    Chunk *chunk = reinterpret_cast<Chunk *>(raw);
+    chunk->previous = chunks;
+    chunk->position = used;
+    chunks = chunk;
+    overflows++;
+
+    used = std::max(used, size) + footprint(bytes, align);
+    peak = std::max(peak, used);
+
+    uintptr_t data = (reinterpret_cast<uintptr_t>(raw) + sizeof(Chunk) + align - 1) & ~(uintptr_t)(align - 1);
+    return reinterpret_cast<void *>(data);
+}
+
+/**
+ * rewind: Move the cursor back; free chunks allocated at or after mark
+ */
+void Arena::rewind(size_t mark)
+{
+    while (chunks != nullptr && chunks->position >= mark)
+    {
+        Chunk *previous = chunks->previous;
+        ::operator delete(chunks);
+        chunks = previous;
+    }
+    used = std::min(used, mark);
+}
+
+/**
+ * release: Give everything back to the heap
+ */
+void Arena::release()
+{
+    rewind(0);
+    ::operator delete(block);
+    block = nullptr;
+    size = 0;
+}
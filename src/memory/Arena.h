@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * Arena: Bump allocator for storage that is thrown away all at once
+ *
+ * Allocation:
+ * - One contiguous block, sized up front with reserve(); allocate() only
+ *   rounds the cursor up to the alignment and advances it (no headers,
+ *   no free lists, no locking)
+ * - Nothing is freed individually: rewind(mark) drops everything
+ *   allocated after mark and reset() drops everything, both in O(1)
+ *   whatever was allocated (memory is kept for the next round)
+ * - Only for trivially destructible types - no destructors are run
+ *
+ * Marks:
+ * - Long-lived storage is allocated first and mark() taken after it; a
+ *   rewind(mark) then recycles only the short-lived storage on top
+ *   (Game keeps the profiler's trace buffer below its per-run mark)
+ *
+ * Overflow:
+ * - Allocations that don't fit the block get their own heap chunk, so an
+ *   undersized arena is slower, never wrong; chunks are freed when the
+ *   arena is rewound past them
+ * - overflowCount() reports them (and debug builds catch them through
+ *   NO_ALLOCATION_SCOPE, see AllocationCounter.h), so callers can fix
+ *   their reserve() sizes
+ *
+ * Single-threaded, move-only (moving keeps every allocation valid).
+ */
+class Arena
+{
+public:
+    Arena() = default;
+
+    /**
+     * Constructor: Reserve a block of `bytes` up front
+     */
+    explicit Arena(size_t bytes);
+
+    ~Arena();
+
+    Arena(Arena &&other) noexcept;
+    Arena &operator=(Arena &&other) noexcept;
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    /**
+     * reserve: Make the block at least `bytes` large
+     * Only while nothing is allocated (the block may move); no-op if it
+     * is already big enough
+     */
+    void reserve(size_t bytes);
+
+    /**
+     * allocate: `bytes` of uninitialized storage aligned to `align`
+     * (a power of two, at most alignof(std::max_align_t))
+     */
+    void *allocate(size_t bytes, size_t align);
+
+    /**
+     * allocateArray: Uninitialized storage for n values of T
+     */
+    template <typename T>
+    T *allocateArray(size_t n)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "Arena never runs destructors");
+        return static_cast<T *>(allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * mark: Current position (pass to rewind to drop what follows it)
+     */
+    size_t mark() const { return used; }
+
+    /**
+     * top: Address the next block allocation starts at (before alignment),
+     * or nullptr once allocations have overflowed the block
+     * (storage carved between two tops is one contiguous byte range)
+     */
+    unsigned char *top() const
+    {
+        return (used <= size) ? block + used : nullptr;
+    }
+
+    /**
+     * rewind: Drop every allocation made after mark (O(1) for the block)
+     */
+    void rewind(size_t mark);
+
+    /**
+     * reset: Drop every allocation
+     */
+    void reset() { rewind(0); }
+
+    /**
+     * footprint: Bytes an allocation can take out of the block, including
+     * worst-case alignment padding (for sizing reserve())
+     */
+    static size_t footprint(size_t bytes, size_t align)
+    {
+        return bytes + align - 1;
+    }
+
+    /**
+     * footprintOf: footprint() of allocateArray<T>(n)
+     */
+    template <typename T>
+    static size_t footprintOf(size_t n)
+    {
+        return footprint(n * sizeof(T), alignof(T));
+    }
+
+    size_t capacity() const { return size; }        // Block size in bytes
+    size_t bytesUsed() const { return used; }      // Bytes allocated since the last reset (incl. padding and overflow)
+    size_t peakBytes() const { return peak; }      // Most bytes ever allocated at once
+    int overflowCount() const { return overflows; }  // Allocations that missed the block since construction
+
+private:
+    /**
+     * Chunk: Heap allocation for one request that didn't fit the block
+     * Chunks form a stack; `position` is the mark the allocation started at
+     */
+    struct Chunk
+    {
+        Chunk *previous;
+        size_t position;
+    };
+
+    /**
+     * allocateOverflow: Give one allocation its own chunk
+     */
+    void *allocateOverflow(size_t bytes, size_t align);
+
+    /**
+     * release: Free the block and every chunk
+     */
+    void release();
+
+    unsigned char *block = nullptr;  // Preallocated storage
+    size_t size = 0;                 // Block size
+    size_t used = 0;                 // Cursor (block offset; past size once chunks are in use)
+    size_t peak = 0;                 // High-water mark of used
+    Chunk *chunks = nullptr;         // Overflow chunks, newest first
+    int overflows = 0;               // Overflow allocations made
+};
+
+/**
+ * ArenaArray: Fixed-size array view over arena storage
+ * - Plain pointer + length, trivially copyable; the arena owns the memory
+ * - Contents start uninitialized (every user fills what it allocates)
+ * - Invalid once the arena is rewound past it
+ */
+template <typename T>
+struct ArenaArray
+{
+    T *items = nullptr;
+    int length = 0;
+
+    /**
+     * allocate: Point at n fresh values of T from the arena
+     */
+    void allocate(Arena &arena, int n)
+    {
+        items = arena.allocateArray<T>((size_t)n);
+        length = n;
+    }
+
+    int size() const { return length; }
+    T *data() { return items; }
+    const T *data() const { return items; }
+    T &operator[](int i) { return items[i]; }
+    const T &operator[](int i) const { return items[i]; }
+    T *begin() { return items; }
+    T *end() { return items + length; }
+    const T *begin() const { return items; }
+    const T *end() const { return items + length; }
+};
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * MpscRing: Lock-free bounded queue from many producers to one consumer
+ *
+ * - Slots are allocated once by the constructor (Capacity slots, a power
+ *   of two); pushing and popping never allocate
+ * - Each slot carries a sequence number saying whose turn it is. A
+ *   producer claims the next position with one compare-exchange on tail,
+ *   fills the slot and publishes it by storing sequence = position + 1;
+ *   the consumer reads it and hands the slot to the producer one lap
+ *   later by storing sequence = position + Capacity
+ * - A full ring makes tryPush return false right away: producers never
+ *   wait for the consumer (callers count the drop instead)
+ * - head is the consumer's alone (plain, no atomic); tail is padded onto
+ *   its own cache line so producers don't bounce the consumer's line
+ */
+template <typename T, int Capacity>
+class MpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    MpscRing() : slots(new Slot[Capacity])
+    {
+        for (int i = 0; i < Capacity; i++)
+        {
+            slots[i].sequence.store((uint64_t)i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscRing(const MpscRing &) = delete;
+    MpscRing &operator=(const MpscRing &) = delete;
+
+    /**
+     * tryPush: Copy value into the ring (any thread)
+     * Returns false if the ring is full
+     */
+    bool tryPush(const T &value)
+    {
+        uint64_t pos = tail.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Slot &slot = slots[pos & (Capacity - 1)];
+            uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+            int64_t lag = (int64_t)(seq - pos);
+            if (lag == 0)
+            {
+                // Slot is free for this position: claim it (pos is reloaded on failure)
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    slot.value = value;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (lag < 0)
+            {
+                return false;  // Still holds the value from one lap ago: full
+            }
+            else
+            {
+                pos = tail.load(std::memory_order_relaxed);  // Another producer took it
+            }
+        }
+    }
+
+    /**
+     * tryPop: Move the oldest published value out (consumer only)
+     * Returns false if the ring is empty (or the oldest claimed slot is
+     * still being filled)
+     */
+    bool tryPop(T &value)
+    {
+        Slot &slot = slots[head & (Capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != head + 1)
+        {
+            return false;
+        }
+        value = slot.value;
+        slot.sequence.store(head + Capacity, std::memory_order_release);
+        head++;
+        return true;
+    }
+
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> sequence{0};
+        T value;
+    };
+
+    std::atomic<uint64_t> tail{0};  // Next position to claim (producers)
+    char padding[64] = {};          // Keeps tail and the consumer's fields on separate cache lines
+    uint64_t head = 0;              // Next position to read (consumer)
+    std::unique_ptr<Slot[]> slots;
+};
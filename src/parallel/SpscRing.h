@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * SpscRing: Lock-free bounded queue between one producer and one consumer
+ *
+ * - Slots live inline (no allocation); Capacity must be a power of two
+ * - Zero-copy use: the producer fills the slot beginPush() hands out and
+ *   publishes it with endPush(); the consumer reads front() in place and
+ *   frees it with pop(). tryPush / tryPop copy small values instead
+ * - head is only written by the consumer and tail only by the producer;
+ *   the release store of one and the acquire load of the other order the
+ *   slot contents, so neither side ever waits on the other
+ */
+template <typename T, int Capacity>
+class SpscRing
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /**
+     * beginPush: The next free slot to fill, nullptr if the ring is full
+     * (producer only)
+     */
+    T *beginPush()
+    {
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == (uint64_t)Capacity)
+        {
+            return nullptr;
+        }
+        return &slots[t & (Capacity - 1)];
+    }
+
+    /**
+     * endPush: Publish the slot beginPush() returned (producer only)
+     */
+    void endPush()
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * front: The oldest published slot, nullptr if the ring is empty
+     * (consumer only - valid until pop())
+     */
+    T *front()
+    {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        return &slots[h & (Capacity - 1)];
+    }
+
+    /**
+     * pop: Hand the front slot back to the producer (consumer only)
+     */
+    void pop()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * tryPush / tryPop: Copying versions of the above (false if full / empty)
+     */
+    bool tryPush(const T &value)
+    {
+        T *slot = beginPush();
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        *slot = value;
+        endPush();
+        return true;
+    }
+
+    bool tryPop(T &value)
+    {
+        T *slot = front();
+        if (slot == nullptr)
+        {
+            return false;
+        }
+        value = *slot;
+        pop();
+        return true;
+    }
+
+private:
+    std::atomic<uint64_t> head{0};  // Next slot to read (consumer's end)
+    char padding[64] = {};          // Keeps head and tail on separate cache lines
+    std::atomic<uint64_t> tail{0};  // Next slot to write (producer's end)
+    char tailPadding[64] = {};      // Keeps tail off the first slot's line
+    T slots[Capacity];
+};
@@ -0,0 +1,140 @@
+#include "ThreadPool.h"
+#include "../sim/Rng.h"
+#include <algorithm>
+
+/**
+ * ThreadPool constructor: One deque and one thread per worker
+ */
+ThreadPool::ThreadPool(int threads)
+{
+    if (threads <= 0)
+    {
+        threads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    for (int w = 0; w < threads; w++)
+    {
+        deques.emplace_back(new WorkStealingDeque());
+    }
+    for (int w = 0; w < threads; w++)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this, w);
+    }
+}
+
+/**
+ * Destructor: Wake everyone with the stop flag and join
+ */
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &t : workers)
+    {
+        t.join();
+    }
+}
+
+/**
+ * run: Deal jobs onto the deques, start the batch and wait for it
+ * - Job j covers items [j * grain, min((j + 1) * grain, count))
+ * - Deques are filled before the workers wake (mutex hand-off), so the
+ *   fill needs no atomics beyond the deque's own
+ */
+void ThreadPool::run(int64_t count, int64_t grain, JobFunction fn, void *ctx)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    grain = std::max<int64_t>(1, grain);
+    int64_t jobs = (count + grain - 1) / grain;
+    int threads = threadCount();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    for (int w = 0; w < threads; w++)
+    {
+        deques[w]->reset(jobs / threads + 1);
+    }
+    for (int64_t j = 0; j < jobs; j++)
+    {
+        deques[j % threads]->push(j);
+    }
+
+    function = fn;
+    context = ctx;
+    itemCount = count;
+    grainSize = grain;
+    jobsLeft.store(jobs, std::memory_order_relaxed);
+    busyWorkers = threads;
+    batch++;
+    wake.notify_all();
+
+    idle.wait(lock, [this] { return busyWorkers == 0; });
+}
+
+/**
+ * workerLoop: Wait for the next batch, work it, report back
+ */
+void ThreadPool::workerLoop(int worker)
+{
+    uint64_t seenBatch = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] { return stopping || batch != seenBatch; });
+            if (stopping)
+            {
+                return;
+            }
+            seenBatch = batch;
+        }
+
+        processJobs(worker);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0)
+        {
+            idle.notify_one();
+        }
+    }
+}
+
+/**
+ * processJobs: Own deque first, then steal
+ * - Victims are picked at random (per-worker Rng) so thieves spread out
+ * - A worker leaves once no job is left anywhere; jobs still running on
+ *   other workers are counted by jobsLeft, so nobody leaves early with
+ *   work that could still be stolen
+ */
+void ThreadPool::processJobs(int worker)
+{
+    int threads = threadCount();
+    Rng victims;
+    victims.seed((uint64_t)worker);
+
+    while (jobsLeft.load(std::memory_order_acquire) > 0)
+    {
+        int64_t job;
+        bool found = deques[worker]->pop(job);
+        for (int attempt = 0; !found && attempt < threads * 2; attempt++)
+        {
+            int victim = victims.range(0, threads - 1);
+            found = (victim != worker) && deques[victim]->steal(job);
+        }
+
+        if (!found)
+        {
+            std::this_thread::yield();  // Remaining jobs are running elsewhere (or contended)
+            continue;
+        }
+
+        int64_t begin = job * grainSize;
+        int64_t end = std::min(begin + grainSize, itemCount);
+        function(context, begin, end, worker);
+        jobsLeft.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "WorkStealingDeque.h"
+
+/**
+ * ThreadPool: Persistent worker threads with work-stealing job deques
+ *
+ * parallelFor(count, grain, body) splits [0, count) into jobs of `grain`
+ * items, deals them round-robin onto one deque per worker, and wakes the
+ * workers. Each worker drains its own deque from the bottom, then steals
+ * from the top of random other deques until every job has run.
+ *
+ * body(begin, end, worker) must be safe to call concurrently; `worker`
+ * (0..threadCount()-1) lets it write to per-worker state without locks.
+ * parallelFor returns once every job has finished. One parallelFor at a
+ * time - it is called from a single controlling thread.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * Constructor: Start `threads` workers (0 = one per hardware thread)
+     */
+    explicit ThreadPool(int threads = 0);
+
+    /**
+     * Destructor: Stop and join the workers
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * threadCount: Number of workers
+     */
+    int threadCount() const { return (int)workers.size(); }
+
+    /**
+     * parallelFor: Run body(begin, end, worker) over [0, count) in grain-sized jobs
+     */
+    template <typename Body>
+    void parallelFor(int64_t count, int64_t grain, Body &&body)
+    {
+        run(count, grain, [](void *context, int64_t begin, int64_t end, int worker)
+        {
+            (*(typename std::remove_reference<Body>::type *)context)(begin, end, worker);
+        }, &body);
+    }
+
+private:
+    typedef void (*JobFunction)(void *context, int64_t begin, int64_t end, int worker);
+
+    /**
+     * run: Type-erased parallelFor (fills the deques, wakes workers, waits)
+     */
+    void run(int64_t count, int64_t grain, JobFunction function, void *context);
+
+    /**
+     * workerLoop: Thread body - sleep until a batch starts, then process jobs
+     */
+    void workerLoop(int worker);
+
+    /**
+     * processJobs: Pop own jobs, steal the rest, until the batch is done
+     */
+    void processJobs(int worker);
+
+    // ===== Workers =====
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkStealingDeque>> deques;  // One per worker
+
+    // ===== Current Batch =====
+    JobFunction function = nullptr;
+    void *context = nullptr;
+    int64_t itemCount = 0;            // Items in the batch
+    int64_t grainSize = 1;            // Items per job
+    std::atomic<int64_t> jobsLeft{0}; // Jobs not yet finished
+
+    // ===== Sleep / Wake =====
+    std::mutex mutex;
+    std::condition_variable wake;     // Workers wait for a new batch (or stop)
+    std::condition_variable idle;     // run() waits for every worker to finish
+    uint64_t batch = 0;               // Incremented per parallelFor
+    int busyWorkers = 0;              // Workers still inside the current batch
+    bool stopping = false;
+};
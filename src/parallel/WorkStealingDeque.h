@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+/**
+ * WorkStealingDeque: Lock-free Chase-Lev deque of job ids
+ *
+ * - The owning worker pushes and pops at the bottom (LIFO, cache-warm)
+ * - Other workers steal from the top (FIFO, oldest = usually largest work)
+ * - Fixed capacity chosen by reset(); the pool sizes it so it never fills
+ *
+ * Memory ordering follows Le, Pop, Cohen, Zappa Nardelli, "Correct and
+ * Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013), minus
+ * buffer growth.
+ */
+class WorkStealingDeque
+{
+public:
+    /**
+     * reset: Empty the deque and make room for at least capacity ids
+     * Only call while no other thread is using it
+     */
+    void reset(int64_t capacity)
+    {
+        int64_t size = 1;
+        while (size < capacity) size <<= 1;
+        if (size != bufferSize)
+        {
+            buffer.reset(new std::atomic<int64_t>[(size_t)size]);
+            bufferSize = size;
+        }
+        top.store(0, std::memory_order_relaxed);
+        bottom.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * push: Add a job at the bottom (owner only)
+     */
+    void push(int64_t job)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        buffer[(size_t)(b & (bufferSize - 1))].store(job, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * pop: Take the newest job (owner only)
+     * Returns false if empty or a thief took the last job first
+     */
+    bool pop(int64_t &job)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            bottom.store(b + 1, std::memory_order_relaxed);  // Was empty
+            return false;
+        }
+
+        job = buffer[(size_t)(b & (bufferSize - 1))].load(std::memory_order_relaxed);
+        if (t == b)
+        {
+            // Last job: race thieves for it
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /**
+     * steal: Take the oldest job (any thread)
+     * Returns false if empty or another thread won the race (caller may retry)
+     */
+    bool steal(int64_t &job)
+    {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b)
+        {
+            return false;
+        }
+        job = buffer[(size_t)(t & (bufferSize - 1))].load(std::memory_order_relaxed);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<int64_t> top{0};     // Next id to steal (thieves' end)
+    char padding[64] = {};           // Keeps top and bottom on separate cache lines
+    std::atomic<int64_t> bottom{0};  // Next free slot (owner's end)
+    std::unique_ptr<std::atomic<int64_t>[]> buffer;
+    int64_t bufferSize = 0;          // Power of two
+};
@@ -1,4 +1,6 @@
 #include "Player.h"
+#include "../profile/Profiler.h"
+#include <algorithm>
 
 /**
  * reset: Initialize player to starting state
@@ -7,17 +9,36 @@
  * - Jumps: Full (2 available)
  * - State: Grounded, not jumping, hasn't left ground yet
  */
-void Player::reset(const GameConfig &cfg)
+template <typename Scalar>
+void BasicPlayer<Scalar>::reset(const GameConfig &cfg)
 {
     x = cfg.screenWidth * 0.25f;  // Fixed horizontal position (doesn't change during gameplay)
-    y = cfg.groundY;               // Start at ground level
-    vy = 0.0f;                     // No initial velocity
+    y = Traits::fromFloat(cfg.groundY);  // Start at ground level
+    vy = Scalar();                 // No initial velocity
     rotation = 0.0f;               // No rotation offset
     jumpsRemaining = 2;            // Start with double jump available
     isJumping = false;             // Not currently jumping
     grounded = true;               // Starting on the ground
     hasLeftGround = false;         // Haven't jumped yet (touching ground is safe)
-    jumpHoldTimer = 0.0f;          // No jump hold time
+    jumpHoldTimer = Scalar();      // No jump hold time
+    computeConstants(cfg.fixedTimestep, cfg);  // Physics settings for this run
+}
+
+/**
+ * computeConstants: Config values in Scalar, per-step ones for this dt
+ */
+template <typename Scalar>
+void BasicPlayer<Scalar>::computeConstants(float dt, const GameConfig &cfg)
+{
+    constantsDt = dt;
+    step = Traits::fromFloat(dt);
+    gravityStep = Traits::fromFloat(cfg.gravity) * step;
+    jumpHoldStep = Traits::fromFloat(cfg.jumpHoldAccel) * step;
+    maxJumpHold = Traits::fromFloat(cfg.maxJumpHold);
+    jumpVelocity = Traits::fromFloat(cfg.jumpVelocity);
+    half = Traits::fromFloat(0.5f);
+    gravityDrop = gravityStep * step * half;
+    jumpHoldAccel = Traits::fromFloat(cfg.jumpHoldAccel);
 }
 
 /**
@@ -27,7 +48,8 @@ void Player::reset(const GameConfig &cfg)
  * - Consumes one jump charge
  * - Marks player as having left ground (enables death-on-ground-touch rule)
  */
-void Player::startJump(const GameConfig &cfg)
+template <typename Scalar>
+void BasicPlayer<Scalar>::startJump()
 {
     // Can't jump if no jumps remaining
     if (jumpsRemaining <= 0)
@@ -36,14 +58,14 @@ void Player::startJump(const GameConfig &cfg)
     }
     
     // Apply initial jump velocity (negative = upward)
-    vy = cfg.jumpVelocity;
+    vy = jumpVelocity;
     
     // Update state
     isJumping = true;              // Now in air
     grounded = false;              // No longer on surface
     hasLeftGround = true;          // Mark that we've jumped (ground becomes lethal)
     jumpsRemaining--;              // Consume one jump charge
-    jumpHoldTimer = 0.0f;          // Reset hold timer for variable height
+    jumpHoldTimer = Scalar();      // Reset hold timer for variable height
 }
 
 /**
@@ -54,26 +76,59 @@ void Player::startJump(const GameConfig &cfg)
  * 2. If holding jump button during jump, apply extra upward acceleration
  *    (variable jump height - hold longer = jump higher)
  * 3. Update vertical position based on velocity
+ * (all in Scalar, with the constants converted at reset)
+ *
+ * Continuous mode (cfg.continuousCollision):
+ * - Steps 1-3 are integrated exactly for constant acceleration
+ *   (y += vy*dt + a*dt^2/2) instead of velocity-then-position Euler steps,
+ *   whose trajectory drifts by a*t*dt/2 - more the coarser the step
+ * - Hold acceleration only applies for the hold time left in this step,
+ *   so a step that runs past maxJumpHold doesn't give extra height
  * 
  * Visuals:
  * 4. Rotate ball to match scroll speed (630 deg/sec matches 220 px/sec scroll)
  *    This creates realistic rolling motion as the world scrolls left
  */
-void Player::update(float dt, const GameConfig &cfg)
+template <typename Scalar>
+void BasicPlayer<Scalar>::update(float dt, bool jumpHeld, const GameConfig &cfg)
 {
-    // Apply gravity (constant downward acceleration)
-    vy += cfg.gravity * dt;
-    
-    // Variable jump height: holding space adds extra upward acceleration
-    // Limited by maxJumpHold (0.25 sec) to prevent infinite height
-    if (IsKeyDown(KEY_SPACE) && isJumping && jumpHoldTimer < cfg.maxJumpHold)
+    PROFILE_SCOPE(PlayerUpdate);
+
+    if (dt != constantsDt)
     {
-        vy += cfg.jumpHoldAccel * dt;  // Additional upward push
-        jumpHoldTimer += dt;            // Track how long we've held
+        computeConstants(dt, cfg);  // Stepped with a different dt than reset assumed
+    }
+
+    if (cfg.continuousCollision)
+    {
+        // Exact step: gravity for the whole step, hold accel for its held part
+        Scalar dy = vy * step + gravityDrop;
+        vy += gravityStep;
+        if (jumpHeld && isJumping && jumpHoldTimer < maxJumpHold)
+        {
+            Scalar held = std::min(step, maxJumpHold - jumpHoldTimer);  // Held at the start of the step
+            dy += jumpHoldAccel * held * (step - held * half);
+            vy += jumpHoldAccel * held;
+            jumpHoldTimer += held;
+        }
+        y += dy;
+    }
+    else
+    {
+        // Apply gravity (constant downward acceleration)
+        vy += gravityStep;
+
+        // Variable jump height: holding space adds extra upward acceleration
+        // Limited by maxJumpHold (0.25 sec) to prevent infinite height
+        if (jumpHeld && isJumping && jumpHoldTimer < maxJumpHold)
+        {
+            vy += jumpHoldStep;             // Additional upward push
+            jumpHoldTimer += step;          // Track how long we've held
+        }
+
+        // Update vertical position based on velocity
+        y += vy * step;
     }
-    
-    // Update vertical position based on velocity
-    y += vy * dt;
     
     // Visual rotation for rolling effect
     // 630 deg/sec matches scroll speed: one full rotation per ball circumference
@@ -86,7 +141,8 @@ void Player::update(float dt, const GameConfig &cfg)
  * canJump: Query if player can currently jump
  * Returns true if player has at least one jump charge remaining
  */
-bool Player::canJump() const
+template <typename Scalar>
+bool BasicPlayer<Scalar>::canJump() const
 {
     return jumpsRemaining > 0;
 }
@@ -99,7 +155,8 @@ bool Player::canJump() const
  * - Refills jump charges to 2 (resets double jump)
  * - Clears isJumping flag
  */
-void Player::setGrounded(bool groundedState)
+template <typename Scalar>
+void BasicPlayer<Scalar>::setGrounded(bool groundedState)
 {
     grounded = groundedState;
     
@@ -116,7 +173,12 @@ void Player::setGrounded(bool groundedState)
  * Used for game rule: touching ground after first jump = death
  * Returns true if player has jumped at least once since game start/reset
  */
-bool Player::hasJumpedOnce() const
+template <typename Scalar>
+bool BasicPlayer<Scalar>::hasJumpedOnce() const
 {
     return hasLeftGround;
 }
+
+// Both numeric types are always built (benchmarks compare them)
+template class BasicPlayer<float>;
+template class BasicPlayer<Q16_16>;
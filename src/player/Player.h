@@ -1,7 +1,7 @@
 #pragma once
 
-#include "raylib.h"
 #include "../config/Config.h"
+#include "../sim/Fixed.h"
 
 /**
  * Player: Represents the ball character controlled by the player
@@ -14,8 +14,18 @@
  * 
  * The player scrolls horizontally automatically via the level scroll,
  * and the player controls vertical movement via jumping.
+ * 
+ * Numeric Type:
+ * - The physics state (y, vy, jump hold timer) and its integration use
+ *   Scalar: float, or Q16.16 fixed point for results that are bit-identical
+ *   on every platform (see Fixed.h)
+ * - Config values are converted to Scalar at reset() (physics settings must
+ *   not change mid-run)
+ * - Player is the build's choice (PhysicsScalar); both are always compiled
+ * - x and rotation stay float (constant position / visual only)
  */
-class Player
+template <typename Scalar>
+class BasicPlayer
 {
 public:
     // ===== Core Methods =====
@@ -29,14 +39,18 @@ public:
     /**
      * startJump: Initiate a jump if jumps remain
      * Consumes one jump from jumpsRemaining (max 2)
+     * Uses the jump velocity reset() converted from the config
      */
-    void startJump(const GameConfig &cfg);
+    void startJump();
     
     /**
      * update: Apply physics (gravity, jump hold) and update rotation
-     * Called every frame - handles vertical movement and rolling animation
+     * Called every step - handles vertical movement and rolling animation
+     * jumpHeld is the injected jump button state (no keyboard polling here)
+     * With cfg.continuousCollision the step is integrated exactly, so the
+     * trajectory is the same at any dt (see update in Player.cpp)
      */
-    void update(float dt, const GameConfig &cfg);
+    void update(float dt, bool jumpHeld, const GameConfig &cfg);
     
     /**
      * canJump: Check if player can jump (has jumps remaining)
@@ -56,15 +70,38 @@ public:
      */
     bool hasJumpedOnce() const;
 
+    typedef ScalarTraits<Scalar> Traits;  // float <-> Scalar conversions
+
     // ===== Public State (accessed by Game for rendering/collision) =====
     
     float x = 0.0f;              // Horizontal position (fixed at 25% screen width)
-    float y = 0.0f;              // Vertical position (world coordinates)
-    float vy = 0.0f;             // Vertical velocity (negative = moving up)
+    Scalar y = Scalar();         // Vertical position (world coordinates)
+    Scalar vy = Scalar();        // Vertical velocity (negative = moving up)
     float rotation = 0.0f;       // Visual rotation angle (degrees, for rolling effect)
     int jumpsRemaining = 2;      // Jump charges (0-2, refills on landing)
     bool isJumping = false;      // Currently in jump motion
     bool grounded = true;        // Currently on a platform or ground
     bool hasLeftGround = false;  // Has jumped at least once (used for death condition)
-    float jumpHoldTimer = 0.0f;  // Time spent holding jump button (for variable height)
+    Scalar jumpHoldTimer = Scalar();  // Time spent holding jump button (for variable height)
+
+    // ===== Physics Constants (cfg in Scalar, converted by reset / a new dt) =====
+    float constantsDt = 0.0f;         // dt the per-step constants were computed for
+    Scalar step = Scalar();           // dt
+    Scalar gravityStep = Scalar();    // gravity * dt
+    Scalar jumpHoldStep = Scalar();   // jumpHoldAccel * dt
+    Scalar maxJumpHold = Scalar();    // cfg.maxJumpHold
+    Scalar jumpVelocity = Scalar();   // cfg.jumpVelocity
+    Scalar gravityDrop = Scalar();    // gravity * dt^2 / 2 (exact integration)
+    Scalar jumpHoldAccel = Scalar();  // cfg.jumpHoldAccel (exact integration)
+    Scalar half = Scalar();           // 0.5
+
+private:
+    /**
+     * computeConstants: Convert the config values update/startJump use
+     * (once per reset instead of every step - conversions cost more than
+     * the integration itself in fixed point)
+     */
+    void computeConstants(float dt, const GameConfig &cfg);
 };
+
+typedef BasicPlayer<PhysicsScalar> Player;
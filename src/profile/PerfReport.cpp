@@ -0,0 +1,246 @@
+#include "PerfReport.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+void PerfReport::add(const char *name, double value, const char *unit, bool higherIsBetter)
+{
+    PerfMetric metric;
+    metric.name = name;
+    metric.value = value;
+    metric.unit = unit;
+    metric.higherIsBetter = higherIsBetter;
+    for (PerfMetric &m : metrics)
+    {
+        if (m.name == metric.name)
+        {
+            m = metric;
+            return;
+        }
+    }
+    metrics.push_back(metric);
+}
+
+const PerfMetric *PerfReport::find(const std::string &name) const
+{
+    for (const PerfMetric &m : metrics)
+    {
+        if (m.name == name)
+        {
+            return &m;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * write: Context fields first, then one metric object per line
+ */
+bool PerfReport::write(const char *path) const
+{
+    std::FILE *file = std::fopen(path, "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"variant\": \"%s\",\n", variant.c_str());
+    std::fprintf(file, "  \"runs\": %lld,\n", runs);
+    std::fprintf(file, "  \"frames\": %lld,\n", frames);
+    std::fprintf(file, "  \"metrics\": [\n");
+    for (size_t i = 0; i < metrics.size(); i++)
+    {
+        const PerfMetric &m = metrics[i];
+        std::fprintf(file, "    {\"name\": \"%s\", \"value\": %.9g, \"unit\": \"%s\", \"better\": \"%s\"}%s\n",
+                     m.name.c_str(), m.value, m.unit.c_str(), m.higherIsBetter ? "higher" : "lower",
+                     (i + 1 < metrics.size()) ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+
+    bool ok = std::ferror(file) == 0;
+    ok = (std::fclose(file) == 0) && ok;
+    return ok;
+}
+
+/**
+ * textField: The string after `"key": "` on a line, up to the closing quote
+ */
+static bool textField(const char *line, const char *key, std::string &out)
+{
+    std::string pattern = std::string("\"") + key + "\": \"";
+    const char *start = std::strstr(line, pattern.c_str());
+    if (!start)
+    {
+        return false;
+    }
+    start += pattern.size();
+    const char *end = std::strchr(start, '"');
+    if (!end)
+    {
+        return false;
+    }
+    out.assign(start, end);
+    return true;
+}
+
+/**
+ * numberField: The number after `"key": ` on a line
+ */
+static bool numberField(const char *line, const char *key, double &out)
+{
+    std::string pattern = std::string("\"") + key + "\": ";
+    const char *start = std::strstr(line, pattern.c_str());
+    if (!start)
+    {
+        return false;
+    }
+    char *end = nullptr;
+    out = std::strtod(start + pattern.size(), &end);
+    return end != start + pattern.size();
+}
+
+/**
+ * read: Scan line by line; a line with a "name" field is a metric, the
+ * others carry the context fields
+ */
+bool PerfReport::read(const char *path)
+{
+    std::FILE *file = std::fopen(path, "r");
+    if (!file)
+    {
+        return false;
+    }
+    variant.clear();
+    runs = frames = 0;
+    metrics.clear();
+
+    char line[512];
+    while (std::fgets(line, sizeof(line), file))
+    {
+        PerfMetric metric;
+        std::string better;
+        double number = 0.0;
+        if (textField(line, "name", metric.name) && numberField(line, "value", metric.value) &&
+            textField(line, "unit", metric.unit) && textField(line, "better", better))
+        {
+            metric.higherIsBetter = better == "higher";
+            metrics.push_back(metric);
+            continue;
+        }
+        textField(line, "variant", variant);
+        if (numberField(line, "runs", number))
+        {
+            runs = (long long)number;
+        }
+        if (numberField(line, "frames", number))
+        {
+            frames = (long long)number;
+        }
+    }
+    std::fclose(file);
+    return !metrics.empty();
+}
+
+/**
+ * worseBy: Relative change in the bad direction (negative = improved)
+ */
+static double worseBy(const PerfMetric &baseline, double value)
+{
+    double delta = baseline.higherIsBetter ? baseline.value - value : value - baseline.value;
+    if (baseline.value == 0.0)
+    {
+        return (delta > 0.0) ? INFINITY : (delta < 0.0 ? -INFINITY : 0.0);
+    }
+    return delta / std::fabs(baseline.value);
+}
+
+int comparePerf(const PerfReport &baseline, const PerfReport &current, double tolerance)
+{
+    int regressions = 0;
+    std::printf("%-28s %14s %14s %9s\n", "metric", "baseline", "current", "change");
+    for (const PerfMetric &m : current.metrics)
+    {
+        const PerfMetric *base = baseline.find(m.name);
+        if (!base)
+        {
+            std::printf("%-28s %14s %14.4g %9s  (new)\n", m.name.c_str(), "-", m.value, "");
+            continue;
+        }
+        double worse = worseBy(*base, m.value);
+        double change = (base->value != 0.0) ? (m.value - base->value) / std::fabs(base->value) * 100.0 : 0.0;
+        bool regressed = worse > tolerance;
+        regressions += regressed ? 1 : 0;
+        std::printf("%-28s %14.4g %14.4g %+8.1f%%  %s\n", m.name.c_str(), base->value, m.value, change,
+                    regressed ? "REGRESSION" : worse < -tolerance ? "improved" : "");
+    }
+    for (const PerfMetric &m : baseline.metrics)
+    {
+        if (!current.find(m.name))
+        {
+            std::printf("%-28s %14.4g %14s %9s  (not measured)\n", m.name.c_str(), m.value, "-", "");
+        }
+    }
+    return regressions;
+}
+
+/**
+ * printPerfTable: Metrics in the order the first report lists them, then
+ * any the others add
+ */
+void printPerfTable(const std::vector<PerfReport> &reports)
+{
+    if (reports.empty())
+    {
+        return;
+    }
+    std::vector<std::string> names;
+    for (const PerfReport &r : reports)
+    {
+        for (const PerfMetric &m : r.metrics)
+        {
+            bool listed = false;
+            for (const std::string &name : names)
+            {
+                listed = listed || name == m.name;
+            }
+            if (!listed)
+            {
+                names.push_back(m.name);
+            }
+        }
+    }
+
+    std::printf("%-28s", "metric");
+    for (const PerfReport &r : reports)
+    {
+        std::printf(" %20s", r.variant.c_str());
+    }
+    std::printf("\n");
+    for (const std::string &name : names)
+    {
+        std::printf("%-28s", name.c_str());
+        const PerfMetric *first = reports[0].find(name);
+        for (size_t i = 0; i < reports.size(); i++)
+        {
+            const PerfMetric *m = reports[i].find(name);
+            if (!m)
+            {
+                std::printf(" %20s", "-");
+            }
+            else if (i == 0 || !first || first->value == 0.0)
+            {
+                std::printf(" %20.4g", m->value);
+            }
+            else
+            {
+                char cell[32];
+                std::snprintf(cell, sizeof(cell), "%.4g (%+.0f%%)", m->value,
+                              (m->value - first->value) / std::fabs(first->value) * 100.0);
+                std::printf(" %20s", cell);
+            }
+        }
+        std::printf("\n");
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * PerfMetric: One end-to-end number tracked across builds
+ */
+struct PerfMetric
+{
+    std::string name;            // "sim/ns_per_step", "render/frame_ms_p99"...
+    double value = 0.0;
+    std::string unit;            // "ns", "frames/s", "ms", "allocs"
+    bool higherIsBetter = false; // Direction that counts as an improvement
+};
+
+/**
+ * PerfReport: The metrics of one perfsuite run, plus which build made them
+ *
+ * Stored as JSON with one metric per line, so read() loads a stored
+ * baseline back with plain line scanning (it only reads what write()
+ * wrote - no general JSON parser).
+ */
+class PerfReport
+{
+public:
+    /**
+     * add: Append a metric (names are unique; a repeated name replaces it)
+     */
+    void add(const char *name, double value, const char *unit, bool higherIsBetter);
+
+    /**
+     * find: Metric by name (nullptr if the run didn't measure it)
+     */
+    const PerfMetric *find(const std::string &name) const;
+
+    /**
+     * write: Store the report; false if the file can't be written
+     */
+    bool write(const char *path) const;
+
+    /**
+     * read: Load a report written by write(); false if missing or unreadable
+     */
+    bool read(const char *path);
+
+    std::string variant;              // Build variant ("debug", "release", "lto", "pgo")
+    long long runs = 0;               // Corpus replays played
+    long long frames = 0;             // Steps in one pass over the corpus
+    std::vector<PerfMetric> metrics;
+};
+
+/**
+ * comparePerf: Print current against baseline metric by metric and count
+ * regressions - metrics that got worse by more than tolerance (relative,
+ * 0.05 = 5%; from a baseline of 0, any increase counts). Metrics only
+ * one side measured are listed but never fail.
+ */
+int comparePerf(const PerfReport &baseline, const PerfReport &current, double tolerance);
+
+/**
+ * printPerfTable: Several reports side by side (one column per variant),
+ * with each column's change against the first report
+ */
+void printPerfTable(const std::vector<PerfReport> &reports);
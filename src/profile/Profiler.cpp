@@ -0,0 +1,187 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+/**
+ * Profiler constructor: Allocate the history ring once (no per-frame allocation)
+ */
+Profiler::Profiler()
+    : history((size_t)kHistoryFrames * kPhaseCount, 0)
+{
+    std::fill(current, current + kPhaseCount, 0);
+}
+
+/**
+ * beginFrame: Clear this frame's phase sums and start the Frame timer
+ */
+void Profiler::beginFrame()
+{
+    std::fill(current, current + kPhaseCount, 0);
+    frameStart = nowNs();
+}
+
+/**
+ * endFrame: Close the Frame timer and push the sums into the history ring
+ */
+void Profiler::endFrame()
+{
+    add(ProfilePhase::Frame, frameStart, nowNs());
+
+    int64_t *row = &history[(size_t)historyHead * kPhaseCount];
+    std::copy(current, current + kPhaseCount, row);
+    historyHead = (historyHead + 1 == kHistoryFrames) ? 0 : historyHead + 1;
+    historyCount = std::min(historyCount + 1, (int)kHistoryFrames);  // Copy: std::min binds references
+}
+
+/**
+ * add: Accumulate a scope into the current frame (and the trace, if capturing)
+ */
+void Profiler::add(ProfilePhase phase, int64_t startNs, int64_t endNs)
+{
+    current[(int)phase] += endNs - startNs;
+
+    if (traceActive && traceCount < traceCapacity)
+    {
+        traceEvents[traceCount++] = {startNs - traceOrigin, endNs - startNs, phase};
+    }
+}
+
+/**
+ * stats: Scan one phase column of the history ring
+ * p99 is the sample at rank ceil(0.99 * n) (nth_element on a stack copy)
+ */
+PhaseStats Profiler::stats(ProfilePhase phase) const
+{
+    PhaseStats result;
+    if (historyCount == 0)
+    {
+        return result;
+    }
+
+    int64_t samples[kHistoryFrames];
+    int64_t total = 0;
+    for (int f = 0; f < historyCount; f++)
+    {
+        samples[f] = history[(size_t)f * kPhaseCount + (int)phase];
+        total += samples[f];
+    }
+
+    int rank = (historyCount * 99 + 99) / 100 - 1;
+    std::nth_element(samples, samples + rank, samples + historyCount);
+    int64_t p99 = samples[rank];
+    int64_t minimum = *std::min_element(samples, samples + historyCount);
+
+    result.minMs = minimum * 1e-6;
+    result.avgMs = (double)total / historyCount * 1e-6;
+    result.p99Ms = p99 * 1e-6;
+    return result;
+}
+
+/**
+ * reserveTrace: Point the trace at arena storage (drops any own buffer)
+ */
+void Profiler::reserveTrace(Arena &arena, size_t maxEvents)
+{
+    traceEvents = arena.allocateArray<TraceEvent>(maxEvents);
+    traceCapacity = maxEvents;
+    traceCount = 0;
+    std::vector<TraceEvent>().swap(ownedTrace);
+}
+
+/**
+ * traceBytes: One TraceEvent per scope
+ */
+size_t Profiler::traceBytes(size_t maxEvents)
+{
+    return Arena::footprintOf<TraceEvent>(maxEvents);
+}
+
+/**
+ * startTrace: Make sure there is room for maxEvents and restart the trace clock
+ */
+void Profiler::startTrace(size_t maxEvents)
+{
+    if (traceCapacity < maxEvents)
+    {
+        ownedTrace.resize(maxEvents);
+        traceEvents = ownedTrace.data();
+        traceCapacity = maxEvents;
+    }
+    traceCount = 0;
+    traceOrigin = nowNs();
+    traceActive = true;
+}
+
+/**
+ * stopTrace: Write captured events in Chrome trace format
+ * - Complete events ("ph":"X") with microsecond timestamps
+ * - One process / one thread (the game thread)
+ */
+bool Profiler::stopTrace(const char *path)
+{
+    if (!traceActive)
+    {
+        return false;
+    }
+    traceActive = false;
+
+    std::FILE *file = std::fopen(path, "w");
+    if (!file)
+    {
+        return false;
+    }
+
+    std::fprintf(file, "{\"traceEvents\":[\n");
+    for (size_t i = 0; i < traceCount; i++)
+    {
+        const TraceEvent &e = traceEvents[i];
+        std::fprintf(file, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}%s\n",
+                     phaseName(e.phase), e.startNs * 1e-3, e.durationNs * 1e-3,
+                     (i + 1 < traceCount) ? "," : "");
+    }
+    std::fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+
+    bool ok = std::ferror(file) == 0;
+    ok = (std::fclose(file) == 0) && ok;
+    return ok;
+}
+
+/**
+ * nowNs: steady_clock in nanoseconds (monotonic, high resolution)
+ */
+int64_t Profiler::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * phaseName: Names used by the overlay and the trace file
+ */
+const char *Profiler::phaseName(ProfilePhase phase)
+{
+    switch (phase)
+    {
+        case ProfilePhase::Frame:          return "frame";
+        case ProfilePhase::Input:          return "input";
+        case ProfilePhase::PlayerUpdate:   return "playerUpdate";
+        case ProfilePhase::Scroll:         return "scroll";
+        case ProfilePhase::ResolveLanding: return "resolveLanding";
+        case ProfilePhase::AwardScore:     return "awardScore";
+        case ProfilePhase::CheckCollision: return "checkCollision";
+        case ProfilePhase::DrawSky:        return "drawSky";
+        case ProfilePhase::DrawPlatforms:  return "drawPlatforms";
+        case ProfilePhase::Hud:            return "hud";
+        default:                           return "?";
+    }
+}
+
+/**
+ * profiler: Function-local static, created on first use
+ */
+Profiler &profiler()
+{
+    static Profiler instance;
+    return instance;
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../memory/Arena.h"
+
+/**
+ * ENABLE_PROFILER: Compile-time switch for frame instrumentation
+ * - 1: PROFILE_SCOPE records timings (Makefile default for debug builds)
+ * - 0: PROFILE_SCOPE expands to nothing (default for release builds)
+ * Override with `make PROFILE=1` to profile an optimized build on device
+ */
+#ifndef ENABLE_PROFILER
+#define ENABLE_PROFILER 0
+#endif
+
+constexpr bool kProfilerEnabled = ENABLE_PROFILER != 0;
+
+/**
+ * ProfilePhase: Instrumented parts of a frame
+ * Simulation phases run once per fixed step, so a frame that runs several
+ * steps reports their summed time
+ */
+enum class ProfilePhase : int
+{
+    Frame,           // Whole frame (input + update + draw + present)
+    Input,           // Game::handleInput
+    PlayerUpdate,    // Player::update
+    Scroll,          // Level::scroll
+    ResolveLanding,  // Level::resolveLanding
+    AwardScore,      // Level::awardScore
+    CheckCollision,  // Level::checkCollision
+    DrawSky,         // LevelRenderer::drawSky
+    DrawPlatforms,   // LevelRenderer::drawPlatforms
+    Hud,             // HUD text and end-of-run overlays
+    Count
+};
+
+/**
+ * PhaseStats: Timing summary of one phase over the recorded frames (milliseconds)
+ */
+struct PhaseStats
+{
+    double minMs = 0.0;
+    double avgMs = 0.0;
+    double p99Ms = 0.0;
+};
+
+/**
+ * Profiler: Scoped high-resolution timers with a per-frame history
+ *
+ * History:
+ * - Every phase's time is summed over the current frame
+ * - endFrame() pushes the sums into a ring buffer of the last kHistoryFrames
+ * - stats() reports min / avg / p99 per phase over that ring
+ *
+ * Chrome Trace:
+ * - Between startTrace() and stopTrace() every scope is also stored as a
+ *   complete event; stopTrace() writes them as Chrome trace JSON
+ *   (open in chrome://tracing or ui.perfetto.dev)
+ * - Event storage is reserved up front (reserveTrace, or startTrace's
+ *   own buffer); once full, further events are dropped
+ *
+ * Single-threaded: all scopes must run on the game thread.
+ */
+class Profiler
+{
+public:
+    static const int kHistoryFrames = 240;  // ~2-4 seconds of frames
+    static const int kPhaseCount = (int)ProfilePhase::Count;
+    static const size_t kTraceEvents = 1 << 18;  // Default trace capacity (~6 MB)
+
+    Profiler();
+
+    /**
+     * beginFrame / endFrame: Bracket one frame (also times ProfilePhase::Frame)
+     */
+    void beginFrame();
+    void endFrame();
+
+    /**
+     * add: Record one timed scope [startNs, endNs)
+     */
+    void add(ProfilePhase phase, int64_t startNs, int64_t endNs);
+
+    /**
+     * stats: min / avg / p99 of a phase over the recorded frames
+     */
+    PhaseStats stats(ProfilePhase phase) const;
+
+    /**
+     * frameCount: Frames currently held in the history ring
+     */
+    int frameCount() const { return historyCount; }
+
+    /**
+     * reserveTrace: Take trace storage for maxEvents scopes from arena
+     * (ahead of time, so starting a capture mid-game doesn't allocate;
+     * the arena must outlive every later capture)
+     */
+    void reserveTrace(Arena &arena, size_t maxEvents = kTraceEvents);
+
+    /**
+     * traceBytes: Arena bytes reserveTrace takes for maxEvents
+     */
+    static size_t traceBytes(size_t maxEvents = kTraceEvents);
+
+    /**
+     * startTrace: Begin capturing events (room for maxEvents scopes)
+     * Uses the reserved storage if it is big enough, else allocates its own
+     */
+    void startTrace(size_t maxEvents = kTraceEvents);
+
+    /**
+     * stopTrace: Stop capturing and write the events to path
+     * Returns false if no trace was running or the file could not be written
+     */
+    bool stopTrace(const char *path);
+
+    /**
+     * tracing: Is a trace capture running?
+     */
+    bool tracing() const { return traceActive; }
+
+    /**
+     * nowNs: Monotonic high-resolution clock in nanoseconds
+     */
+    static int64_t nowNs();
+
+    /**
+     * phaseName: Short display name of a phase ("scroll", "drawSky", ...)
+     */
+    static const char *phaseName(ProfilePhase phase);
+
+private:
+    /**
+     * TraceEvent: One captured scope (times relative to traceOrigin)
+     */
+    struct TraceEvent
+    {
+        int64_t startNs;
+        int64_t durationNs;
+        ProfilePhase phase;
+    };
+
+    // ===== Current Frame =====
+    int64_t frameStart = 0;                 // beginFrame time
+    int64_t current[kPhaseCount];           // Summed time per phase this frame
+
+    // ===== History Ring (frame-major: history[frame * kPhaseCount + phase]) =====
+    std::vector<int64_t> history;
+    int historyHead = 0;                    // Slot the next frame is written to
+    int historyCount = 0;                   // Valid frames (up to kHistoryFrames)
+
+    // ===== Trace Capture =====
+    TraceEvent *traceEvents = nullptr;      // Event storage (reserveTrace arena or ownedTrace)
+    size_t traceCount = 0;                  // Captured events
+    size_t traceCapacity = 0;               // Room in traceEvents
+    std::vector<TraceEvent> ownedTrace;     // Storage allocated by startTrace when none was reserved
+    int64_t traceOrigin = 0;                // startTrace time (trace timestamps start at 0)
+    bool traceActive = false;
+};
+
+/**
+ * profiler: The process-wide profiler instance
+ */
+Profiler &profiler();
+
+/**
+ * ProfileScope: RAII timer - adds the time between construction and
+ * destruction to a phase. Use through PROFILE_SCOPE.
+ */
+struct ProfileScope
+{
+    explicit ProfileScope(ProfilePhase phase) : phase(phase), startNs(Profiler::nowNs()) {}
+    ~ProfileScope() { profiler().add(phase, startNs, Profiler::nowNs()); }
+
+    ProfilePhase phase;
+    int64_t startNs;
+};
+
+/**
+ * PROFILE_SCOPE(Phase): Time the rest of the enclosing block as ProfilePhase::Phase
+ * (expands to nothing when ENABLE_PROFILER is 0)
+ */
+#if ENABLE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(phase) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(ProfilePhase::phase)
+#else
+#define PROFILE_SCOPE(phase) ((void)0)
+#endif
@@ -0,0 +1,41 @@
+#include "ProfilerOverlay.h"
+#include "raylib.h"
+
+/**
+ * drawProfilerOverlay: Panel layout
+ * - Header row with the number of frames the stats cover
+ * - Phase rows in ProfilePhase order (frame total first)
+ * - Values are formatted every frame - this is a debug view
+ */
+void drawProfilerOverlay(const Profiler &profiler, int x, int y)
+{
+    const int fontSize = 10;
+    const int rowHeight = 12;
+    const int width = 300;
+    const int height = (Profiler::kPhaseCount + 1) * rowHeight + 8;
+
+    DrawRectangle(x, y, width, height, Fade(BLACK, 0.6f));
+
+    int row = y + 4;
+    const int columnX[3] = {x + 150, x + 200, x + 250};  // min / avg / p99 (default font is proportional)
+    DrawText(TextFormat("ms over %d frames", profiler.frameCount()), x + 6, row, fontSize, WHITE);
+    DrawText("min", columnX[0], row, fontSize, WHITE);
+    DrawText("avg", columnX[1], row, fontSize, WHITE);
+    DrawText("p99", columnX[2], row, fontSize, WHITE);
+    if (profiler.tracing())
+    {
+        DrawText("TRACE", x + width - 40, y + height + 2, fontSize, RED);
+    }
+
+    for (int p = 0; p < Profiler::kPhaseCount; p++)
+    {
+        row += rowHeight;
+        ProfilePhase phase = (ProfilePhase)p;
+        PhaseStats s = profiler.stats(phase);
+        Color color = (p == 0) ? YELLOW : WHITE;  // Frame total stands out
+        DrawText(Profiler::phaseName(phase), x + 6, row, fontSize, color);
+        DrawText(TextFormat("%.3f", s.minMs), columnX[0], row, fontSize, color);
+        DrawText(TextFormat("%.3f", s.avgMs), columnX[1], row, fontSize, color);
+        DrawText(TextFormat("%.3f", s.p99Ms), columnX[2], row, fontSize, color);
+    }
+}
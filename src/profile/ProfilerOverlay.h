@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Profiler.h"
+
+/**
+ * drawProfilerOverlay: On-screen table of per-phase timings
+ * - One row per phase: min / avg / p99 in milliseconds over the history ring
+ * - Drawn with its top-left corner at (x, y) on a translucent panel
+ * - Shows "TRACE" while a Chrome trace capture is running
+ */
+void drawProfilerOverlay(const Profiler &profiler, int x, int y);
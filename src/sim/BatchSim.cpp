@@ -0,0 +1,414 @@
+#include "BatchSim.h"
+#include "Tuning.h"
+#include "../level/Level.h"
+#include <algorithm>
+
+static const float kFreeSlotX = 1.0e30f;  // Free ring slot: never under, touching or passed by the ball
+
+/**
+ * worldX: Screen X to world X for a camera (same conversion as Level::worldX)
+ */
+static float worldX(double camera, float screenX)
+{
+    return (float)(camera + (double)screenX);
+}
+
+/**
+ * BatchSim constructor: Size every per-game and per-platform array
+ * Game count is padded up to whole blocks; padding games start finished
+ */
+BatchSim::BatchSim(int games, const GameConfig &cfg)
+    : config(cfg), gameCount(games), blockCount((games + kLanes - 1) / kLanes),
+      capacity(Level::ringCapacity(cfg)), specialized(ProductionTuning::matches(cfg))
+{
+    size_t n = (size_t)blockCount * kLanes;
+    size_t np = n * (size_t)capacity;
+
+    x.resize(n);
+    y.resize(n);
+    prevY.resize(n);
+    vy.resize(n);
+    jumpHoldTimer.resize(n);
+    jumpsRemaining.resize(n);
+    isJumping.resize(n);
+    grounded.resize(n);
+    hasLeftGround.resize(n);
+
+    score.resize(n);
+    gameOver.resize(n, 1);  // Padding lanes stay finished forever
+    levelComplete.resize(n);
+    frame.resize(n);
+    generator.resize(n);
+    head.resize(n);
+    count.resize(n);
+    scoreCursor.resize(n);
+    cameraX.resize(n);
+
+    platX.resize(np, kFreeSlotX);  // Padding lanes only ever hold free slots
+    platY.resize(np);
+    platW.resize(np);
+}
+
+/**
+ * reset: Restart all games with consecutive seeds
+ */
+void BatchSim::reset(uint64_t baseSeed)
+{
+    for (int g = 0; g < gameCount; g++)
+    {
+        resetGame(g, baseSeed + (uint64_t)g);
+    }
+}
+
+/**
+ * resetGame: Same starting state as Player::reset + Level::generate
+ * Platforms come from the same generator and fill rule as Level::generate,
+ * so game g sees the same platforms as a Level seeded with `seed`
+ */
+void BatchSim::resetGame(int g, uint64_t seed)
+{
+    const GameConfig &cfg = config;
+
+    // Player::reset
+    x[g] = cfg.screenWidth * 0.25f;
+    y[g] = toScalar(cfg.groundY);
+    prevY[g] = y[g];
+    vy[g] = PhysicsScalar();
+    jumpHoldTimer[g] = PhysicsScalar();
+    jumpsRemaining[g] = 2;
+    isJumping[g] = 0;
+    grounded[g] = 1;
+    hasLeftGround[g] = 0;
+
+    score[g] = 0;
+    gameOver[g] = 0;
+    levelComplete[g] = 0;
+    frame[g] = 0;
+    head[g] = 0;
+    scoreCursor[g] = 0;
+    cameraX[g] = 0.0;
+
+    count[g] = 0;
+
+    // Level::generate (platform stream only - clouds don't affect gameplay)
+    for (int i = 0; i < capacity; i++)
+    {
+        platX[platformIndex(g, i)] = kFreeSlotX;
+        platW[platformIndex(g, i)] = 0.0f;
+    }
+    GameConfig levelCfg = cfg;
+    levelCfg.seed = seed;
+    generator[g].reset(levelCfg);
+    fillAhead(RuntimeTuning(cfg), g);
+}
+
+/**
+ * fillAhead: Append platforms to game g's ring up to generateAhead
+ * (same stop rules and generator calls as Level::fillAhead)
+ */
+template <typename Tuning>
+void BatchSim::fillAhead(Tuning tuning, int g)
+{
+    const int capacity = tuning.ringCapacity;  // Shadows the member: constant for static tunings
+    float limitX = worldX(cameraX[g], (float)tuning.screenWidth + tuning.generateAhead);
+    int h = head[g];
+    int n = count[g];
+    float *px = &platX[platformIndex(g, 0)];  // Game g's slots are kLanes apart
+    float *py = &platY[platformIndex(g, 0)];
+    float *pw = &platW[platformIndex(g, 0)];
+    float lastX = (n > 0) ? px[(size_t)((h + n - 1) % capacity) * kLanes] : PlatformGenerator::startX(tuning);
+    PlatformGenerator &gen = generator[g];
+    while (n < capacity && lastX < limitX && !gen.exhausted(tuning))
+    {
+        size_t k = (size_t)((h + n) % capacity) * kLanes;
+        gen.next(lastX, tuning, px[k], py[k], pw[k]);
+        lastX = px[k];
+        n++;
+    }
+    count[g] = n;
+}
+
+/**
+ * step: One lockstep update of every unfinished game, block by block
+ * (through the compile-time production kernel when config allows it)
+ */
+void BatchSim::step(const FrameInput *inputs, float dt)
+{
+    if (specialized)
+    {
+        for (int b = 0; b < blockCount; b++)
+        {
+            stepBlock(ProductionTuning(), b, inputs, dt);
+        }
+        return;
+    }
+    RuntimeTuning tuning(config);
+    for (int b = 0; b < blockCount; b++)
+    {
+        stepBlock(tuning, b, inputs, dt);
+    }
+}
+
+/**
+ * stepBlock: One update of the kLanes games in block b
+ *
+ * Same order as Simulation::step, but each phase runs across all lanes
+ * before the next phase starts:
+ * 1. Jump input + Player::update physics (per lane)
+ * 2. Level::scroll: move the camera (rebasing like Level), drop off-screen
+ *    platforms from the ring head, stream new ones in ahead of the viewport
+ * 3. Level::resolveLanding (best platform top)
+ * 4. Apply landing / ground fallback, Player::setGrounded, ground death,
+ *    Level::awardScore (score cursor per lane)
+ * 5. Level::checkCollision (platform side/bottom = death), win condition
+ *
+ * Finished lanes are frozen: their cameras stop and their results are masked.
+ * Player state is PhysicsScalar like Player; the lane loops see it as float.
+ * Per-platform loops use branch-free selects so they vectorize over lanes.
+ * Settings come from `tuning` (see BatchSim.h - Specialization).
+ */
+template <typename Tuning>
+void BatchSim::stepBlock(Tuning tuning, int b, const FrameInput *inputs, float dt)
+{
+    const int capacity = tuning.ringCapacity;  // Shadows the member: constant for static tunings
+    const int base = b * kLanes;
+    const float radius = tuning.radius;
+    const float radiusSq = radius * radius;
+    const float rh = tuning.platformHeight;
+    const float groundY = tuning.groundY;
+    const double scrollStep = (double)(tuning.scrollSpeed * dt);
+
+    float *px = &platX[(size_t)b * capacity * kLanes];
+    float *py = &platY[(size_t)b * capacity * kLanes];
+    float *pw = &platW[(size_t)b * capacity * kLanes];
+
+    // Player::update constants in the physics number type (same values it computes)
+    const PhysicsScalar step = toScalar(dt);
+    const PhysicsScalar jumpVelocity = toScalar(tuning.jumpVelocity);
+    const PhysicsScalar gravityStep = toScalar(tuning.gravity) * step;
+    const PhysicsScalar jumpHoldStep = toScalar(tuning.jumpHoldAccel) * step;
+    const PhysicsScalar maxJumpHold = toScalar(tuning.maxJumpHold);
+
+    int32_t active[kLanes];
+    float bx[kLanes];
+    float by[kLanes];
+    float byPrev[kLanes];
+    int32_t falling[kLanes];
+
+    // ----- 1. Input + player physics -----
+    for (int l = 0; l < kLanes; l++)
+    {
+        int g = base + l;
+        active[l] = !(gameOver[g] || levelComplete[g]);
+        if (active[l])
+        {
+            // Player::startJump
+            if (inputs[g].jumpPressed && jumpsRemaining[g] > 0)
+            {
+                vy[g] = jumpVelocity;
+                isJumping[g] = 1;
+                grounded[g] = 0;
+                hasLeftGround[g] = 1;
+                jumpsRemaining[g]--;
+                jumpHoldTimer[g] = PhysicsScalar();
+            }
+
+            // Player::update
+            prevY[g] = y[g];
+            vy[g] += gravityStep;
+            if (inputs[g].jumpHeld && isJumping[g] && jumpHoldTimer[g] < maxJumpHold)
+            {
+                vy[g] += jumpHoldStep;
+                jumpHoldTimer[g] += step;
+            }
+            y[g] += vy[g] * step;
+        }
+        by[l] = toFloat(y[g]);
+        byPrev[l] = toFloat(prevY[g]);
+        falling[l] = toFloat(vy[g]) >= 0.0f;
+    }
+
+    // ----- 2. Scroll: camera, then drop / stream platforms (as Level::scroll) -----
+    for (int l = 0; l < kLanes; l++)
+    {
+        int g = base + l;
+        if (!active[l])
+        {
+            bx[l] = worldX(cameraX[g], x[g]);  // Frozen camera (results are masked)
+            continue;
+        }
+        cameraX[g] += scrollStep;
+        if (cameraX[g] >= Level::kRebaseX)
+        {
+            // Level::rebase (free slots stay at the sentinel)
+            for (int i = 0; i < capacity; i++)
+            {
+                px[(size_t)i * kLanes + l] -= (float)Level::kRebaseX;
+            }
+            cameraX[g] -= Level::kRebaseX;
+        }
+        bx[l] = worldX(cameraX[g], x[g]);
+
+        float dropX = worldX(cameraX[g], -60.0f);
+        int h = head[g];
+        while (count[g] > 0)
+        {
+            size_t k = (size_t)h * kLanes + l;
+            if (px[k] + pw[k] >= dropX)
+            {
+                break;
+            }
+            px[k] = kFreeSlotX;
+            pw[k] = 0.0f;
+            h = (h + 1 == capacity) ? 0 : h + 1;
+            count[g]--;
+            scoreCursor[g] = std::max(0, scoreCursor[g] - 1);
+        }
+        head[g] = h;
+        fillAhead(tuning, g);
+    }
+
+    // ----- 3. Landing (highest platform top crossed) -----
+    float targetY[kLanes];
+    int32_t landed[kLanes];
+    for (int l = 0; l < kLanes; l++)
+    {
+        targetY[l] = groundY;
+        landed[l] = 0;
+    }
+    forEachSlot(tuning, [&](int i)
+    {
+        const float *rx = px + (size_t)i * kLanes;
+        const float *ry = py + (size_t)i * kLanes;
+        const float *rw = pw + (size_t)i * kLanes;
+        for (int l = 0; l < kLanes; l++)
+        {
+            float top = ry[l];
+            float right = rx[l] + rw[l];
+            int32_t crossed = falling[l] &
+                              (by[l] + radius >= top) &
+                              (byPrev[l] + radius <= top) &
+                              (rx[l] <= bx[l]) &
+                              (right >= bx[l]);
+            int32_t better = crossed & (top < targetY[l]);
+            targetY[l] = better ? top : targetY[l];
+            landed[l] |= better;
+        }
+    });
+
+    // ----- 4. Apply landing / ground, grounded state, ground death -----
+    for (int l = 0; l < kLanes; l++)
+    {
+        int g = base + l;
+        if (!active[l])
+        {
+            continue;
+        }
+
+        bool landedNow = landed[l] != 0;
+        bool landedOnGround = false;
+        if (landedNow)
+        {
+            y[g] = toScalar(targetY[l] - radius);
+            vy[g] = PhysicsScalar();
+        }
+        else if (by[l] > groundY)
+        {
+            y[g] = toScalar(groundY);
+            vy[g] = PhysicsScalar();
+            landedNow = true;
+            landedOnGround = true;
+        }
+
+        // Player::setGrounded
+        grounded[g] = landedNow ? 1 : 0;
+        if (landedNow)
+        {
+            isJumping[g] = 0;
+            jumpsRemaining[g] = 2;
+        }
+
+        if (landedOnGround && hasLeftGround[g])
+        {
+            gameOver[g] = 1;
+        }
+
+        // Level::awardScore - advance the cursor over passed platforms
+        float passedX = bx[l] - radius;
+        while (scoreCursor[g] < count[g])
+        {
+            int c = head[g] + scoreCursor[g];
+            size_t k = (size_t)(c >= capacity ? c - capacity : c) * kLanes + l;
+            if (px[k] + pw[k] >= passedX)
+            {
+                break;
+            }
+            scoreCursor[g]++;
+            score[g]++;
+        }
+        by[l] = toFloat(y[g]);
+    }
+
+    // ----- 5. Side/bottom collision (circle vs platform rectangle) -----
+    int32_t hit[kLanes];
+    for (int l = 0; l < kLanes; l++) hit[l] = 0;
+    forEachSlot(tuning, [&](int i)
+    {
+        const float *rx = px + (size_t)i * kLanes;
+        const float *ry = py + (size_t)i * kLanes;
+        const float *rw = pw + (size_t)i * kLanes;
+        for (int l = 0; l < kLanes; l++)
+        {
+            // Clamp as two selects (same result: widths and rh are never negative)
+            float right = rx[l] + rw[l];
+            float bottom = ry[l] + rh;
+            float closestX = (bx[l] < rx[l]) ? rx[l] : bx[l];
+            closestX = (closestX > right) ? right : closestX;
+            float closestY = (by[l] < ry[l]) ? ry[l] : by[l];
+            closestY = (closestY > bottom) ? bottom : closestY;
+            float dx = bx[l] - closestX;
+            float dy = by[l] - closestY;
+            hit[l] |= (dx * dx + dy * dy < radiusSq);
+        }
+    });
+
+    // Win / death flags and step counters
+    for (int l = 0; l < kLanes; l++)
+    {
+        int g = base + l;
+        if (!active[l])
+        {
+            continue;
+        }
+        if (!tuning.endless && score[g] >= tuning.totalPlatforms)
+        {
+            levelComplete[g] = 1;
+        }
+        if (hit[l])
+        {
+            gameOver[g] = 1;
+        }
+        frame[g]++;
+    }
+}
+
+/**
+ * isFinished: Game g ended by death or by passing all platforms
+ */
+bool BatchSim::isFinished(int g) const
+{
+    return gameOver[g] || levelComplete[g];
+}
+
+/**
+ * finishedCount: Count ended games (linear scan over flags)
+ */
+int BatchSim::finishedCount() const
+{
+    int count = 0;
+    for (int g = 0; g < gameCount; g++)
+    {
+        count += isFinished(g) ? 1 : 0;
+    }
+    return count;
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "../config/Config.h"
+#include "Fixed.h"
+#include "Input.h"
+#include "../level/PlatformGenerator.h"
+
+/**
+ * BatchSim: Many independent games advanced in lockstep (Structure of Arrays)
+ *
+ * Runs the same rules as Simulation::step (Player::update physics,
+ * Level::scroll streaming, resolveLanding, awardScore, checkCollision)
+ * for gameCount games at once. Every per-game value lives in its own
+ * array indexed by game. Games are grouped into blocks of kLanes, and
+ * within a block platforms are stored platform-major:
+ *
+ *     platX[(block * capacity + i) * kLanes + lane] = x of ring slot i
+ *
+ * so the inner loops run over the kLanes games of a block with unit
+ * stride (one SIMD register wide) and a block's platforms stay in cache
+ * while every phase of the step runs over them. Given the same seed and
+ * inputs, game g finishes with exactly the same score and outcome as a
+ * Simulation.
+ *
+ * Each game has its own platform ring of Level::ringCapacity slots
+ * (head/count per game, filled from its own PlatformGenerator). Free
+ * slots hold an off-world sentinel so the per-platform loops can run
+ * over every slot without checking which ones are live. Platforms are in
+ * world X like Level's; each game scrolls its own cameraX.
+ *
+ * Render-only state (rotation, clouds, vertical camera) is not simulated.
+ * Only the discrete per-step tests are: config.continuousCollision is
+ * ignored (use Simulation for swept, coarse-step runs).
+ *
+ * Specialization: the step kernel is a template over a tuning
+ * (sim/Tuning.h). When config plays like kProductionConfig, steps run
+ * the ProductionTuning instance - every setting and the ring capacity
+ * are compile-time constants, so the per-platform loops are fully
+ * unrolled; any other config runs the RuntimeTuning instance. Both give
+ * identical results for the production settings.
+ */
+class BatchSim
+{
+public:
+    /**
+     * Constructor: Allocate arrays for gameCount games
+     * Call reset() before the first step
+     */
+    BatchSim(int gameCount, const GameConfig &cfg);
+
+    /**
+     * reset: Restart every game - game g uses level seed (baseSeed + g)
+     */
+    void reset(uint64_t baseSeed);
+
+    /**
+     * resetGame: Restart a single game with its own seed
+     * Lets callers keep all lanes busy by recycling finished games
+     */
+    void resetGame(int g, uint64_t seed);
+
+    /**
+     * step: Advance every unfinished game by dt
+     * inputs must hold one FrameInput per game (indexed by game)
+     */
+    void step(const FrameInput *inputs, float dt);
+
+    /**
+     * isFinished: Check if game g has ended (game over or level complete)
+     */
+    bool isFinished(int g) const;
+
+    /**
+     * finishedCount: Number of games that have ended
+     */
+    int finishedCount() const;
+
+    /**
+     * platformIndex: Array slot of ring slot i in game g
+     */
+    size_t platformIndex(int g, int i) const
+    {
+        return ((size_t)(g / kLanes) * capacity + i) * kLanes + (g % kLanes);
+    }
+
+    static const int kLanes = 8;  // Games per block (8 floats = one AVX register)
+
+    // ===== Shared Settings =====
+    GameConfig config;   // Same configuration for every game in the batch
+    int gameCount;       // Number of games (lanes)
+    int blockCount;      // Blocks of kLanes games (last block padded with finished games)
+    int capacity;        // Ring slots per game (= Level::ringCapacity)
+    bool specialized;    // Steps run the ProductionTuning kernel (set when config matches it; clear to force the runtime one)
+
+    // ===== Per-Game Player State (indexed by game, padded to blockCount * kLanes) =====
+    std::vector<float> x;                 // Horizontal position (fixed per game)
+    std::vector<PhysicsScalar> y;         // Vertical position
+    std::vector<PhysicsScalar> prevY;     // Vertical position before this step
+    std::vector<PhysicsScalar> vy;        // Vertical velocity (negative = up)
+    std::vector<PhysicsScalar> jumpHoldTimer;  // Time jump has been held
+    std::vector<int> jumpsRemaining;      // Jump charges (0-2)
+    std::vector<uint8_t> isJumping;       // Currently in jump motion
+    std::vector<uint8_t> grounded;        // Currently on a platform or ground
+    std::vector<uint8_t> hasLeftGround;   // Has jumped at least once
+
+    // ===== Per-Game Run State (indexed by game) =====
+    std::vector<int> score;               // Platforms passed
+    std::vector<uint8_t> gameOver;        // Death state
+    std::vector<uint8_t> levelComplete;   // Win state
+    std::vector<long long> frame;         // Steps simulated since reset
+    std::vector<PlatformGenerator> generator;  // Platform stream per game
+    std::vector<int> head;                // Ring index of the leftmost platform (as Level::head)
+    std::vector<int> count;               // Live platforms in the ring (as Level::count)
+    std::vector<int> scoreCursor;         // Ring offset of the first unscored platform (as Level::scoreCursor)
+    std::vector<double> cameraX;          // World X at the left screen edge (as Level::cameraX)
+
+    // ===== Platforms (blocked platform-major, see platformIndex) =====
+    std::vector<float> platX;             // Left edge X
+    std::vector<float> platY;             // Top surface Y
+    std::vector<float> platW;             // Width
+
+private:
+    /**
+     * fillAhead: Level::fillAhead for the ring of game g
+     */
+    template <typename Tuning>
+    void fillAhead(Tuning tuning, int g);
+
+    /**
+     * stepBlock: Run every phase of step() for the kLanes games of block b
+     */
+    template <typename Tuning>
+    void stepBlock(Tuning tuning, int b, const FrameInput *inputs, float dt);
+};
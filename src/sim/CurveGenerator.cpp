@@ -0,0 +1,200 @@
+#include "CurveGenerator.h"
+#include "Replay.h"
+#include "../level/PlatformGenerator.h"
+#include "../parallel/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+// ===== DifficultyCurve =====
+
+DifficultyCurve DifficultyCurve::ramp(float from, float to)
+{
+    DifficultyCurve curve;
+    curve.add(0.0f, from);
+    curve.add(1.0f, to);
+    return curve;
+}
+
+bool DifficultyCurve::add(float atProgress, float value)
+{
+    if (points >= kMaxPoints || (points > 0 && atProgress <= progress[points - 1]))
+    {
+        return false;
+    }
+    progress[points] = atProgress;
+    difficulty[points] = value;
+    points++;
+    return true;
+}
+
+/**
+ * at: Linear between the two points around the progress
+ */
+float DifficultyCurve::at(float atProgress) const
+{
+    if (points == 0)
+    {
+        return 0.0f;
+    }
+    if (atProgress <= progress[0])
+    {
+        return difficulty[0];
+    }
+    for (int i = 1; i < points; i++)
+    {
+        if (atProgress <= progress[i])
+        {
+            float f = (atProgress - progress[i - 1]) / (progress[i] - progress[i - 1]);
+            return difficulty[i - 1] + (difficulty[i] - difficulty[i - 1]) * f;
+        }
+    }
+    return difficulty[points - 1];
+}
+
+// ===== CurveGenerator =====
+
+CurveGenerator::CurveGenerator(ThreadPool &pool) : pool(pool) {}
+
+void CurveGenerator::prepare(const GameConfig &cfg)
+{
+    uint64_t hash = configHash(cfg);
+    if (!prepared || hash != tuning)
+    {
+        envelope.build(cfg);
+        tuning = hash;
+        prepared = true;
+    }
+    model.build(cfg, pool);
+}
+
+Transition CurveGenerator::transition(const std::vector<Platform> &platforms, size_t i)
+{
+    const Platform &from = platforms[i - 1];
+    const Platform &to = platforms[i];
+    Transition t;
+    t.prevWidth = from.width;
+    t.gap = to.x - from.x;
+    t.rise = from.yTop - to.yTop;
+    t.width = to.width;
+    return t;
+}
+
+void CurveGenerator::generate(const GameConfig &cfg, const DifficultyCurve &curve, CurvedLevel &out)
+{
+    prepare(cfg);
+    generatePrepared(cfg, curve, out);
+}
+
+/**
+ * generatePrepared: Pick platforms in order
+ *
+ * Candidates are drawn from one stream: each starts from the walk state
+ * after the previous pick (height, direction) but takes the next random
+ * numbers, and the winner's walk state is kept. Platform 0 is jumped to
+ * from the ground and always takes the first draw.
+ */
+void CurveGenerator::generatePrepared(const GameConfig &cfg, const DifficultyCurve &curve, CurvedLevel &out) const
+{
+    size_t n = (size_t)std::max(0, cfg.totalPlatforms);
+    out.platforms.resize(n);
+    out.target.assign(n, 0.0f);
+    out.predicted.assign(n, 0.0f);
+    out.measured.assign(n, 0.0f);
+    out.rejected = 0;
+    out.fallbacks = 0;
+
+    PlatformGenerator generator;
+    generator.reset(cfg);
+    float previousX = 0.0f;  // Relative to startX
+    for (size_t i = 0; i < n; i++)
+    {
+        float target = curve.at((n > 1) ? (float)i / (float)(n - 1) : 0.0f);
+        PlatformGenerator chosen = generator;
+        Platform best = {0.0f, 0.0f, 0.0f};
+        float bestError = INFINITY;
+        float bestDifficulty = 0.0f;
+        for (int k = 0; k < kCandidates; k++)
+        {
+            PlatformGenerator candidate = generator;
+            Platform p;
+            candidate.next(previousX, cfg, p.x, p.yTop, p.width);
+            generator.rng = candidate.rng;  // Next candidate takes the next numbers
+            if (i == 0)
+            {
+                chosen = candidate;
+                best = p;
+                bestError = 0.0f;
+                break;
+            }
+
+            const Platform &from = out.platforms[i - 1];
+            Transition t = {from.width, p.x - from.x, from.yTop - p.yTop, p.width};
+            if (!envelope.reachable(t.prevWidth, t.gap, t.rise, t.width))
+            {
+                out.rejected++;
+                continue;
+            }
+            float difficulty = model.difficulty(t);
+            float error = std::fabs(difficulty - target);
+            if (error < bestError)
+            {
+                chosen = candidate;
+                best = p;
+                bestError = error;
+                bestDifficulty = difficulty;
+            }
+        }
+
+        if (bestError == INFINITY)
+        {
+            // Nothing reachable: closest gap, widest platform, same height
+            best.x = previousX + cfg.minGap;
+            best.yTop = generator.yTop;
+            best.width = cfg.maxPlatformWidth;
+            chosen = generator;
+            chosen.produced++;
+            out.fallbacks++;
+            if (i > 0)
+            {
+                const Platform &from = out.platforms[i - 1];
+                bestDifficulty = model.difficulty({from.width, best.x - from.x, 0.0f, best.width});
+            }
+        }
+        Rng stream = generator.rng;
+        generator = chosen;
+        generator.rng = stream;
+
+        out.platforms[i] = best;
+        out.target[i] = target;
+        out.predicted[i] = bestDifficulty;
+        previousX = best.x;
+    }
+}
+
+/**
+ * resetRun: A stage run with the config's own length (curve levels are
+ * never endless)
+ */
+void CurveGenerator::resetRun(Simulation &sim, CurvedLevel &scratch) const
+{
+    generatePrepared(sim.config, DifficultyCurve::ramp(sim.config.curveFrom, sim.config.curveTo), scratch);
+    sim.reset(sim.level.packStage(scratch.platforms.data(), (int)scratch.platforms.size()));
+}
+
+/**
+ * measure: One parallel sweep over the level's jumps; each writes only
+ * its own entry
+ */
+void CurveGenerator::measure(const GameConfig &cfg, CurvedLevel &level)
+{
+    size_t n = level.platforms.size();
+    level.measured.assign(n, 0.0f);
+    pool.parallelFor((int64_t)n, kMeasureGrain, [&](int64_t begin, int64_t end, int)
+    {
+        for (int64_t i = std::max<int64_t>(begin, 1); i < end; i++)
+        {
+            level.measured[(size_t)i] = DifficultyModel::measure(cfg, transition(level.platforms, (size_t)i),
+                                                                 cfg.seed ^ ((uint64_t)i * 0x9E3779B97F4A7C15ULL));
+        }
+    });
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "../config/Config.h"
+#include "../level/JumpEnvelope.h"
+#include "../level/Level.h"
+#include "DifficultyModel.h"
+#include "Simulation.h"
+
+class ThreadPool;
+
+/**
+ * DifficultyCurve: Target difficulty over a level's length
+ * Piecewise linear through up to kMaxPoints (progress, difficulty) points,
+ * progress 0 = first platform, 1 = last; flat before the first point and
+ * after the last
+ */
+struct DifficultyCurve
+{
+    static const int kMaxPoints = 8;
+
+    int points = 0;
+    float progress[kMaxPoints];
+    float difficulty[kMaxPoints];
+
+    /**
+     * ramp: Straight line from `from` at the start to `to` at the end
+     */
+    static DifficultyCurve ramp(float from, float to);
+
+    /**
+     * add: Append a point (progress must increase); false if full
+     */
+    bool add(float atProgress, float value);
+
+    /**
+     * at: Target difficulty at a progress (0..1)
+     */
+    float at(float atProgress) const;
+};
+
+/**
+ * CurvedLevel: A generated level and how well it follows its curve
+ * Platform 0 is reached from the ground, so its entries are 0
+ */
+struct CurvedLevel
+{
+    std::vector<Platform> platforms;  // x measured from PlatformGenerator::startX (LevelPack::write input)
+    std::vector<float> target;        // Curve value per platform
+    std::vector<float> predicted;     // Table difficulty of the jump onto each platform
+    std::vector<float> measured;      // Monte-Carlo difficulty of that jump (CurveGenerator::measure)
+    int rejected = 0;                 // Candidates the jump envelope ruled out
+    int fallbacks = 0;                // Platforms with no reachable candidate (closest flat step used)
+
+    /**
+     * reserve: Room for levels of up to n platforms (generating one then
+     * allocates nothing)
+     */
+    void reserve(size_t n)
+    {
+        platforms.reserve(n);
+        target.reserve(n);
+        predicted.reserve(n);
+        measured.reserve(n);
+    }
+};
+
+/**
+ * CurveGenerator: Levels whose difficulty follows a DifficultyCurve
+ *
+ * Stage 1, reachability (JumpEnvelope): every platform is picked from
+ * kCandidates draws of the usual PlatformGenerator stream (same ranges,
+ * same up/down walk), and candidates no input can land on are dropped.
+ * If none is left, a flat step at minGap / maxPlatformWidth is used.
+ *
+ * Stage 2, difficulty (DifficultyModel): of the reachable candidates the
+ * one whose table difficulty is closest to the curve's target wins.
+ *
+ * Cost: the Monte-Carlo sweep behind the table runs once per tuning
+ * (prepare - a few hundred ms of core time, spread over the pool); a
+ * level is then kCandidates envelope tests and table lookups per
+ * platform, a few hundred microseconds for 200 platforms on one core -
+ * cheap enough for the LevelPregenerator's producer between two runs.
+ * measure() plays every chosen jump exactly in one parallel sweep, for
+ * tools that check a level against its curve (headless curve).
+ *
+ * The game prepares once at session start and the LevelPregenerator's
+ * producer generates from there (GameConfig::curveLevels).
+ *
+ * Same cfg.seed and curve give the same level on any thread count.
+ * Calls come from one thread at a time (they share the pool), except
+ * generatePrepared, which only reads what prepare() built.
+ */
+class CurveGenerator
+{
+public:
+    static const int kCandidates = 8;     // Draws per platform
+    static const int kMeasureGrain = 8;   // Jumps per measuring job
+
+    explicit CurveGenerator(ThreadPool &pool);
+
+    /**
+     * prepare: Build the envelope and the difficulty table for cfg's tuning
+     * (no-op if they are already built for it; generate() calls it too)
+     */
+    void prepare(const GameConfig &cfg);
+
+    /**
+     * generate: totalPlatforms platforms from cfg.seed following curve
+     */
+    void generate(const GameConfig &cfg, const DifficultyCurve &curve, CurvedLevel &out);
+
+    /**
+     * generatePrepared: generate() for a tuning prepare() already built
+     * (read-only: any number of threads may call it at once)
+     */
+    void generatePrepared(const GameConfig &cfg, const DifficultyCurve &curve, CurvedLevel &out) const;
+
+    /**
+     * resetRun: Reset sim on the curve level of its config (seed, ramp
+     * curveFrom -> curveTo) - generated into scratch, then packed into
+     * sim's level as its own stage (Level::packStage)
+     * The reset the game, the LevelPregenerator and replays all run for
+     * curveLevels; read-only like generatePrepared
+     */
+    void resetRun(Simulation &sim, CurvedLevel &scratch) const;
+
+    /**
+     * measure: Fill level.measured by playing every jump on the pool
+     * (jump i's plans come from stream cfg.seed and i)
+     */
+    void measure(const GameConfig &cfg, CurvedLevel &level);
+
+    /**
+     * transition: The jump from platform i - 1 onto platform i
+     */
+    static Transition transition(const std::vector<Platform> &platforms, size_t i);
+
+    const JumpEnvelope &jumpEnvelope() const { return envelope; }
+    const DifficultyModel &difficultyModel() const { return model; }
+
+private:
+    ThreadPool &pool;
+    JumpEnvelope envelope;
+    DifficultyModel model;
+    uint64_t tuning = 0;      // configHash the envelope was built for
+    bool prepared = false;
+};
@@ -0,0 +1,295 @@
+#include "DifficultyModel.h"
+#include "Replay.h"
+#include "Rng.h"
+#include "../level/PlatformGenerator.h"
+#include "../parallel/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Plan: One random jump plan (steps from the start; press2 = -1: single jump)
+ */
+struct Plan
+{
+    int32_t press1, release1, press2, release2;
+};
+
+/**
+ * playLanes: Play kLanes plans on a transition, count the landings
+ *
+ * Frame: the first platform's left edge is X 0 and its top Y 0; the ball
+ * starts there at rest, with both jumps and the ground already lethal
+ * (it got here by jumping). Every lane moves right by the same
+ * stepDistance per step, so the platform tests share the "under" masks.
+ * A lane ends when it lands on the next platform (won), dies, sinks
+ * below the next top with no press left, or its center passes the next
+ * right edge (no platform left to land on).
+ *
+ * Until the first press (or the edge) every lane just rests on the first
+ * platform, so stepping starts there - the state is the same as after
+ * resting all those steps. measure() sorts plans by first press, so the
+ * lanes of a block press close together.
+ */
+static int playLanes(const GameConfig &cfg, const Transition &t, const Plan *plans)
+{
+    const int kLanes = DifficultyModel::kLanes;
+    const float dt = cfg.fixedTimestep;
+    const float stepDistance = cfg.scrollSpeed * dt;
+    const float radius = cfg.radius;
+    const float radiusSq = radius * radius;
+    const float rh = cfg.platformHeight;
+    const float gravityStep = cfg.gravity * dt;
+    const float jumpHoldStep = cfg.jumpHoldAccel * dt;
+    const float jumpVelocity = cfg.jumpVelocity;
+    const float maxJumpHold = cfg.maxJumpHold;
+
+    // The two platforms (X, top, right) and the ground just below the lower one
+    const float left[2] = {0.0f, t.gap};
+    const float right[2] = {t.prevWidth, t.gap + t.width};
+    const float top[2] = {0.0f, -t.rise};
+    const float groundY = std::max(top[0], top[1]) + (cfg.groundY - PlatformGenerator::lowestTop(cfg));
+
+    int32_t press1[kLanes], release1[kLanes], press2[kLanes], release2[kLanes], lastPress[kLanes];
+    int firstStep = (int)(right[0] / stepDistance);  // Last step still resting on the first platform
+    for (int l = 0; l < kLanes; l++)
+    {
+        press1[l] = plans[l].press1;
+        release1[l] = plans[l].release1;
+        press2[l] = plans[l].press2;
+        release2[l] = plans[l].release2;
+        lastPress[l] = std::max(press1[l], press2[l]);
+        firstStep = std::min(firstStep, (int)press1[l]);
+    }
+
+    float y[kLanes], vy[kLanes], holdTimer[kLanes];
+    int32_t jumps[kLanes], jumping[kLanes], done[kLanes], won[kLanes];
+    for (int l = 0; l < kLanes; l++)
+    {
+        y[l] = -radius;
+        vy[l] = 0.0f;
+        holdTimer[l] = 0.0f;
+        jumps[l] = 2;
+        jumping[l] = 0;
+        done[l] = 0;
+        won[l] = 0;
+    }
+
+    const int lastStep = (int)(right[1] / stepDistance) + 2;
+    for (int s = std::max(0, firstStep); s < lastStep; s++)
+    {
+        // ----- Input + Player::startJump / Player::update -----
+        float prevY[kLanes];
+        int32_t falling[kLanes];
+        for (int l = 0; l < kLanes; l++)
+        {
+            int32_t jump = ((s == press1[l]) | (s == press2[l])) & (jumps[l] > 0);
+            vy[l] = jump ? jumpVelocity : vy[l];
+            jumping[l] |= jump;
+            jumps[l] -= jump;
+            holdTimer[l] = jump ? 0.0f : holdTimer[l];
+
+            int32_t held = ((s >= press1[l]) & (s < release1[l])) | ((s >= press2[l]) & (s < release2[l]));
+            int32_t boost = held & jumping[l] & (holdTimer[l] < maxJumpHold);
+            prevY[l] = y[l];
+            vy[l] += gravityStep;
+            vy[l] += boost ? jumpHoldStep : 0.0f;
+            holdTimer[l] += boost ? dt : 0.0f;
+            y[l] += vy[l] * dt;
+            falling[l] = vy[l] >= 0.0f;
+        }
+
+        // ----- Level::scroll: the ball's X in this frame -----
+        const float bx = (float)(s + 1) * stepDistance;
+
+        // ----- Level::resolveLanding (highest top crossed), ground, setGrounded -----
+        int32_t dead[kLanes], landedNext[kLanes];
+        const int32_t under0 = (left[0] <= bx) & (right[0] >= bx);
+        const int32_t under1 = (left[1] <= bx) & (right[1] >= bx);
+        const int32_t nextHigher = top[1] < top[0];
+        const float top0 = top[0], top1 = top[1];
+        for (int l = 0; l < kLanes; l++)
+        {
+            int32_t cross0 = under0 & falling[l] & (y[l] + radius >= top0) & (prevY[l] + radius <= top0);
+            int32_t cross1 = under1 & falling[l] & (y[l] + radius >= top1) & (prevY[l] + radius <= top1);
+            int32_t next = cross1 & ((cross0 ^ 1) | nextHigher);
+            int32_t onPlatform = cross0 | cross1;
+            int32_t onGround = (onPlatform ^ 1) & (y[l] > groundY);
+            int32_t stops = onPlatform | onGround;
+            float surfaceY = (next ? top1 : top0) - radius;
+            float snapY = onPlatform ? surfaceY : groundY;
+            y[l] = stops ? snapY : y[l];
+            vy[l] = stops ? 0.0f : vy[l];
+            jumping[l] &= onPlatform ^ 1;                // Arithmetic, not selects: mixing int and
+            jumps[l] += onPlatform * (2 - jumps[l]);     // float selects keeps GCC from vectorizing
+            dead[l] = onGround;
+            landedNext[l] = next;
+        }
+
+        // ----- Level::checkCollision against both platforms -----
+        for (int i = 0; i < 2; i++)
+        {
+            const float closestX = (bx < left[i]) ? left[i] : (bx > right[i] ? right[i] : bx);
+            const float dx = bx - closestX;
+            for (int l = 0; l < kLanes; l++)
+            {
+                float closestY = (y[l] < top[i]) ? top[i] : (y[l] > top[i] + rh ? top[i] + rh : y[l]);
+                float dy = y[l] - closestY;
+                dead[l] |= (dx * dx + dy * dy < radiusSq);
+            }
+        }
+
+        // ----- End conditions (the first one a lane meets decides it) -----
+        // A lane below the next top with no press left can only sink further
+        int32_t allDone = 1;
+        for (int l = 0; l < kLanes; l++)
+        {
+            int32_t spent = (jumps[l] == 0) | (s >= lastPress[l]);
+            int32_t sunk = spent & (vy[l] >= 0.0f) & (y[l] + radius > top1);
+            won[l] |= (done[l] ^ 1) & landedNext[l] & (dead[l] ^ 1);
+            done[l] |= landedNext[l] | dead[l] | sunk;
+            allDone &= done[l];
+        }
+        if (allDone)
+        {
+            break;
+        }
+    }
+
+    int landings = 0;
+    for (int l = 0; l < kLanes; l++)
+    {
+        landings += won[l];
+    }
+    return landings;
+}
+
+/**
+ * measure: kTrials plans from one stream per seed, sorted by first press
+ * and played in blocks of kLanes
+ *
+ * The first press is anywhere on the first platform (rolling off its edge
+ * clips the corner - Level::checkCollision - so later presses are
+ * wasted); three in four press again up to kSecondSeconds later
+ */
+float DifficultyModel::measure(const GameConfig &cfg, const Transition &t, uint64_t seed)
+{
+    const float dt = cfg.fixedTimestep;
+    const int holdSteps = (int)std::ceil(cfg.maxJumpHold / dt);
+    const int latestPress = (int)(t.prevWidth / (cfg.scrollSpeed * dt));
+    const int secondSteps = std::max(1, (int)(kSecondSeconds / dt));
+
+    Rng rng;
+    rng.seed(seed);
+    Plan plans[kTrials];
+    for (Plan &p : plans)
+    {
+        p.press1 = rng.range(0, latestPress);
+        p.release1 = p.press1 + rng.range(0, holdSteps);
+        bool second = rng.range(0, 3) != 0;
+        p.press2 = second ? p.press1 + rng.range(1, secondSteps) : -1;
+        p.release2 = second ? p.press2 + rng.range(0, holdSteps) : -1;
+    }
+    std::sort(plans, plans + kTrials, [](const Plan &a, const Plan &b) { return a.press1 < b.press1; });
+
+    int landings = 0;
+    for (int block = 0; block < kTrials; block += kLanes)
+    {
+        landings += playLanes(cfg, t, plans + block);
+    }
+    return 1.0f - (float)landings / (float)kTrials;
+}
+
+/**
+ * build: One job = kCellsPerJob cells; every cell writes its own table
+ * entry, so workers share nothing while sweeping
+ * Cell i's plans come from stream i, so the table doesn't depend on the
+ * thread count or the order jobs run in
+ */
+void DifficultyModel::build(const GameConfig &cfg, ThreadPool &pool)
+{
+    uint64_t hash = configHash(cfg);
+    if (built() && hash == tuning)
+    {
+        return;
+    }
+    tuning = hash;
+    minWidth = cfg.minPlatformWidth;
+    maxWidth = cfg.maxPlatformWidth;
+    minGap = cfg.minGap;
+    maxGap = cfg.maxGap;
+    maxRise = cfg.stepUpMax;
+    table.assign((size_t)kCells, 0.0f);
+
+    pool.parallelFor(kCells, kCellsPerJob, [&](int64_t begin, int64_t end, int)
+    {
+        for (int64_t i = begin; i < end; i++)
+        {
+            table[(size_t)i] = measure(cfg, cellTransition((int)i), (uint64_t)i);
+        }
+    });
+}
+
+/**
+ * gridPosition: Where value falls among `bins` evenly spaced grid points
+ * over [lo, hi] - the point below it and the fraction of the way to the
+ * next one (clamped to the grid)
+ */
+static int gridPosition(float value, float lo, float hi, int bins, float &fraction)
+{
+    float position = (hi > lo) ? (value - lo) / (hi - lo) * (float)(bins - 1) : 0.0f;
+    position = std::min((float)(bins - 1), std::max(0.0f, position));
+    int below = std::min(bins - 2, (int)position);
+    fraction = position - (float)below;
+    return below;
+}
+
+static float gridValue(int b, float lo, float hi, int bins)
+{
+    return lo + (hi - lo) * (float)b / (float)(bins - 1);
+}
+
+Transition DifficultyModel::cellTransition(int index) const
+{
+    int w = index % kWidthBins;
+    index /= kWidthBins;
+    int r = index % kRiseBins;
+    index /= kRiseBins;
+    int g = index % kGapBins;
+    int a = index / kGapBins;
+    Transition t;
+    t.prevWidth = gridValue(a, minWidth, maxWidth, kWidthBins);
+    t.gap = gridValue(g, minGap, maxGap, kGapBins);
+    t.rise = gridValue(r, -maxRise, maxRise, kRiseBins);
+    t.width = gridValue(w, minWidth, maxWidth, kWidthBins);
+    return t;
+}
+
+/**
+ * difficulty: Quadrilinear interpolation - each of the 16 surrounding
+ * grid points weighted by its closeness along all four axes
+ */
+float DifficultyModel::difficulty(const Transition &t) const
+{
+    float f[4];
+    int b[4];
+    b[0] = gridPosition(t.prevWidth, minWidth, maxWidth, kWidthBins, f[0]);
+    b[1] = gridPosition(t.gap, minGap, maxGap, kGapBins, f[1]);
+    b[2] = gridPosition(t.rise, -maxRise, maxRise, kRiseBins, f[2]);
+    b[3] = gridPosition(t.width, minWidth, maxWidth, kWidthBins, f[3]);
+
+    float value = 0.0f;
+    for (int corner = 0; corner < 16; corner++)
+    {
+        int c[4];
+        float weight = 1.0f;
+        for (int axis = 0; axis < 4; axis++)
+        {
+            int up = (corner >> axis) & 1;
+            c[axis] = b[axis] + up;
+            weight *= up ? f[axis] : 1.0f - f[axis];
+        }
+        int index = ((c[0] * kGapBins + c[1]) * kRiseBins + c[2]) * kWidthBins + c[3];
+        value += weight * table[(size_t)index];
+    }
+    return value;
+}
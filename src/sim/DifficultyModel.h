@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "../config/Config.h"
+
+class ThreadPool;
+
+/**
+ * Transition: The step from one platform to the next, in relative terms
+ * (all a jump between them depends on - absolute X doesn't matter)
+ */
+struct Transition
+{
+    float prevWidth;   // Width of the platform the ball leaves
+    float gap;         // Left edge to left edge
+    float rise;        // How much higher the next top is (prevTop - top)
+    float width;       // Width of the next platform
+};
+
+/**
+ * DifficultyModel: How hard a transition is, by Monte-Carlo bot sweep
+ *
+ * Difficulty is the fraction of random jump plans that fail to get from
+ * one platform onto the next: 0 = anything works, 1 = nothing tried did.
+ *
+ * Plans (kTrials per transition, drawn from a fixed stream per transition):
+ * - Press anywhere on the first platform, hold 0..maxJumpHold
+ * - Three out of four also press a second jump up to kSecondSeconds
+ *   later, held 0..maxJumpHold
+ *
+ * Each plan is played with Player::update / Level::resolveLanding /
+ * checkCollision's discrete step against just the two platforms, kLanes
+ * plans at a time in branch-free lane loops (like SearchBot's screening).
+ * Float physics in every build - the model is a statistic, not a replay.
+ * The ground is put just below the lower top (the least forgiving height
+ * a platform pair can have), so scores don't depend on absolute height.
+ *
+ * The table covers the generator's whole parameter range on a grid
+ * (kWidthBins x kGapBins x kRiseBins x kWidthBins points), swept once per
+ * tuning across a ThreadPool; lookups interpolate between the 16 grid
+ * points around a transition, so picking platforms costs no simulation.
+ * measure() plays one exact transition (CurveGenerator::measure).
+ */
+class DifficultyModel
+{
+public:
+    static const int kTrials = 64;          // Plans per transition
+    static const int kLanes = 8;            // Plans stepped together (8 floats = one AVX register)
+    static const int kWidthBins = 5;        // minPlatformWidth .. maxPlatformWidth (both widths)
+    static const int kGapBins = 9;          // minGap .. maxGap
+    static const int kRiseBins = 9;         // -stepUpMax .. stepUpMax
+    static const int kCells = kWidthBins * kGapBins * kRiseBins * kWidthBins;
+    static const int kCellsPerJob = 16;     // Grid points per work-stealing job (about a millisecond)
+    static constexpr float kSecondSeconds = 1.0f;  // Latest second press after the first
+
+    /**
+     * build: Sweep every grid point for cfg's tuning on the pool
+     * Does nothing if the table was already built for the same gameplay
+     * settings (configHash)
+     */
+    void build(const GameConfig &cfg, ThreadPool &pool);
+
+    /**
+     * difficulty: Table value interpolated at a transition (build() first)
+     * Transitions outside the grid take the value at its edge
+     */
+    float difficulty(const Transition &t) const;
+
+    /**
+     * measure: Play kTrials plans on one transition
+     * seed picks the plan stream (same seed, same plans, same result)
+     */
+    static float measure(const GameConfig &cfg, const Transition &t, uint64_t seed);
+
+    bool built() const { return !table.empty(); }
+
+private:
+    /**
+     * cellTransition: The transition at a grid point (row-major over
+     * prevWidth, gap, rise, width)
+     */
+    Transition cellTransition(int index) const;
+
+    std::vector<float> table;   // Difficulty per grid point
+    uint64_t tuning = 0;        // configHash the table was built for
+    float minWidth = 0.0f, maxWidth = 0.0f;
+    float minGap = 0.0f, maxGap = 0.0f;
+    float maxRise = 0.0f;
+};
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+/**
+ * Fixed: Signed fixed-point number with FracBits fraction bits in an int32
+ *
+ * Every operation is integer arithmetic, so results are bit-identical on
+ * every CPU and compiler (no FPU modes, no fused multiply-add, no x87
+ * excess precision) and cheap on boards without a fast FPU.
+ *
+ * - Range: +-2^(31 - FracBits); Q16.16 covers +-32768 with 1/65536 steps
+ * - + and - wrap like int32 (callers keep values in range)
+ * - * and / use a 64-bit intermediate and round toward negative infinity
+ *   (arithmetic right shift / floor division)
+ * - fromFloat rounds to the nearest step; toFloat is the usual int->float
+ *   conversion (both exact IEEE operations, so also deterministic)
+ */
+template <int FracBits>
+struct Fixed
+{
+    static const int32_t kOne = (int32_t)1 << FracBits;
+
+    int32_t raw = 0;   // Value * 2^FracBits
+
+    static Fixed fromRaw(int32_t r)
+    {
+        Fixed f;
+        f.raw = r;
+        return f;
+    }
+
+    static Fixed fromInt(int v)
+    {
+        return fromRaw((int32_t)((uint32_t)v << FracBits));
+    }
+
+    static Fixed fromFloat(float v)
+    {
+        return fromRaw((int32_t)std::floor(v * (float)kOne + 0.5f));
+    }
+
+    float toFloat() const
+    {
+        return (float)raw * (1.0f / (float)kOne);
+    }
+
+    Fixed operator-() const { return fromRaw((int32_t)(0u - (uint32_t)raw)); }
+    Fixed operator+(Fixed o) const { return fromRaw((int32_t)((uint32_t)raw + (uint32_t)o.raw)); }
+    Fixed operator-(Fixed o) const { return fromRaw((int32_t)((uint32_t)raw - (uint32_t)o.raw)); }
+    Fixed operator*(Fixed o) const { return fromRaw((int32_t)(((int64_t)raw * o.raw) >> FracBits)); }
+    Fixed operator/(Fixed o) const
+    {
+        int64_t n = (int64_t)raw * kOne;
+        int64_t q = n / o.raw;
+        if ((n % o.raw != 0) && ((n < 0) != (o.raw < 0)))
+        {
+            q--;  // Floor, not truncate
+        }
+        return fromRaw((int32_t)q);
+    }
+
+    Fixed &operator+=(Fixed o) { return *this = *this + o; }
+    Fixed &operator-=(Fixed o) { return *this = *this - o; }
+    Fixed &operator*=(Fixed o) { return *this = *this * o; }
+    Fixed &operator/=(Fixed o) { return *this = *this / o; }
+
+    bool operator==(Fixed o) const { return raw == o.raw; }
+    bool operator!=(Fixed o) const { return raw != o.raw; }
+    bool operator<(Fixed o) const { return raw < o.raw; }
+    bool operator<=(Fixed o) const { return raw <= o.raw; }
+    bool operator>(Fixed o) const { return raw > o.raw; }
+    bool operator>=(Fixed o) const { return raw >= o.raw; }
+};
+
+typedef Fixed<16> Q16_16;
+
+/**
+ * ScalarTraits: Conversions between float and a physics scalar type
+ * (identity for float, so the float build pays nothing)
+ */
+template <typename Scalar>
+struct ScalarTraits;
+
+template <>
+struct ScalarTraits<float>
+{
+    static float fromFloat(float v) { return v; }
+    static float toFloat(float v) { return v; }
+    static const char *name() { return "float"; }
+};
+
+template <int FracBits>
+struct ScalarTraits<Fixed<FracBits>>
+{
+    static Fixed<FracBits> fromFloat(float v) { return Fixed<FracBits>::fromFloat(v); }
+    static float toFloat(Fixed<FracBits> v) { return v.toFloat(); }
+    static const char *name() { return "fixed"; }
+};
+
+/**
+ * PhysicsScalar: Number type of the physics core in this build
+ * PHYSICS_FIXED=1 selects Q16.16 (set by the Makefile's FIXED option)
+ */
+#ifndef PHYSICS_FIXED
+#define PHYSICS_FIXED 0
+#endif
+
+#if PHYSICS_FIXED
+typedef Q16_16 PhysicsScalar;
+#else
+typedef float PhysicsScalar;
+#endif
+
+static const bool kPhysicsFixed = PHYSICS_FIXED != 0;
+
+/**
+ * toScalar / toFloat: Shorthands for the build's PhysicsScalar
+ */
+inline PhysicsScalar toScalar(float v)
+{
+    return ScalarTraits<PhysicsScalar>::fromFloat(v);
+}
+
+inline float toFloat(PhysicsScalar v)
+{
+    return ScalarTraits<PhysicsScalar>::toFloat(v);
+}
@@ -0,0 +1,110 @@
+#include "GhostRace.h"
+#include <algorithm>
+
+/**
+ * reset: Every ghost starts like the host's player, nothing scored
+ */
+void GhostRace::reset(const Simulation &host, int ghosts)
+{
+    count = std::max(0, std::min(ghosts, kMaxGhosts));
+    for (int g = 0; g < count; g++)
+    {
+        players[g].reset(host.config);
+        score[g] = 0;
+        gameOver[g] = false;
+        deathCause[g] = DeathCause::None;
+        levelComplete[g] = false;
+    }
+}
+
+/**
+ * step: Simulation::step for every running ghost, in its order
+ * 1. Jump input, then Player::update (per ghost)
+ * 2. Landing for all of them in one pass (host.level, already scrolled)
+ * 3. Grounded state, ground death, score (the host's) and the win check
+ * 4. Platform side hits for all of them in one pass
+ * Ghosts are gathered first so the batched queries only see running ones
+ */
+void GhostRace::step(const FrameInput *inputs, float dt, const Simulation &host)
+{
+    const GameConfig &cfg = host.config;
+    int live[kMaxGhosts];
+    float prevY[kMaxGhosts], y[kMaxGhosts], vy[kMaxGhosts];
+    int n = 0;
+    for (int g = 0; g < count; g++)
+    {
+        if (isFinished(g))
+        {
+            continue;
+        }
+        Player &player = players[g];
+        if (inputs[g].jumpPressed && player.canJump())
+        {
+            player.startJump();
+        }
+        prevY[n] = toFloat(player.y);
+        player.update(dt, inputs[g].jumpHeld, cfg);
+        y[n] = toFloat(player.y);
+        vy[n] = toFloat(player.vy);
+        live[n++] = g;
+    }
+    if (n == 0)
+    {
+        return;
+    }
+
+    // Every ball is at the same screen X as the host's
+    bool landed[kMaxGhosts], landedOnGround[kMaxGhosts], hit[kMaxGhosts];
+    host.level.resolveLandingBatch(host.player.x, n, prevY, y, vy, cfg.radius, cfg, landed, landedOnGround);
+
+    for (int k = 0; k < n; k++)
+    {
+        int g = live[k];
+        Player &player = players[g];
+        if (landed[k])
+        {
+            player.y = toScalar(y[k]);
+            player.vy = toScalar(vy[k]);
+        }
+        player.setGrounded(landed[k]);
+        y[k] = toFloat(player.y);  // Collision is tested where the ball ended up
+
+        if (landedOnGround[k] && player.hasJumpedOnce())
+        {
+            gameOver[g] = true;
+            deathCause[g] = DeathCause::Ground;
+        }
+        score[g] = host.score;
+        if (!cfg.endless && score[g] >= cfg.totalPlatforms)
+        {
+            levelComplete[g] = true;
+        }
+    }
+
+    host.level.checkCollisionBatch(host.player.x, n, y, cfg.radius, cfg, hit);
+    for (int k = 0; k < n; k++)
+    {
+        int g = live[k];
+        if (hit[k])
+        {
+            if (!gameOver[g])
+            {
+                deathCause[g] = DeathCause::Platform;
+            }
+            gameOver[g] = true;
+        }
+    }
+}
+
+/**
+ * running: Count of ghosts not finished yet
+ */
+int GhostRace::running() const
+{
+    int n = 0;
+    for (int g = 0; g < count; g++)
+    {
+        n += isFinished(g) ? 0 : 1;
+    }
+    return n;
+}
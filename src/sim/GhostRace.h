@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../config/Config.h"
+#include "../player/Player.h"
+#include "../level/Level.h"
+#include "Input.h"
+#include "Simulation.h"
+
+/**
+ * GhostRace: Extra balls (replay ghosts, other players) racing a host
+ * Simulation's run on the host's own Level
+ *
+ * Every ball sits at the same screen X and the camera scrolls at a fixed
+ * speed, so all racers meet the same platforms at the same step. Instead
+ * of a Level per racer, the host's level answers for all of them through
+ * its batched read-only queries:
+ * - step() runs right after each host step (the host has scrolled the
+ *   level): every ghost's jump and Player::update as in Simulation::step,
+ *   then one resolveLandingBatch and one checkCollisionBatch for all of
+ *   them - two passes over the platforms under the ball, whatever the
+ *   ghost count
+ * - A ghost's score is the host's while it runs: platforms are passed at
+ *   the same X by everyone, so the host's score cursor serves all racers
+ * - Each ghost ends up exactly where a Simulation of its own fed the same
+ *   inputs would, step for step, for as long as the host's run lasts (the
+ *   level stops scrolling when it ends, and so does the race)
+ * - The discrete per-step tests only: GameConfig::continuousCollision is
+ *   ignored (as in BatchSim)
+ */
+class GhostRace
+{
+public:
+    static constexpr int kMaxGhosts = Level::kMaxBatchBalls;
+
+    /**
+     * reset: `count` ghosts (at most kMaxGhosts) at the start of host's run
+     * Call after the host's own reset
+     */
+    void reset(const Simulation &host, int count);
+
+    /**
+     * step: Advance every running ghost by one step, ghost g with inputs[g]
+     * Call after each host.step that simulated (the host wasn't finished)
+     */
+    void step(const FrameInput *inputs, float dt, const Simulation &host);
+
+    /**
+     * isFinished: Ghost g died or completed the level
+     */
+    bool isFinished(int g) const
+    {
+        return gameOver[g] || levelComplete[g];
+    }
+
+    /**
+     * running: Ghosts still in the race
+     */
+    int running() const;
+
+    // ===== Ghost State (ghost g = index g) =====
+    int count = 0;                             // Ghosts in this race
+    Player players[kMaxGhosts];                // Each ghost's ball
+    int score[kMaxGhosts] = {};                // Platforms passed
+    bool gameOver[kMaxGhosts] = {};            // Died (ground or platform side)
+    DeathCause deathCause[kMaxGhosts] = {};    // Why (first cause wins)
+    bool levelComplete[kMaxGhosts] = {};       // Passed every platform
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * FrameInput: Player input for a single simulation step
+ *
+ * The simulation never polls the keyboard itself - whoever drives it
+ * (interactive Game loop, headless runner, bot, replay) fills this in
+ * and passes it to Simulation::step.
+ */
+struct FrameInput
+{
+    bool jumpPressed = false;  // Jump button went down this step (starts a jump)
+    bool jumpHeld = false;     // Jump button is held this step (variable jump height)
+};
@@ -0,0 +1,197 @@
+#include "LevelPregenerator.h"
+#include "Replay.h"
+#include <algorithm>
+#include <chrono>
+
+/**
+ * LevelPregenerator constructor: The producer starts once every member exists
+ */
+LevelPregenerator::LevelPregenerator()
+{
+    producer = std::thread([this] { producerLoop(); });
+}
+
+/**
+ * LevelPregenerator destructor: Wake the producer to see the stop flag
+ */
+LevelPregenerator::~LevelPregenerator()
+{
+    stopping.store(true, std::memory_order_release);
+    wake.notify_all();
+    producer.join();
+}
+
+/**
+ * reserve: Read by the producer at each build (slots are reserved there)
+ */
+void LevelPregenerator::reserve(size_t bytes, int platforms)
+{
+    levelBytes.store(bytes, std::memory_order_relaxed);
+    stagePlatforms.store(platforms, std::memory_order_relaxed);
+    gameCurve.reserve((size_t)std::max(0, platforms));
+}
+
+/**
+ * useCurves: Read by the producer at each build
+ */
+void LevelPregenerator::useCurves(const CurveGenerator *generator)
+{
+    curves.store(generator, std::memory_order_relaxed);
+}
+
+/**
+ * order: Queue the order for the current restart epoch and wake the producer
+ */
+bool LevelPregenerator::order(const GameConfig &cfg, const LevelStage &stage)
+{
+    LevelOrder next;
+    next.config = cfg;
+    next.stage = stage;
+    next.key = keyOf(cfg, stage);
+    next.epoch = epoch.load(std::memory_order_relaxed);
+    if (!orders.tryPush(next))
+    {
+        return false;
+    }
+    wake.notify_one();
+    return true;
+}
+
+/**
+ * take: Drain the double buffer, swapping in the first run that matches
+ * - Bumping the epoch first means the producer skips any order still
+ *   queued (it was made for this restart) instead of filling a slot with it
+ * - A slot published after the drain is stale and dropped by the next take
+ * - The swap moves Level members only (its arena moves its block
+ *   pointer); the slot leaves with sim's old level, which the producer
+ *   rebuilds in place
+ */
+bool LevelPregenerator::take(const GameConfig &cfg, const LevelStage &stage, Simulation &sim)
+{
+    epoch.fetch_add(1, std::memory_order_acq_rel);
+    RunKey wanted = keyOf(cfg, stage);
+    bool taken = false;
+    while (PregeneratedRun *run = finished.front())
+    {
+        if (!taken && run->key == wanted)
+        {
+            sim.config = cfg;
+            sim.reset(run->run.level, stage);
+            taken = true;
+        }
+        finished.pop();
+    }
+    if (taken)
+    {
+        hits++;
+    }
+    else
+    {
+        misses++;
+    }
+    return taken;
+}
+
+/**
+ * resetNow: resetRun with the game thread's scratch
+ */
+void LevelPregenerator::resetNow(const GameConfig &cfg, const LevelStage &stage, Simulation &sim)
+{
+    resetRun(cfg, stage, sim, gameCurve);
+}
+
+/**
+ * keyOf: Everything a reset's outcome depends on besides the cloud stream
+ */
+LevelPregenerator::RunKey LevelPregenerator::keyOf(const GameConfig &cfg, const LevelStage &stage)
+{
+    RunKey key;
+    key.seed = cfg.seed;
+    key.tuning = configHash(cfg);
+    key.stageGap = stage.gap;
+    key.stageCount = stage.count;
+    key.cloudCount = cfg.cloudCount;
+    return key;
+}
+
+/**
+ * sleepUntil: Condition-variable sleep with a poll interval
+ * (the game thread notifies without taking the mutex)
+ */
+template <typename Ready>
+bool LevelPregenerator::sleepUntil(Ready ready)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping.load(std::memory_order_acquire) && !ready())
+    {
+        wake.wait_for(lock, std::chrono::milliseconds(kIdlePollMs));
+    }
+    return !stopping.load(std::memory_order_acquire);
+}
+
+/**
+ * producerLoop: Pop an order, skip it if a restart made it stale, wait
+ * for a free slot, build into the slot in place and publish it
+ */
+void LevelPregenerator::producerLoop()
+{
+    for (;;)
+    {
+        if (!sleepUntil([this] { return orders.front() != nullptr; }))
+        {
+            return;
+        }
+        LevelOrder next;
+        orders.tryPop(next);
+        if (next.epoch != epoch.load(std::memory_order_acquire))
+        {
+            continue;  // Ordered before the latest restart
+        }
+
+        PregeneratedRun *slot = nullptr;
+        if (!sleepUntil([&] { return (slot = finished.beginPush()) != nullptr; }))
+        {
+            return;
+        }
+        build(next, *slot);
+        if (next.epoch == epoch.load(std::memory_order_acquire))
+        {
+            finished.endPush();
+        }
+    }
+}
+
+/**
+ * build: The same reset Game would run, in the slot's own simulation
+ * (reserving is a no-op once its level's arenas are big enough - slots
+ * trade levels with the game, all reserved the same)
+ */
+void LevelPregenerator::build(const LevelOrder &order, PregeneratedRun &out)
+{
+    Simulation &run = out.run;
+    run.level.reserveStorage(levelBytes.load(std::memory_order_relaxed),
+                             stagePlatforms.load(std::memory_order_relaxed));
+    resetRun(order.config, order.stage, run, producerCurve);
+    out.key = order.key;
+}
+
+/**
+ * resetRun: Curve levels go through CurveGenerator::resetRun, like replays
+ */
+void LevelPregenerator::resetRun(const GameConfig &cfg, const LevelStage &stage, Simulation &sim, CurvedLevel &scratch) const
+{
+    const CurveGenerator *generator = curves.load(std::memory_order_relaxed);
+    sim.config = cfg;
+    if (stage.gap)
+    {
+        sim.reset(stage);
+    }
+    else if (generator && cfg.curveLevels && !cfg.endless)
+    {
+        generator->resetRun(sim, scratch);
+    }
+    else
+    {
+        sim.reset();
+    }
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "../config/Config.h"
+#include "../level/PlatformGenerator.h"
+#include "../parallel/SpscRing.h"
+#include "CurveGenerator.h"
+#include "Simulation.h"
+
+/**
+ * LevelPregenerator: Builds upcoming runs on a background thread
+ *
+ * While a run is played, the game orders the run(s) that may follow it
+ * (the next random seed; in a pack both a retry of the stage and the next
+ * stage). A producer thread runs the reset the game would run on a
+ * Simulation of its own, one per slot of a double buffer, with level
+ * storage sized up front (reserve). On restart the game takes the one
+ * that matches: take() swaps its Level with the game's (Simulation::reset
+ * with a built level - the storage moves with the Level; no generation,
+ * carving or copying on the game thread) and the level that was just
+ * played goes back to the producer to be rebuilt. If none matches or it
+ * isn't built yet, the caller resets synchronously (resetNow).
+ *
+ * What the swap saves is the level's generation, so only runs whose
+ * reset costs more than the handoff are built here (prebuilt()):
+ * - Curve levels (GameConfig::curveLevels, CurveGenerator, ~0.4 ms for
+ *   200 platforms): the producer generates one and packs it into the
+ *   slot level's own stage storage (Level::packStage), which swaps in
+ *   with the level
+ * - Pack stages: the producer is the first to touch the stage's pages of
+ *   the memory-mapped pack, so a restart never waits on a page fault
+ * A flat random level resets in about 0.6 us and takes about 1.2 us to
+ * swap in (headless restart), so callers reset those synchronously.
+ *
+ * take() reads what the producer wrote long ago, so it touches as little
+ * as it can: one cache line of RunKey per finished run and the Level it
+ * swaps in; player and run state are reset on the game thread as usual.
+ *
+ * Handoff (lock-free both ways):
+ * - Orders go to the producer through an SpscRing; finished runs come
+ *   back through another one whose two slots are the double buffer - the
+ *   producer fills one while the game may be swapping with the other
+ * - take() drains every finished run and bumps the epoch, so orders for
+ *   the restart that just happened are skipped instead of built
+ * - The main thread never locks: the producer sleeps on a condition
+ *   variable notified without the mutex, and rechecks every kIdlePollMs
+ *   in case a notification slipped in before it went to sleep
+ *
+ * Results are identical to a synchronous reset (resetNow) for gameplay.
+ * Clouds of pack stages and curve levels continue the slot's own cloud
+ * stream (decoration only).
+ * Everything public must be called from one thread (the game thread).
+ */
+class LevelPregenerator
+{
+public:
+    static constexpr int kIdlePollMs = 5;  // Longest a missed wake-up delays the producer
+
+    /**
+     * Constructor: Start the producer thread (idle until the first order)
+     */
+    LevelPregenerator();
+
+    /**
+     * Destructor: Stop and join the producer
+     */
+    ~LevelPregenerator();
+
+    LevelPregenerator(const LevelPregenerator &) = delete;
+    LevelPregenerator &operator=(const LevelPregenerator &) = delete;
+
+    /**
+     * reserve: Size every run's level storage for layouts of up to
+     * levelBytes (Level::storageBytes) and curve levels of up to
+     * stagePlatforms - the game's own Simulation must be reserved the
+     * same, as take() trades levels with it (resetNow's curve scratch is
+     * sized here too)
+     * Call before the first order
+     */
+    void reserve(size_t levelBytes, int stagePlatforms = 0);
+
+    /**
+     * useCurves: Generator for orders with cfg.curveLevels (random finite
+     * levels), prepared for their tuning and alive while orders are built;
+     * without one they get flat levels
+     * Call before the first order
+     */
+    void useCurves(const CurveGenerator *generator);
+
+    /**
+     * prebuilt: Whether the run a reset with cfg / on stage would start
+     * is worth ordering (a pack stage or a curve level) - for anything
+     * else, resetNow directly is cheaper than take()
+     */
+    static bool prebuilt(const GameConfig &cfg, const LevelStage &stage = LevelStage())
+    {
+        return stage.gap != nullptr || (cfg.curveLevels && !cfg.endless);
+    }
+
+    /**
+     * order: Ask for the run a reset with cfg (random level from cfg.seed)
+     * or a reset on stage (stage.gap != nullptr) would start
+     * Returns false if the order queue is full (the run is built on demand)
+     */
+    bool order(const GameConfig &cfg, const LevelStage &stage = LevelStage());
+
+    /**
+     * take: Start sim on the finished run matching this order, if there
+     * is one (sim.reset with its level); every other finished or queued
+     * run is dropped either way
+     * Returns false if nothing matched (reset sim as usual)
+     */
+    bool take(const GameConfig &cfg, const LevelStage &stage, Simulation &sim);
+
+    /**
+     * resetNow: The reset the producer would have run, on this thread
+     * (take()'s fallback - the same level for the same order)
+     */
+    void resetNow(const GameConfig &cfg, const LevelStage &stage, Simulation &sim);
+
+    // ===== Statistics (game thread) =====
+    long long hits = 0;     // take() calls that swapped in a prebuilt run
+    long long misses = 0;   // take() calls that found nothing matching
+
+private:
+    /**
+     * RunKey: Which run an order starts - same gameplay settings
+     * (configHash), seed, cloud count and stage
+     */
+    struct RunKey
+    {
+        uint64_t seed;
+        uint64_t tuning;            // configHash
+        const uint16_t *stageGap;   // Stage data (nullptr = random level)
+        int stageCount;
+        int cloudCount;
+
+        bool operator==(const RunKey &o) const
+        {
+            return seed == o.seed && tuning == o.tuning && stageGap == o.stageGap &&
+                   stageCount == o.stageCount && cloudCount == o.cloudCount;
+        }
+    };
+
+    /**
+     * LevelOrder: What to build, and for which restart
+     */
+    struct LevelOrder
+    {
+        GameConfig config;
+        LevelStage stage;   // stage.gap == nullptr = random level
+        RunKey key;         // keyOf(config, stage)
+        uint64_t epoch;     // take() calls before the order was made
+    };
+
+    /**
+     * PregeneratedRun: A finished order (key first: all take() reads of a
+     * run that doesn't match)
+     */
+    struct PregeneratedRun
+    {
+        RunKey key;
+        Simulation run;     // Right after the reset (take swaps its level into the game's)
+    };
+
+    /**
+     * keyOf: The RunKey of a reset with cfg / on stage
+     */
+    static RunKey keyOf(const GameConfig &cfg, const LevelStage &stage);
+
+    /**
+     * producerLoop: Thread body - build orders until stopped
+     */
+    void producerLoop();
+
+    /**
+     * build: Reset a slot's simulation for an order
+     */
+    void build(const LevelOrder &order, PregeneratedRun &out);
+
+    /**
+     * resetRun: Reset sim for a run with cfg / on stage - a pack stage, a
+     * curve level generated through scratch, or a flat level
+     */
+    void resetRun(const GameConfig &cfg, const LevelStage &stage, Simulation &sim, CurvedLevel &scratch) const;
+
+    /**
+     * sleepUntil: Wait until ready() or stop (at most kIdlePollMs per check)
+     * Returns false when stopping
+     */
+    template <typename Ready>
+    bool sleepUntil(Ready ready);
+
+    SpscRing<LevelOrder, 4> orders;         // Game thread -> producer
+    SpscRing<PregeneratedRun, 2> finished;  // Producer -> game thread (the double buffer)
+    std::atomic<uint64_t> epoch{0};         // Bumped by take(): older orders are stale
+    std::atomic<size_t> levelBytes{0};      // Level storage every slot reserves (reserve)
+    std::atomic<int> stagePlatforms{0};     // Curve level length every slot reserves (reserve)
+    std::atomic<const CurveGenerator *> curves{nullptr};  // Curve levels (useCurves; nullptr = flat)
+    CurvedLevel producerCurve;              // Producer's generation scratch
+    CurvedLevel gameCurve;                  // resetNow's generation scratch (game thread)
+    std::atomic<bool> stopping{false};
+    std::mutex mutex;                       // Only the producer sleeps on it
+    std::condition_variable wake;           // New order, freed slot or stop
+    std::thread producer;                   // Started last: everything above exists
+};
@@ -0,0 +1,475 @@
+#include "Replay.h"
+#include "CurveGenerator.h"
+#include "Fixed.h"
+#include "Simulation.h"
+#include "../parallel/ThreadPool.h"
+#include <cstring>
+
+static const char kReplayMagic[4] = {'J', 'B', 'R', 'P'};
+static const size_t kReplayHeaderSize = 40;
+static const size_t kReplayV4HeaderSize = 32;
+static const uint16_t kReplayFlagEndless = 1;
+static const uint16_t kReplayFlagContinuous = 2;
+static const uint16_t kReplayFlagCurve = 4;
+
+// ===== Config Hash =====
+
+/**
+ * hashBytes: FNV-1a 64-bit step over a value's bytes
+ */
+static uint64_t hashBytes(uint64_t h, const void *bytes, size_t size)
+{
+    const uint8_t *p = (const uint8_t *)bytes;
+    for (size_t i = 0; i < size; i++)
+    {
+        h ^= p[i];
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+/**
+ * hashInt / hashFloat: Fixed-width field hashing (floats by bit pattern)
+ */
+static uint64_t hashInt(uint64_t h, int value)
+{
+    int32_t v = (int32_t)value;
+    return hashBytes(h, &v, sizeof(v));
+}
+
+static uint64_t hashFloat(uint64_t h, float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return hashBytes(h, &bits, sizeof(bits));
+}
+
+/**
+ * configHash: Gameplay fields in declaration order
+ * Clouds are excluded too - they use their own stream and never touch gameplay
+ */
+uint64_t configHash(const GameConfig &cfg)
+{
+    uint64_t h = 0xCBF29CE484222325ULL;
+    h = hashInt(h, cfg.screenWidth);
+    h = hashInt(h, cfg.screenHeight);
+    h = hashFloat(h, cfg.radius);
+    h = hashFloat(h, cfg.groundY);
+    h = hashFloat(h, cfg.gravity);
+    h = hashFloat(h, cfg.jumpVelocity);
+    h = hashFloat(h, cfg.maxJumpHold);
+    h = hashFloat(h, cfg.jumpHoldAccel);
+    h = hashFloat(h, cfg.scrollSpeed);
+    h = hashInt(h, cfg.totalPlatforms);
+    h = hashInt(h, cfg.endless ? 1 : 0);
+    h = hashFloat(h, cfg.minGap);
+    h = hashFloat(h, cfg.maxGap);
+    h = hashFloat(h, cfg.minPlatformWidth);
+    h = hashFloat(h, cfg.maxPlatformWidth);
+    h = hashFloat(h, cfg.platformHeight);
+    h = hashFloat(h, cfg.minPlatformY);
+    h = hashFloat(h, cfg.stepUpMin);
+    h = hashFloat(h, cfg.stepUpMax);
+    h = hashFloat(h, cfg.fixedTimestep);
+    h = hashInt(h, kPhysicsFixed ? 1 : 0);
+    if (cfg.continuousCollision)
+    {
+        h = hashInt(h, 1);  // Only when on: hashes of discrete-step replays are unchanged
+    }
+    if (cfg.curveLevels)
+    {
+        h = hashInt(h, 2);  // Same: flat-level hashes are unchanged
+        h = hashFloat(h, cfg.curveFrom);
+        h = hashFloat(h, cfg.curveTo);
+    }
+    return h;
+}
+
+// ===== Little-Endian Helpers =====
+
+static void storeU16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void storeU32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static void storeU64(uint8_t *p, uint64_t v)
+{
+    for (int i = 0; i < 8; i++) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint16_t loadU16(const uint8_t *p)
+{
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t loadU32(const uint8_t *p)
+{
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) v |= (uint32_t)p[i] << (8 * i);
+    return v;
+}
+
+static uint64_t loadU64(const uint8_t *p)
+{
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+/**
+ * floatBits / bitsFloat: A float's bit pattern and back (exact round trip)
+ */
+static uint32_t floatBits(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static float bitsFloat(uint32_t bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * inputState: FrameInput as the two event state bits
+ */
+static int inputState(const FrameInput &input)
+{
+    return (input.jumpPressed ? 1 : 0) | (input.jumpHeld ? 2 : 0);
+}
+
+// ===== ReplayWriter =====
+
+/**
+ * Destructor: A recording still open is closed as unfinished
+ */
+ReplayWriter::~ReplayWriter()
+{
+    if (file)
+    {
+        finish(ReplayResult());
+    }
+}
+
+/**
+ * begin: Open the file and write the header (closes any previous recording first)
+ */
+bool ReplayWriter::begin(const char *path, const GameConfig &cfg)
+{
+    if (file)
+    {
+        finish(ReplayResult());
+    }
+
+    file = std::fopen(path, "wb");
+    if (!file)
+    {
+        return false;
+    }
+    failed = false;
+    lastFrame = -1;
+    lastState = 0;
+    used = 0;
+
+    uint8_t header[kReplayHeaderSize] = {};
+    std::memcpy(header, kReplayMagic, 4);
+    storeU16(header + 4, kReplayVersion);
+    storeU16(header + 6, (uint16_t)((cfg.endless ? kReplayFlagEndless : 0) |
+                                    (cfg.continuousCollision ? kReplayFlagContinuous : 0) |
+                                    (cfg.curveLevels ? kReplayFlagCurve : 0)));
+    storeU32(header + 8, kPhysicsFixed ? 1u : 0u);
+    storeU64(header + 16, cfg.seed);
+    storeU64(header + 24, configHash(cfg));
+    storeU32(header + 32, cfg.curveLevels ? floatBits(cfg.curveFrom) : 0u);
+    storeU32(header + 36, cfg.curveLevels ? floatBits(cfg.curveTo) : 0u);
+    for (size_t i = 0; i < kReplayHeaderSize; i++)
+    {
+        put(header[i]);
+    }
+    return true;
+}
+
+/**
+ * record: Emit an event only when the input state changes
+ */
+void ReplayWriter::record(long long frame, const FrameInput &input)
+{
+    if (!file)
+    {
+        return;
+    }
+    int state = inputState(input);
+    if (state == lastState)
+    {
+        return;  // Same as the previous step - implied by the stream
+    }
+    putVarint(((uint64_t)(frame - lastFrame) << 2) | (uint64_t)state);
+    lastFrame = frame;
+    lastState = state;
+}
+
+/**
+ * finish: End marker + outcome, then close
+ */
+bool ReplayWriter::finish(const ReplayResult &result)
+{
+    if (!file)
+    {
+        return false;
+    }
+    putVarint(0);
+    putVarint((uint64_t)result.frames);
+    putVarint((uint64_t)result.score);
+    put((uint8_t)((result.gameOver ? 1 : 0) | (result.levelComplete ? 2 : 0) | (result.finished ? 4 : 0)));
+    flush();
+
+    bool ok = !failed && std::fclose(file) == 0;
+    file = nullptr;
+    return ok;
+}
+
+/**
+ * put: Append one byte, writing the buffer out when it fills up
+ */
+void ReplayWriter::put(uint8_t byte)
+{
+    if (used == (int)sizeof(buffer))
+    {
+        flush();
+    }
+    buffer[used++] = byte;
+}
+
+/**
+ * putVarint: Unsigned LEB128 (7 bits per byte, high bit = more bytes follow)
+ */
+void ReplayWriter::putVarint(uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        put((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    put((uint8_t)value);
+}
+
+/**
+ * flush: Write pending bytes to the file
+ */
+void ReplayWriter::flush()
+{
+    if (used > 0 && std::fwrite(buffer, 1, (size_t)used, file) != (size_t)used)
+    {
+        failed = true;
+    }
+    used = 0;
+}
+
+// ===== ReplayReader =====
+
+/**
+ * open: Load the file, check the header and locate the footer
+ * Events are scanned once up front so a truncated file is detected before playback
+ */
+bool ReplayReader::open(const char *path)
+{
+    data.clear();
+    complete = false;
+    result = ReplayResult();
+
+    std::FILE *file = std::fopen(path, "rb");
+    if (!file)
+    {
+        return false;
+    }
+    uint8_t chunk[4096];
+    size_t got;
+    while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        data.insert(data.end(), chunk, chunk + got);
+    }
+    std::fclose(file);
+
+    if (data.size() < kReplayV4HeaderSize || std::memcmp(data.data(), kReplayMagic, 4) != 0)
+    {
+        return false;
+    }
+    uint16_t version = loadU16(data.data() + 4);
+    headerSize = (version == 4) ? kReplayV4HeaderSize : kReplayHeaderSize;
+    if ((version != kReplayVersion && version != 4) || data.size() < headerSize)
+    {
+        return false;
+    }
+    uint16_t flags = loadU16(data.data() + 6);
+    endless = (flags & kReplayFlagEndless) != 0;
+    continuousCollision = (flags & kReplayFlagContinuous) != 0;
+    curveLevels = (flags & kReplayFlagCurve) != 0;
+    fixedPhysics = loadU32(data.data() + 8) == 1;
+    seed = loadU64(data.data() + 16);
+    hash = loadU64(data.data() + 24);
+    curveFrom = (version == 4) ? 0.0f : bitsFloat(loadU32(data.data() + 32));
+    curveTo = (version == 4) ? 0.0f : bitsFloat(loadU32(data.data() + 36));
+
+    // Scan to the end marker and read the footer
+    pos = headerSize;
+    uint64_t value;
+    while (readVarint(value) && value != 0)
+    {
+    }
+    uint64_t frames, score;
+    if (pos < data.size() && readVarint(frames) && readVarint(score) && pos < data.size() &&
+        frames <= (uint64_t)kMaxReplayFrames)
+    {
+        uint8_t flags = data[pos];
+        result.frames = (long long)frames;
+        result.score = (int)score;
+        result.gameOver = (flags & 1) != 0;
+        result.levelComplete = (flags & 2) != 0;
+        result.finished = (flags & 4) != 0;
+        complete = true;
+    }
+
+    rewind();
+    return true;
+}
+
+/**
+ * rewind: Back to the first event (decoding only, the file stays loaded)
+ */
+void ReplayReader::rewind()
+{
+    pos = headerSize;
+    frame = 0;
+    state = 0;
+    nextEventFrame = -1;
+    decodeEvent();
+}
+
+/**
+ * config: Same construction as Game::reset - defaults plus what the
+ * header records (seed, mode, collision mode, curve ramp)
+ */
+GameConfig ReplayReader::config() const
+{
+    GameConfig cfg;
+    cfg.seed = seed;
+    cfg.endless = endless;
+    cfg.continuousCollision = continuousCollision;
+    cfg.curveLevels = curveLevels;
+    if (curveLevels)
+    {
+        cfg.curveFrom = curveFrom;
+        cfg.curveTo = curveTo;
+    }
+    return cfg;
+}
+
+/**
+ * next: Apply the pending event when its frame comes up
+ */
+FrameInput ReplayReader::next()
+{
+    if (frame == nextEventFrame)
+    {
+        state = nextEventState;
+        decodeEvent();
+    }
+    frame++;
+
+    FrameInput input;
+    input.jumpPressed = (state & 1) != 0;
+    input.jumpHeld = (state & 2) != 0;
+    return input;
+}
+
+/**
+ * readVarint: Decode one LEB128 value at pos (false if the data ends first)
+ */
+bool ReplayReader::readVarint(uint64_t &value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64 && pos < data.size(); shift += 7)
+    {
+        uint8_t byte = data[pos++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * decodeEvent: Load the next event (nextEventFrame holds the previous one's frame)
+ * Stops at the end marker or a truncated stream
+ */
+void ReplayReader::decodeEvent()
+{
+    uint64_t value;
+    if (!readVarint(value) || value == 0)
+    {
+        nextEventFrame = -2;  // No more events (matches no frame)
+        return;
+    }
+    nextEventFrame += (long long)(value >> 2);
+    nextEventState = (int)(value & 3);
+}
+
+// ===== Playback =====
+
+/**
+ * playReplay: Re-simulate with the recorded inputs and compare the outcome
+ * Everything that can be rejected without simulating is checked first, so
+ * the loop always ends within the footer's (capped) step count
+ */
+bool playReplay(ReplayReader &reader, Simulation &sim, CurveGenerator *curves)
+{
+    GameConfig cfg = reader.config();
+    if (!reader.complete || configHash(cfg) != reader.hash)
+    {
+        return false;
+    }
+    sim = Simulation(cfg);
+    if (cfg.curveLevels && !cfg.endless)
+    {
+        CurvedLevel scratch;
+        if (curves)
+        {
+            curves->prepare(cfg);
+            curves->resetRun(sim, scratch);
+        }
+        else
+        {
+            ThreadPool pool;
+            CurveGenerator own(pool);
+            own.prepare(cfg);
+            own.resetRun(sim, scratch);
+        }
+    }
+    else
+    {
+        sim.reset();
+    }
+
+    float dt = cfg.fixedTimestep;
+    while (!sim.isFinished() && sim.frame < reader.result.frames)
+    {
+        sim.step(reader.next(), dt);
+    }
+
+    return sim.frame == reader.result.frames &&
+           sim.score == reader.result.score &&
+           sim.gameOver == reader.result.gameOver &&
+           sim.levelComplete == reader.result.levelComplete &&
+           sim.isFinished() == reader.result.finished;
+}
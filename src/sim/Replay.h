@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "../config/Config.h"
+#include "Input.h"
+
+/**
+ * Replay file format (all integers little-endian)
+ *
+ * Header (40 bytes; version 4 files end it after the hash, at 32 bytes):
+ *   char[4]  magic "JBRP"
+ *   uint16   version (kReplayVersion)
+ *   uint16   flags: bit 0 endless mode, bit 1 continuous collision,
+ *            bit 2 curve levels
+ *   uint32   physics number type: 0 float, 1 Q16.16 fixed point (kPhysicsFixed)
+ *   uint32   reserved (0)
+ *   uint64   level seed (GameConfig::seed)
+ *   uint64   configHash of the (scaled) GameConfig
+ *   float32  curveFrom, curveTo as bit patterns (0 without curve levels)
+ *
+ * Events (varint = unsigned LEB128):
+ *   varint   (frameDelta << 2) | state
+ *            frameDelta = frames since the previous event (from frame -1, so >= 1)
+ *            state bit 0 = jumpPressed, bit 1 = jumpHeld
+ *   One event per step where the input state differs from the step before
+ *   (press, hold after the press step, release); steps in between repeat it.
+ *
+ * Footer:
+ *   varint   0 (end marker - no event has frameDelta 0)
+ *   varint   steps simulated
+ *   varint   final score
+ *   uint8    flags: bit 0 gameOver, bit 1 levelComplete, bit 2 run finished
+ */
+static const uint16_t kReplayVersion = 5;  // 3: unscaled physics, header records the number type; 4: camera-space scrolling; 5: collision mode and curve ramp in the header (4 still reads)
+
+static const long long kMaxReplayFrames = 120LL * 60 * 60 * 24;  // Longest run a footer may claim (a day at the default step)
+
+class Simulation;
+class CurveGenerator;
+
+/**
+ * configHash: FNV-1a over every GameConfig field that affects gameplay
+ * (display-only fields like targetFps/vsync and the seed itself are excluded)
+ * plus the build's physics number type
+ */
+uint64_t configHash(const GameConfig &cfg);
+
+/**
+ * ReplayResult: Outcome stored in the footer / reproduced by playback
+ */
+struct ReplayResult
+{
+    long long frames = 0;        // Steps simulated
+    int score = 0;
+    bool gameOver = false;
+    bool levelComplete = false;
+    bool finished = false;       // Run ended (false = recording was cut short)
+};
+
+/**
+ * ReplayWriter: Streams one run's input to disk while it is played
+ *
+ * - Bytes go into a fixed in-object buffer, written out with fwrite when
+ *   full, so recording never allocates per step
+ * - record() must see every step's input in order (steps that repeat the
+ *   previous state cost nothing on disk)
+ */
+class ReplayWriter
+{
+public:
+    ~ReplayWriter();
+
+    /**
+     * begin: Create the file and write the header
+     * Returns false (and records nothing) if the file can't be created
+     */
+    bool begin(const char *path, const GameConfig &cfg);
+
+    /**
+     * record: Input used by step `frame` (call before Simulation::step)
+     */
+    void record(long long frame, const FrameInput &input);
+
+    /**
+     * finish: Write the footer and close the file
+     * Returns false if any write failed
+     */
+    bool finish(const ReplayResult &result);
+
+    /**
+     * recording: Is a file open?
+     */
+    bool recording() const { return file != nullptr; }
+
+private:
+    void put(uint8_t byte);
+    void putVarint(uint64_t value);
+    void flush();
+
+    std::FILE *file = nullptr;
+    bool failed = false;            // A write failed since begin()
+    long long lastFrame = -1;       // Frame of the previous event
+    int lastState = 0;              // Input state of the previous step (starts released)
+    int used = 0;                   // Bytes pending in buffer
+    uint8_t buffer[4096];           // Pending bytes (flushed when full)
+};
+
+/**
+ * ReplayReader: Loads a replay and feeds its input back step by step
+ *
+ * The whole file is read once by open(); next() then only decodes, so
+ * playback runs as fast as the simulation itself.
+ */
+class ReplayReader
+{
+public:
+    /**
+     * open: Read and validate a replay file
+     * Returns false if it is missing, not a replay, or a different version
+     * A footer claiming more than kMaxReplayFrames steps is not trusted:
+     * the replay is read as incomplete
+     */
+    bool open(const char *path);
+
+    /**
+     * config: Default GameConfig rebuilt for this replay (seed, mode,
+     * collision mode and curve ramp)
+     * Check configHash(config()) against header hash before trusting results
+     */
+    GameConfig config() const;
+
+    /**
+     * next: Input for the next step (frames past the last event repeat its state)
+     */
+    FrameInput next();
+
+    /**
+     * rewind: Play from step 0 again (no file access, no allocation)
+     */
+    void rewind();
+
+    // ===== Header / Footer =====
+    bool fixedPhysics = false;     // Recorded by a Q16.16 physics build (must match to verify)
+    uint64_t seed = 0;             // Level seed
+    bool endless = false;          // Recorded in endless mode
+    bool continuousCollision = false;  // Recorded with swept collision
+    bool curveLevels = false;      // Recorded on a curve level (GameConfig::curveLevels)
+    float curveFrom = 0.0f;        // Its ramp (GameConfig::curveFrom / curveTo)
+    float curveTo = 0.0f;
+    uint64_t hash = 0;             // Recorded configHash
+    bool complete = false;         // Footer present (recorder called finish)
+    ReplayResult result;           // Recorded outcome (valid when complete)
+
+private:
+    bool readVarint(uint64_t &value);
+    void decodeEvent();
+
+    std::vector<uint8_t> data;     // Whole file
+    size_t headerSize = 0;         // Where the events start (depends on the version)
+    size_t pos = 0;                // Read position of the next event
+    long long frame = 0;           // Step the next next() call returns
+    long long nextEventFrame = -1; // Frame of the pending event (-2 = none left)
+    int nextEventState = 0;        // State of the pending event
+    int state = 0;                 // Current input state bits
+};
+
+/**
+ * playReplay: Rebuild the replay's Simulation and play it to the end
+ * - Returns false without simulating for a truncated replay (no footer)
+ *   or one recorded with another config - nothing bounds such a run
+ * - sim is replaced by a fresh Simulation with reader.config(); a curve
+ *   level is rebuilt the way the game builds it (CurveGenerator::resetRun)
+ *   through curves, prepared here for its tuning, or through a generator
+ *   of its own when none is given (one table sweep, ~0.2 s)
+ * - Steps until the run ends or the recorded step count is reached
+ *   (at most kMaxReplayFrames, see ReplayReader::open)
+ * Returns true if the step count, score and outcome all match the
+ * recorded footer
+ */
+bool playReplay(ReplayReader &reader, Simulation &sim, CurveGenerator *curves = nullptr);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Rng: Small deterministic pseudo-random generator (xorshift64*)
+ *
+ * Plain 64-bit state, no globals and no library calls, so:
+ * - identical seeds give bit-identical sequences on every platform
+ * - each Level (or worker thread) owns its own independent stream
+ * - state can be copied/stored like any other value
+ */
+struct Rng
+{
+    uint64_t state = 0x9E3779B97F4A7C15ULL;  // Never zero (xorshift would get stuck)
+
+    /**
+     * seed: Restart the sequence from a seed
+     * Seed is scrambled (splitmix64) so nearby seeds give unrelated streams
+     */
+    void seed(uint64_t s)
+    {
+        uint64_t z = s + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z = z ^ (z >> 31);
+        state = (z != 0) ? z : 0x9E3779B97F4A7C15ULL;
+    }
+
+    /**
+     * next64: Next raw 64-bit value
+     */
+    uint64_t next64()
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+
+    /**
+     * next: Next raw 32-bit value (high bits have the best quality)
+     */
+    uint32_t next()
+    {
+        return (uint32_t)(next64() >> 32);
+    }
+
+    /**
+     * range: Random integer in [min, max] (inclusive, like GetRandomValue)
+     * Uses multiply-shift instead of modulo (no division, no bias toward low values)
+     */
+    int range(int min, int max)
+    {
+        if (max < min)
+        {
+            int t = min; min = max; max = t;
+        }
+        uint64_t span = (uint64_t)((int64_t)max - (int64_t)min + 1);
+        return (int)((int64_t)min + (int64_t)(((uint64_t)next() * span) >> 32));
+    }
+};
@@ -0,0 +1,200 @@
+#include "RunEvaluator.h"
+#include "Replay.h"
+#include "../parallel/ThreadPool.h"
+#include <algorithm>
+#include <memory>
+
+// ===== RunHistogram =====
+
+/**
+ * reset: Zero everything (one score bucket per possible score)
+ */
+void RunHistogram::reset(int totalPlatforms)
+{
+    scores.assign((size_t)totalPlatforms + 1, 0);
+    deathFrames.assign(kDeathBuckets, 0);
+    runs = wins = groundDeaths = platformDeaths = unfinished = steps = 0;
+    verified = failed = 0;
+}
+
+/**
+ * add: Classify one run by its final Simulation state
+ */
+void RunHistogram::add(const Simulation &sim)
+{
+    runs++;
+    steps += sim.frame;
+    int s = std::max(0, std::min(sim.score, (int)scores.size() - 1));
+    scores[s]++;
+
+    if (sim.levelComplete && !sim.gameOver)
+    {
+        wins++;
+    }
+    else if (sim.gameOver)
+    {
+        groundDeaths += (sim.deathCause == DeathCause::Ground) ? 1 : 0;
+        platformDeaths += (sim.deathCause == DeathCause::Platform) ? 1 : 0;
+        long long bucket = std::min<long long>(sim.frame / kFramesPerBucket, kDeathBuckets - 1);
+        deathFrames[(size_t)bucket]++;
+    }
+    else
+    {
+        unfinished++;
+    }
+}
+
+/**
+ * merge: Element-wise sum (score histograms may differ in size)
+ */
+void RunHistogram::merge(const RunHistogram &other)
+{
+    if (other.scores.size() > scores.size())
+    {
+        scores.resize(other.scores.size(), 0);
+    }
+    for (size_t s = 0; s < other.scores.size(); s++)
+    {
+        scores[s] += other.scores[s];
+    }
+    for (size_t b = 0; b < deathFrames.size() && b < other.deathFrames.size(); b++)
+    {
+        deathFrames[b] += other.deathFrames[b];
+    }
+    runs += other.runs;
+    wins += other.wins;
+    groundDeaths += other.groundDeaths;
+    platformDeaths += other.platformDeaths;
+    unfinished += other.unfinished;
+    steps += other.steps;
+    verified += other.verified;
+    failed += other.failed;
+}
+
+/**
+ * scorePercentile: Walk the cumulative score histogram
+ */
+int RunHistogram::scorePercentile(double p) const
+{
+    long long target = (long long)(p * runs + 0.5);
+    long long seen = 0;
+    for (size_t s = 0; s < scores.size(); s++)
+    {
+        seen += scores[s];
+        if (seen >= target && seen > 0)
+        {
+            return (int)s;
+        }
+    }
+    return scores.empty() ? 0 : (int)scores.size() - 1;
+}
+
+/**
+ * deathFramePercentile: Walk the cumulative death-frame histogram
+ */
+long long RunHistogram::deathFramePercentile(double p) const
+{
+    long long deaths = 0;
+    for (long long count : deathFrames) deaths += count;
+    long long target = (long long)(p * deaths + 0.5);
+    long long seen = 0;
+    for (size_t b = 0; b < deathFrames.size(); b++)
+    {
+        seen += deathFrames[b];
+        if (seen >= target && seen > 0)
+        {
+            return (long long)b * kFramesPerBucket;
+        }
+    }
+    return 0;
+}
+
+// ===== RunEvaluator =====
+
+RunEvaluator::RunEvaluator(ThreadPool &pool) : pool(pool) {}
+
+/**
+ * evaluateSeeds: One job = kSeedsPerJob consecutive seeds
+ * - Each worker owns a Simulation (created up front, reused for every run,
+ *   so runs don't allocate) and a RunHistogram
+ * - No shared writes while running; histograms are merged afterwards
+ */
+RunHistogram RunEvaluator::evaluateSeeds(const GameConfig &cfg, uint64_t firstSeed, long long runs,
+                                         const ScriptedPolicy &policy, long long maxSteps)
+{
+    int threads = pool.threadCount();
+    std::vector<std::unique_ptr<Simulation>> sims;
+    std::vector<RunHistogram> histograms((size_t)threads);
+    for (int w = 0; w < threads; w++)
+    {
+        sims.emplace_back(new Simulation(cfg));
+        histograms[w].reset(cfg.totalPlatforms);
+    }
+    const float dt = cfg.fixedTimestep;
+
+    pool.parallelFor(runs, kSeedsPerJob, [&](int64_t begin, int64_t end, int worker)
+    {
+        Simulation &sim = *sims[worker];
+        RunHistogram &histogram = histograms[worker];
+        for (int64_t r = begin; r < end; r++)
+        {
+            sim.config.seed = firstSeed + (uint64_t)r;
+            sim.reset();
+            while (!sim.isFinished() && sim.frame < maxSteps)
+            {
+                sim.step(policy.input(sim.frame), dt);
+            }
+            histogram.add(sim);
+        }
+    });
+
+    RunHistogram total;
+    total.reset(cfg.totalPlatforms);
+    for (const RunHistogram &h : histograms)
+    {
+        total.merge(h);
+    }
+    return total;
+}
+
+/**
+ * evaluateReplays: One job = one replay file
+ * Unreadable files count as failed and add no outcome
+ */
+RunHistogram RunEvaluator::evaluateReplays(const std::vector<std::string> &paths)
+{
+    int threads = pool.threadCount();
+    int totalPlatforms = GameConfig().totalPlatforms;
+    std::vector<RunHistogram> histograms((size_t)threads);
+    for (int w = 0; w < threads; w++)
+    {
+        histograms[w].reset(totalPlatforms);
+    }
+
+    pool.parallelFor((int64_t)paths.size(), 1, [&](int64_t begin, int64_t end, int worker)
+    {
+        RunHistogram &histogram = histograms[worker];
+        for (int64_t i = begin; i < end; i++)
+        {
+            ReplayReader reader;
+            if (!reader.open(paths[(size_t)i].c_str()))
+            {
+                histogram.failed++;
+                continue;
+            }
+            Simulation sim;
+            bool ok = playReplay(reader, sim);
+            histogram.verified += ok ? 1 : 0;
+            histogram.failed += ok ? 0 : 1;
+            histogram.add(sim);
+        }
+    });
+
+    RunHistogram total;
+    total.reset(totalPlatforms);
+    for (const RunHistogram &h : histograms)
+    {
+        total.merge(h);
+    }
+    return total;
+}
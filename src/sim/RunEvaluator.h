@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../config/Config.h"
+#include "Input.h"
+#include "Simulation.h"
+
+class ThreadPool;
+
+/**
+ * ScriptedPolicy: Deterministic input pattern for unattended runs
+ * Waits jumpDelay steps, then presses jump every jumpPeriod steps and keeps
+ * it held for jumpHold steps
+ * - The ball starts on the ground and the first platform is about 5 s
+ *   away at the default scroll speed; leaving the ground any earlier means
+ *   landing back on it, so with no delay every run is a score-0 ground
+ *   death. The default delay reaches the first platform on nearly every
+ *   seed, and the runs then spread out over the next few
+ */
+struct ScriptedPolicy
+{
+    int jumpPeriod = 40;
+    int jumpHold = 8;
+    int jumpDelay = 540;   // Steps before the first press (4.5 s at the default step)
+
+    FrameInput input(long long frame) const
+    {
+        FrameInput in;
+        long long since = frame - jumpDelay;
+        long long phase = since % jumpPeriod;
+        in.jumpPressed = (since >= 0 && phase == 0);
+        in.jumpHeld = (since >= 0 && phase < jumpHold);
+        return in;
+    }
+};
+
+/**
+ * RunHistogram: Aggregated outcomes of many runs
+ *
+ * - scores[s]: runs that ended with score s (0..totalPlatforms)
+ * - deathFrames[b]: lost runs that died in frames [b * kFramesPerBucket, ...)
+ *   (last bucket also holds everything later)
+ * - Cause counters split lost runs into ground vs platform deaths
+ *
+ * The evaluator keeps one per worker thread (padded so neighbours never
+ * share a cache line) and merges them when all runs are done.
+ */
+struct RunHistogram
+{
+    static const int kFramesPerBucket = 120;   // One second at the default step
+    static const int kDeathBuckets = 600;      // Ten minutes
+
+    std::vector<long long> scores;
+    std::vector<long long> deathFrames;
+    long long runs = 0;
+    long long wins = 0;
+    long long groundDeaths = 0;      // Touched the ground (landedOnGround)
+    long long platformDeaths = 0;    // Hit a platform side (checkCollision)
+    long long unfinished = 0;        // Stopped by the step limit
+    long long steps = 0;             // Steps simulated in total
+    long long verified = 0;          // Replays that reproduced their recorded result
+    long long failed = 0;            // Replays that didn't (or couldn't be read)
+    char padding[64] = {};           // Per-worker copies sit side by side in a vector
+
+    /**
+     * reset: Clear counters and size the score histogram
+     */
+    void reset(int totalPlatforms);
+
+    /**
+     * add: Count one finished (or stopped) run
+     */
+    void add(const Simulation &sim);
+
+    /**
+     * merge: Add another histogram's counts into this one
+     */
+    void merge(const RunHistogram &other);
+
+    /**
+     * scorePercentile: Smallest score s with at least fraction p of runs <= s
+     */
+    int scorePercentile(double p) const;
+
+    /**
+     * deathFramePercentile: Start frame of the bucket holding fraction p of deaths
+     */
+    long long deathFramePercentile(double p) const;
+};
+
+/**
+ * RunEvaluator: Simulates many full runs in parallel on a ThreadPool
+ *
+ * Every run is an independent Simulation (Player + Level + step), so runs
+ * shard freely across cores; each worker reuses one Simulation for all
+ * of its runs and counts outcomes into its own RunHistogram.
+ */
+class RunEvaluator
+{
+public:
+    explicit RunEvaluator(ThreadPool &pool);
+
+    /**
+     * evaluateSeeds: Play `runs` levels with seeds firstSeed, firstSeed+1, ...
+     * using the scripted policy; runs longer than maxSteps are stopped
+     */
+    RunHistogram evaluateSeeds(const GameConfig &cfg, uint64_t firstSeed, long long runs,
+                               const ScriptedPolicy &policy, long long maxSteps = 1LL << 24);
+
+    /**
+     * evaluateReplays: Re-simulate replay files and check their recorded results
+     * (verified / failed counters plus the usual outcome histograms)
+     */
+    RunHistogram evaluateReplays(const std::vector<std::string> &paths);
+
+    static const int kSeedsPerJob = 64;   // Runs per work-stealing job (a few ms of work)
+
+private:
+    ThreadPool &pool;
+};
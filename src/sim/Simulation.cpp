@@ -0,0 +1,269 @@
+#include "Simulation.h"
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <utility>
+
+static_assert(std::is_trivially_copyable<SimSnapshot>::value, "snapshots are copied with memcpy");
+
+/**
+ * Simulation constructor: Copy config
+ * Player and Level use default constructors (initialized by reset() later)
+ */
+Simulation::Simulation(const GameConfig &cfg) : config(cfg) {}
+
+/**
+ * reset: Initialize/restart run to starting state
+ */
+void Simulation::reset()
+{
+    player.reset(config);     // Move ball to starting position, reset jumps
+    level.generate(config);   // Create new random platform layout
+    resetRunState();
+}
+
+/**
+ * reset: Restart on a fixed stage - win by passing all of its platforms
+ */
+void Simulation::reset(const LevelStage &stage)
+{
+    useStage(stage);
+    player.reset(config);        // Move ball to starting position, reset jumps
+    level.load(stage, config);   // Stream the stage's platforms
+    resetRunState();
+}
+
+/**
+ * reset: Either reset above, with the level swapped in instead of built
+ */
+void Simulation::reset(Level &built, const LevelStage &stage)
+{
+    if (stage.gap)
+    {
+        useStage(stage);
+    }
+    player.reset(config);
+    std::swap(level, built);
+    resetRunState();
+}
+
+/**
+ * useStage: A stage is won by passing all of its platforms
+ */
+void Simulation::useStage(const LevelStage &stage)
+{
+    config.endless = false;
+    config.totalPlatforms = stage.count;
+}
+
+/**
+ * resetRunState: Shared tail of both resets
+ */
+void Simulation::resetRunState()
+{
+    score = 0;                // Clear score
+    gameOver = false;         // Clear death flag
+    deathCause = DeathCause::None;
+    levelComplete = false;    // Clear win flag
+    cameraOffsetY = 0.0f;     // Reset camera to starting position
+    frame = 0;                // Restart step counter
+}
+
+/**
+ * step: Advance all game logic by one step
+ *
+ * Input:
+ * 1. Start a jump if jump was pressed this step (double jump system)
+ *
+ * Physics & Movement:
+ * 2. Store previous Y position (needed for landing detection)
+ * 3. Update player physics (gravity, jump hold, position, rotation)
+ * 4. Scroll level (camera moves right over the fixed platforms)
+ *
+ * Collision & Landing:
+ * 5. Resolve landing on platforms or ground
+ *    - Sets player Y to surface level if landing
+ *    - Returns whether grounded and whether it was ground (not platform)
+ * 6. Update player grounded state (refills jumps if landed)
+ *
+ * Camera System:
+ * 7. Calculate camera offset to follow ball upward
+ *    - Keeps ball at 40% screen height when climbing
+ *    - Offset is negative (shifts world down as ball climbs)
+ *    - Clamped to 0 minimum (doesn't scroll down past start)
+ *
+ * Game Over Conditions:
+ * 8. Check if touched ground after first jump (death rule)
+ * 9. Check if hit platform sides (death from collision)
+ *
+ * Scoring & Win:
+ * 10. Award points for platforms passed
+ * 11. Check if all platforms passed (win condition, finite levels only)
+ *
+ * Continuous Mode (config.continuousCollision):
+ * - Steps 5 and 9 test the path the ball moved along (swept, with the
+ *   time of impact) as well as where it ends, and the player integrates
+ *   exactly - a 30 Hz step ends like four 120 Hz ones (headless coarse)
+ * - Rolling off a platform's edge mid-step falls from the edge, not from
+ *   the next step
+ * - Off by default: the discrete tests are what BatchSim, SearchBot and
+ *   recorded replays reproduce bit for bit
+ */
+void Simulation::step(const FrameInput &input, float dt)
+{
+    // Pause updates if run ended
+    if (isFinished())
+    {
+        return;
+    }
+
+    // Jump input (only if jumps available)
+    if (input.jumpPressed && player.canJump())
+    {
+        player.startJump();
+    }
+
+    // Store previous Y for landing detection (and the start velocity of the path)
+    PhysicsScalar prevY = player.y;
+    PhysicsScalar prevVy = player.vy;
+
+    // Update physics and movement
+    player.update(dt, input.jumpHeld, config);  // Apply gravity, jump, update position and rotation
+    level.scroll(dt, config);                   // Move the camera right
+
+    // Handle landing on platforms or ground
+    // Platform geometry is float; the snapped Y/velocity (whole pixels, 0)
+    // convert back to PhysicsScalar exactly
+    bool landedOnGround = false;  // Will be set true if landed on ground (not platform)
+    float ballY = toFloat(player.y);
+    float ballVy = toFloat(player.vy);
+    float fromY = toFloat(prevY);
+    float toY = ballY;                          // End of the step's path (before any snap)
+    float sweepX = config.scrollSpeed * dt;     // World X the ball moved this step
+    float landTime = 1.0f;                      // When the ball landed (continuous mode)
+    float leaveTime = 1.0f;                     // When it rolled off that platform (continuous mode)
+    bool groundedNow = config.continuousCollision
+        ? level.resolveLandingSwept(player.x, sweepX, fromY, toFloat(prevVy) * dt, ballY, ballVy,
+                                    config.radius, config, landedOnGround, landTime, leaveTime)
+        : level.resolveLanding(player.x, fromY, ballY, ballVy,
+                               config.radius, config, landedOnGround);
+    if (groundedNow)
+    {
+        player.y = toScalar(ballY);
+        player.vy = toScalar(ballVy);
+        ballY = toFloat(player.y);
+    }
+    player.setGrounded(groundedNow);  // Update player state, refill jumps if landed
+    float surfaceY = ballY;           // Y the ball rolled along after landing
+
+    // Continuous mode: rolled off the platform's edge mid-step - falls from
+    // there for the rest of the step instead of hovering until the next one
+    bool rolledOff = groundedNow && leaveTime < 1.0f;
+    if (rolledOff)
+    {
+        float fall = (1.0f - leaveTime) * dt;
+        player.y = toScalar(ballY + 0.5f * config.gravity * fall * fall);
+        player.vy = toScalar(config.gravity * fall);
+        player.grounded = false;  // Jumps stay refilled, like a step that lands then falls
+        ballY = toFloat(player.y);
+    }
+
+    // Camera follows ball upward
+    // desiredScreenY = where we want ball on screen (40% from top)
+    // cameraOffsetY = how much to shift world down (negative value)
+    float desiredScreenY = config.screenHeight * 0.4f;
+    cameraOffsetY = std::min(0.0f, ballY - desiredScreenY);
+
+    // Death condition: touched ground after leaving it at least once
+    if (landedOnGround && player.hasJumpedOnce())
+    {
+        gameOver = true;
+        deathCause = DeathCause::Ground;
+    }
+
+    // Award score for passing platforms
+    score += level.awardScore(player.x, config.radius);
+
+    // Win condition: passed all platforms (endless runs only end by dying)
+    if (!config.endless && score >= config.totalPlatforms)
+    {
+        levelComplete = true;
+    }
+
+    // Death condition: hit platform side/bottom
+    // Continuous mode also tests the path up to the end position: the chord
+    // to the landing point (or the end of the step if the ball didn't
+    // land), then the roll along the surface. The chord is within
+    // curve * t^2 / 4 of the real (parabolic) path, so only contacts deeper
+    // than that count along it - grazes are left to the end position test
+    bool hitPlatform = level.checkCollision(player.x, ballY, config.radius, config);
+    if (config.continuousCollision && !hitPlatform)
+    {
+        float fromX = player.x - sweepX;
+        float landX = groundedNow ? fromX + sweepX * landTime : player.x;
+        float curve = std::fabs(toY - fromY - toFloat(prevVy) * dt);  // y(t)'s t^2 term
+        float tolerance = curve * landTime * landTime * 0.25f + kSweepSlack;
+        hitPlatform = level.checkCollisionSwept(fromX, fromY, landX, surfaceY, config.radius, tolerance, config) ||
+                      (groundedNow && level.checkCollisionSwept(landX, surfaceY, player.x, surfaceY,
+                                                                config.radius, kSweepSlack, config));
+    }
+    if (hitPlatform)
+    {
+        if (!gameOver)
+        {
+            deathCause = DeathCause::Platform;
+        }
+        gameOver = true;
+    }
+
+    frame++;
+}
+
+/**
+ * isFinished: Run ended by death or by passing all platforms
+ */
+bool Simulation::isFinished() const
+{
+    return gameOver || levelComplete;
+}
+
+/**
+ * capture: Level first (it is the only part that can refuse), then the
+ * player and run state by assignment
+ */
+bool Simulation::capture(SimSnapshot &out) const
+{
+    if (!level.capture(out.level))
+    {
+        return false;
+    }
+    out.config = config;
+    out.player = player;
+    out.score = score;
+    out.gameOver = gameOver;
+    out.deathCause = deathCause;
+    out.levelComplete = levelComplete;
+    out.cameraOffsetY = cameraOffsetY;
+    out.frame = frame;
+    return true;
+}
+
+/**
+ * restore: Same order as capture
+ */
+bool Simulation::restore(const SimSnapshot &in)
+{
+    if (!level.restore(in.level))
+    {
+        return false;
+    }
+    config = in.config;
+    player = in.player;
+    score = in.score;
+    gameOver = in.gameOver;
+    deathCause = in.deathCause;
+    levelComplete = in.levelComplete;
+    cameraOffsetY = in.cameraOffsetY;
+    frame = in.frame;
+    return true;
+}
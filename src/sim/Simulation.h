@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstdint>
+#include "../config/Config.h"
+#include "../player/Player.h"
+#include "../level/Level.h"
+#include "Input.h"
+
+/**
+ * DeathCause: What ended a lost run
+ */
+enum class DeathCause : uint8_t
+{
+    None,      // Still running, or the level was completed
+    Ground,    // Touched the ground after the first jump (landedOnGround)
+    Platform   // Hit a platform side/bottom (checkCollision)
+};
+
+/**
+ * SimSnapshot: Everything a run's future depends on, as plain data
+ * - Config, player, run state and the level (see LevelSnapshot)
+ * - Simulation::capture / restore copy it in well under a microsecond,
+ *   so checkpoints, rollback and search can branch from any step instead
+ *   of resimulating from frame 0
+ */
+struct SimSnapshot
+{
+    GameConfig config;           // Simulation::config (a stage run changes endless / totalPlatforms)
+    Player player;
+    int score;
+    bool gameOver;
+    DeathCause deathCause;
+    bool levelComplete;
+    float cameraOffsetY;
+    long long frame;
+    LevelSnapshot level;         // Last: its storage bytes are the bulk of the snapshot
+};
+
+/**
+ * Simulation: Window-free game core (physics, level, scoring, game state)
+ *
+ * Responsibilities:
+ * - Own the Player, Level and run state (score, gameOver, levelComplete, deathCause)
+ * - Advance everything by one step from an explicit input and dt
+ * - Track the camera offset that keeps the ball on screen
+ *
+ * Nothing here opens a window, draws or polls input, so the same step
+ * runs under the interactive Game loop and under the headless runner.
+ */
+class Simulation
+{
+public:
+    static constexpr float kSweepSlack = 1e-3f;  // px of overlap swept tests ignore (rounding at exact touches)
+
+    /**
+     * Constructor: Copy the configuration (the level is generated by reset)
+     * Call reset() before the first step
+     */
+    explicit Simulation(const GameConfig &cfg = GameConfig());
+
+    /**
+     * reset: Start/restart a run
+     * - Resets player, generates a new level
+     * - Clears score, game state flags and camera offset
+     */
+    void reset();
+
+    /**
+     * reset: Start a run on a fixed stage (see Level::load)
+     * - Switches the config to a finite level of stage.count platforms
+     * - Otherwise the same as reset()
+     */
+    void reset(const LevelStage &stage);
+
+    /**
+     * reset: Start a run on a level built elsewhere (LevelPregenerator)
+     * - `built` was generated with config (or loaded with stage, when
+     *   stage.gap is set) and is swapped with this simulation's level:
+     *   O(1), its storage moves with it; `built` gets the old level
+     * - Otherwise the same as reset() / reset(stage)
+     */
+    void reset(Level &built, const LevelStage &stage);
+
+    /**
+     * step: Advance the simulation by dt seconds
+     * - Starts a jump if requested (and jumps remain)
+     * - Applies physics, scrolls level, resolves landing
+     * - Updates camera, score and game over / win conditions
+     * Does nothing once the run has ended
+     */
+    void step(const FrameInput &input, float dt);
+
+    /**
+     * isFinished: Check if run has ended (game over or level complete)
+     */
+    bool isFinished() const;
+
+    /**
+     * capture: Save the current state into out
+     * Returns false if the level's storage can't be snapshotted (see Level::capture)
+     */
+    bool capture(SimSnapshot &out) const;
+
+    /**
+     * restore: Continue from a captured state
+     * - Stepping afterwards gives exactly what stepping from the capture did
+     * - Returns false (state unchanged) if the snapshot came from another
+     *   level's storage (see Level::restore)
+     */
+    bool restore(const SimSnapshot &in);
+
+    // ===== Run State =====
+    GameConfig config;           // Configuration values (may be rescaled by Game)
+    Player player;               // The ball character
+    Level level;                 // Platform world and background
+    int score = 0;               // Platforms passed (0 to totalPlatforms, unbounded when endless)
+    bool gameOver = false;       // Death state (hit ground or platform side)
+    DeathCause deathCause = DeathCause::None;  // Why gameOver was set (first cause wins)
+    bool levelComplete = false;  // Win state (passed all platforms - never set when endless)
+    float cameraOffsetY = 0.0f;  // Vertical camera offset (follows player upward)
+    long long frame = 0;         // Steps simulated since last reset
+
+private:
+    /**
+     * useStage: Switch the config to a finite level of stage.count platforms
+     */
+    void useStage(const LevelStage &stage);
+
+    /**
+     * resetRunState: Clear score, flags, camera and step counter
+     */
+    void resetRunState();
+};
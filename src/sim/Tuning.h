@@ -0,0 +1,147 @@
+#pragma once
+
+#include <utility>
+#include "../config/Config.h"
+#include "../level/Level.h"
+
+/**
+ * Tunings: The gameplay settings a kernel reads, as a policy type
+ *
+ * Hot kernels (BatchSim::stepBlock, PlatformGenerator::next) are
+ * templates over a Tuning - any type with GameConfig's gameplay field
+ * names plus ringCapacity:
+ * - RuntimeTuning: values copied from a GameConfig at run time (any
+ *   settings: config sweeps, curated stage layouts, tests)
+ * - StaticTuning<Config>: the same fields as static constexpr members of
+ *   a constexpr GameConfig, so every setting - and the ring capacity every
+ *   per-platform loop runs over - is a compile-time constant and those
+ *   loops are fully unrolled
+ *
+ * GameConfig itself works wherever ringCapacity isn't needed.
+ * Kernels take tunings by value: a RuntimeTuning is then the kernel's own
+ * copy, so its fields are never reloaded after stores to the state arrays.
+ *
+ * Only gameplay fields live here (the configHash set minus the physics
+ * number type); seeds, display and cloud settings stay on GameConfig.
+ */
+
+/**
+ * kProductionConfig: The shipped tuning (GameConfig defaults)
+ * BatchSim runs StaticTuning<kProductionConfig> kernels whenever its
+ * config matches this one
+ */
+inline constexpr GameConfig kProductionConfig{};
+
+/**
+ * RuntimeTuning: Gameplay fields of a GameConfig, read at run time
+ */
+struct RuntimeTuning
+{
+    explicit RuntimeTuning(const GameConfig &cfg)
+        : screenWidth(cfg.screenWidth), radius(cfg.radius), groundY(cfg.groundY),
+          gravity(cfg.gravity), jumpVelocity(cfg.jumpVelocity), maxJumpHold(cfg.maxJumpHold),
+          jumpHoldAccel(cfg.jumpHoldAccel), scrollSpeed(cfg.scrollSpeed),
+          totalPlatforms(cfg.totalPlatforms), endless(cfg.endless), generateAhead(cfg.generateAhead),
+          minGap(cfg.minGap), maxGap(cfg.maxGap),
+          minPlatformWidth(cfg.minPlatformWidth), maxPlatformWidth(cfg.maxPlatformWidth),
+          platformHeight(cfg.platformHeight), minPlatformY(cfg.minPlatformY),
+          stepUpMin(cfg.stepUpMin), stepUpMax(cfg.stepUpMax),
+          ringCapacity(Level::ringCapacity(cfg))
+    {
+    }
+
+    int screenWidth;
+    float radius;
+    float groundY;
+    float gravity;
+    float jumpVelocity;
+    float maxJumpHold;
+    float jumpHoldAccel;
+    float scrollSpeed;
+    int totalPlatforms;
+    bool endless;
+    float generateAhead;
+    float minGap;
+    float maxGap;
+    float minPlatformWidth;
+    float maxPlatformWidth;
+    float platformHeight;
+    float minPlatformY;
+    float stepUpMin;
+    float stepUpMax;
+    int ringCapacity;     // Level::ringCapacity of the settings
+};
+
+/**
+ * StaticTuning: Gameplay fields of a constexpr GameConfig, as constants
+ */
+template <const GameConfig &Config>
+struct StaticTuning
+{
+    static constexpr int screenWidth = Config.screenWidth;
+    static constexpr float radius = Config.radius;
+    static constexpr float groundY = Config.groundY;
+    static constexpr float gravity = Config.gravity;
+    static constexpr float jumpVelocity = Config.jumpVelocity;
+    static constexpr float maxJumpHold = Config.maxJumpHold;
+    static constexpr float jumpHoldAccel = Config.jumpHoldAccel;
+    static constexpr float scrollSpeed = Config.scrollSpeed;
+    static constexpr int totalPlatforms = Config.totalPlatforms;
+    static constexpr bool endless = Config.endless;
+    static constexpr float generateAhead = Config.generateAhead;
+    static constexpr float minGap = Config.minGap;
+    static constexpr float maxGap = Config.maxGap;
+    static constexpr float minPlatformWidth = Config.minPlatformWidth;
+    static constexpr float maxPlatformWidth = Config.maxPlatformWidth;
+    static constexpr float platformHeight = Config.platformHeight;
+    static constexpr float minPlatformY = Config.minPlatformY;
+    static constexpr float stepUpMin = Config.stepUpMin;
+    static constexpr float stepUpMax = Config.stepUpMax;
+    static constexpr int ringCapacity = Level::ringCapacity(Config);
+
+    /**
+     * matches: True if cfg plays exactly like Config (every field above is
+     * equal), so this tuning's kernels give the same results for it
+     */
+    static bool matches(const GameConfig &cfg)
+    {
+        return cfg.screenWidth == screenWidth && cfg.radius == radius && cfg.groundY == groundY &&
+               cfg.gravity == gravity && cfg.jumpVelocity == jumpVelocity &&
+               cfg.maxJumpHold == maxJumpHold && cfg.jumpHoldAccel == jumpHoldAccel &&
+               cfg.scrollSpeed == scrollSpeed && cfg.totalPlatforms == totalPlatforms &&
+               cfg.endless == endless && cfg.generateAhead == generateAhead &&
+               cfg.minGap == minGap && cfg.maxGap == maxGap &&
+               cfg.minPlatformWidth == minPlatformWidth && cfg.maxPlatformWidth == maxPlatformWidth &&
+               cfg.platformHeight == platformHeight && cfg.minPlatformY == minPlatformY &&
+               cfg.stepUpMin == stepUpMin && cfg.stepUpMax == stepUpMax;
+    }
+};
+
+typedef StaticTuning<kProductionConfig> ProductionTuning;  // The shipped settings, specialized
+
+/**
+ * forEachSlot: body(i) for every ring slot i of a tuning, in order
+ * - Runtime tunings: a plain loop to ringCapacity
+ * - Static tunings: one inline call per slot (a fold over the slot
+ *   indices), so the loop is fully unrolled with constant offsets
+ */
+template <typename Tuning, typename Body>
+inline void forEachSlot(const Tuning &tuning, Body &&body)
+{
+    for (int i = 0; i < tuning.ringCapacity; i++)
+    {
+        body(i);
+    }
+}
+
+template <typename Body, int... Slots>
+inline void forEachSlotUnrolled(Body &body, std::integer_sequence<int, Slots...>)
+{
+    (body(Slots), ...);
+}
+
+template <const GameConfig &Config, typename Body>
+inline void forEachSlot(const StaticTuning<Config> &, Body &&body)
+{
+    forEachSlotUnrolled(body, std::make_integer_sequence<int, StaticTuning<Config>::ringCapacity>());
+}
@@ -0,0 +1,146 @@
+#include "Telemetry.h"
+#include <chrono>
+#include <cstring>
+
+/**
+ * Destructor: Flush and stop if still open
+ */
+Telemetry::~Telemetry()
+{
+    close();
+}
+
+/**
+ * open: Pick the output and start the writer
+ */
+bool Telemetry::open(const char *path)
+{
+    close();
+    bool toStdout = std::strcmp(path, "-") == 0;
+    std::FILE *out = toStdout ? stdout : std::fopen(path, "ab");
+    if (out == nullptr)
+    {
+        return false;
+    }
+    ownsFile = !toStdout;
+    stopping.store(false, std::memory_order_relaxed);
+    file = out;
+    writer = std::thread(&Telemetry::writerLoop, this);
+    return true;
+}
+
+/**
+ * close: Stop the writer (it drains the ring before exiting), then close
+ */
+void Telemetry::close()
+{
+    if (file == nullptr)
+    {
+        return;
+    }
+    stopping.store(true, std::memory_order_release);
+    writer.join();
+    if (ownsFile)
+    {
+        std::fclose(file);
+    }
+    else
+    {
+        std::fflush(file);
+    }
+    file = nullptr;
+}
+
+/**
+ * writerLoop: Drain until empty, then sleep kFlushMs
+ * - Producers never signal the writer (that would cost them a system
+ *   call now and then); the period bounds how stale the output gets
+ * - The last drain after stop picks up everything pushed before close()
+ */
+void Telemetry::writerLoop()
+{
+    while (!stopping.load(std::memory_order_acquire))
+    {
+        while (drain())
+        {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(kFlushMs));
+    }
+    while (drain())
+    {
+    }
+}
+
+/**
+ * drain: Format up to kBatch events into the buffer, write it in one call
+ */
+bool Telemetry::drain()
+{
+    char *cursor = batch;
+    int count = 0;
+    TelemetryEvent event;
+    while (count < kBatch && ring.tryPop(event))
+    {
+        cursor += format(event, cursor);
+        count++;
+    }
+    if (count == 0)
+    {
+        return false;
+    }
+    std::fwrite(batch, 1, (size_t)(cursor - batch), file);
+    std::fflush(file);
+    written.fetch_add(count, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * typeName: Event type as written to the "type" field
+ */
+static const char *typeName(TelemetryEventType type)
+{
+    switch (type)
+    {
+        case TelemetryEventType::RunStart: return "run_start";
+        case TelemetryEventType::Jump: return "jump";
+        case TelemetryEventType::PlatformScored: return "platform_scored";
+        case TelemetryEventType::Death: return "death";
+        case TelemetryEventType::LevelComplete: return "level_complete";
+        case TelemetryEventType::Retry: return "retry";
+        case TelemetryEventType::FrameSpike: return "frame_spike";
+    }
+    return "unknown";
+}
+
+/**
+ * format: NDJSON line with the fields the event's type uses
+ */
+int Telemetry::format(const TelemetryEvent &event, char *out)
+{
+    int n = std::snprintf(out, kLineBytes, "{\"t_ns\":%lld,\"run\":%u,\"frame\":%d,\"type\":\"%s\"",
+                          (long long)event.timeNs, event.run, event.frame, typeName(event.type));
+    switch (event.type)
+    {
+        case TelemetryEventType::RunStart:
+            n += std::snprintf(out + n, kLineBytes - n, ",\"seed\":%llu,\"stage\":%d,\"endless\":%s",
+                               (unsigned long long)event.seed, event.value, event.cause ? "true" : "false");
+            break;
+        case TelemetryEventType::Jump:
+            n += std::snprintf(out + n, kLineBytes - n, ",\"hold_s\":%.4f", event.amount);
+            break;
+        case TelemetryEventType::Death:
+            n += std::snprintf(out + n, kLineBytes - n, ",\"score\":%d,\"cause\":\"%s\"", event.value,
+                               event.cause == 1 ? "ground" : (event.cause == 2 ? "platform" : "none"));
+            break;
+        case TelemetryEventType::PlatformScored:
+        case TelemetryEventType::LevelComplete:
+        case TelemetryEventType::Retry:
+            n += std::snprintf(out + n, kLineBytes - n, ",\"score\":%d", event.value);
+            break;
+        case TelemetryEventType::FrameSpike:
+            n += std::snprintf(out + n, kLineBytes - n, ",\"frame_ms\":%.2f", event.amount);
+            break;
+    }
+    n += std::snprintf(out + n, kLineBytes - n, "}\n");
+    return n;
+}
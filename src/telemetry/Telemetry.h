@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <type_traits>
+#include "../parallel/MpscRing.h"
+
+/**
+ * TelemetryEventType: What happened (one fixed-size event each)
+ */
+enum class TelemetryEventType : uint8_t
+{
+    RunStart,        // A run began: seed, value = pack stage (-1 = random level), cause = endless
+    Jump,            // A jump: frame it was pressed on, amount = seconds the jump was held
+    PlatformScored,  // Level::awardScore passed a platform: value = score after it
+    Death,           // Run lost: cause = DeathCause, value = final score
+    LevelComplete,   // Run won: value = final score
+    Retry,           // Run put back to its checkpoint: frame = checkpoint step, value = its score
+    FrameSpike       // A rendered frame took longer than the spike threshold: amount = ms
+};
+
+/**
+ * TelemetryEvent: One instrumentation event (POD, 40 bytes)
+ * Fields a type doesn't use are zero
+ */
+struct TelemetryEvent
+{
+    int64_t timeNs = 0;        // Session clock (Profiler::nowNs) of the frame it happened in
+    uint64_t seed = 0;         // Level seed (RunStart)
+    uint32_t run = 0;          // Run number of the session (0 = first)
+    int32_t frame = 0;         // Simulation step of the run
+    int32_t value = 0;         // Type-specific (see TelemetryEventType)
+    float amount = 0.0f;       // Type-specific seconds / milliseconds
+    TelemetryEventType type = TelemetryEventType::RunStart;
+    uint8_t cause = 0;         // Type-specific small value
+    uint16_t reserved = 0;
+};
+
+static_assert(std::is_trivially_copyable<TelemetryEvent>::value, "events are copied through the ring");
+static_assert(sizeof(TelemetryEvent) == 40, "keep events fixed-size");
+
+/**
+ * Telemetry: Off-thread export of gameplay events
+ *
+ * - push() copies an event into a lock-free MPSC ring (one
+ *   compare-exchange, no lock, no allocation, no system call) and never
+ *   blocks: if the writer has fallen a whole ring behind, the event is
+ *   dropped and counted
+ * - A writer thread wakes every kFlushMs, drains the ring in batches and
+ *   appends them to the output as newline-delimited JSON (one object per
+ *   event), flushing after each batch
+ * - Closed (the default) push() is a single branch, so instrumented code
+ *   costs nothing when no output was opened
+ *
+ * Any thread may push; open() and close() belong to the owning thread
+ * (open before, and close after, any other thread pushes).
+ */
+class Telemetry
+{
+public:
+    static constexpr int kCapacity = 8192;  // Events in flight (about 0.4 MB with sequence numbers)
+    static constexpr int kFlushMs = 50;     // Writer wake-up period
+    static constexpr int kLineBytes = 192;  // Longest NDJSON line of one event
+
+    Telemetry() = default;
+    ~Telemetry();
+
+    Telemetry(const Telemetry &) = delete;
+    Telemetry &operator=(const Telemetry &) = delete;
+
+    /**
+     * open: Start writing to path ("-" = stdout), appending
+     * Returns false if it can't be opened (telemetry stays off)
+     */
+    bool open(const char *path);
+
+    /**
+     * close: Write everything still queued, stop the writer and close
+     */
+    void close();
+
+    /**
+     * enabled: An output is open (events are being exported)
+     */
+    bool enabled() const { return file != nullptr; }
+
+    /**
+     * push: Queue an event (any thread, never blocks)
+     */
+    void push(const TelemetryEvent &event)
+    {
+        if (file != nullptr && !ring.tryPush(event))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * format: One event as a JSON line (with '\n'); returns its length
+     * out must hold kLineBytes
+     */
+    static int format(const TelemetryEvent &event, char *out);
+
+    // ===== Statistics =====
+    std::atomic<long long> written{0};  // Events written by the writer
+    std::atomic<long long> dropped{0};  // Events refused because the ring was full
+
+private:
+    /**
+     * writerLoop: Thread body - drain, write, sleep until stopped
+     */
+    void writerLoop();
+
+    /**
+     * drain: Write up to kBatch queued events; returns false if there were none
+     */
+    bool drain();
+
+    static constexpr int kBatch = 64;           // Events formatted per fwrite
+
+    MpscRing<TelemetryEvent, kCapacity> ring;   // Producers -> writer
+    std::FILE *file = nullptr;                  // Output (nullptr = closed)
+    bool ownsFile = false;                      // fclose on close (not stdout)
+    std::atomic<bool> stopping{false};
+    std::thread writer;
+    char batch[kBatch * kLineBytes];            // Writer's formatting buffer
+};